@@ -131,3 +131,11 @@ MH_ENUM_REFLECT_BEGIN(tf2_bot_detector::KickReason)
 	MH_ENUM_REFLECT_VALUE(Other)
 	MH_ENUM_REFLECT_VALUE(Scamming)
 MH_ENUM_REFLECT_END()
+
+MH_ENUM_REFLECT_BEGIN(tf2_bot_detector::ActionType)
+	MH_ENUM_REFLECT_VALUE(GenericCommand)
+	MH_ENUM_REFLECT_VALUE(Kick)
+	MH_ENUM_REFLECT_VALUE(ChatMessage)
+	MH_ENUM_REFLECT_VALUE(LobbyUpdate)
+	MH_ENUM_REFLECT_VALUE(StatusUpdate)
+MH_ENUM_REFLECT_END()
@@ -102,7 +102,7 @@ std::unique_ptr<IRCONActionManager> IRCONActionManager::Create(const Settings& s
 RCONActionManager::RCONActionManager(const Settings& settings, IWorldState& world) :
 	m_Settings(settings), m_WorldState(world)
 {
-	world.AddWorldEventListener(this);
+	world.AddWorldEventListener(this, WorldEvent::LocalPlayerInitialized);
 
 	m_IsDiscardingServerCommands = settings.m_ConfigCompatibilityMode;
 }
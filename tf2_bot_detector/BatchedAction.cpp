@@ -0,0 +1,64 @@
+#include "BatchedAction.h"
+#include "Networking/HTTPHelpers.h"
+
+#include <mh/algorithm/multi_compare.hpp>
+
+#include <algorithm>
+
+using namespace tf2_bot_detector;
+
+bool tf2_bot_detector::IsThrottlingError(const std::exception& e)
+{
+	if (auto httpError = dynamic_cast<const http_error*>(&e))
+	{
+		return mh::any_eq(httpError->code(),
+			HTTPResponseCode::TooManyRequests,
+			HTTPResponseCode::ServiceUnavailable);
+	}
+
+	return false;
+}
+
+BatchedActionPacer::BatchedActionPacer(size_t maxInFlight) :
+	m_MaxInFlight(maxInFlight)
+{
+}
+
+bool BatchedActionPacer::CanSend(time_point_t now, size_t inFlight) const
+{
+	return inFlight < m_MaxInFlight && now >= m_NextSend;
+}
+
+void BatchedActionPacer::OnSent(time_point_t now)
+{
+	m_NextSend = now + m_Interval;
+}
+
+void BatchedActionPacer::OnSucceeded(duration_t latency)
+{
+	// With m_MaxInFlight batches outstanding, sending any faster than this just queues them up
+	// in HTTPClient instead
+	const duration_t latencyFloor = latency / m_MaxInFlight;
+
+	m_Interval = std::clamp(std::max(m_Interval * 3 / 4, latencyFloor), MIN_INTERVAL, MAX_INTERVAL);
+}
+
+void BatchedActionPacer::OnFailed(time_point_t now, bool throttled)
+{
+	m_Interval = std::min(m_Interval * 2, MAX_INTERVAL);
+
+	// Batches that are already in flight will probably be throttled too, don't pile more on
+	if (throttled)
+		m_NextSend = std::max(m_NextSend, now + m_Interval);
+}
+
+void BatchedActionPacer::OnUnavailable(time_point_t now)
+{
+	m_NextSend = now + INITIAL_INTERVAL;
+}
+
+void BatchedActionPacer::Reset()
+{
+	m_Interval = INITIAL_INTERVAL;
+	m_NextSend = {};
+}
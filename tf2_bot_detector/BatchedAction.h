@@ -3,11 +3,77 @@
 #include "Clock.h"
 #include "Log.h"
 
+#include <mh/coroutine/task.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
 #include <mutex>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace tf2_bot_detector
 {
+	struct BatchedActionStats
+	{
+		size_t m_Queued = 0;                // Waiting to be sent
+		size_t m_InFlightBatches = 0;
+		size_t m_InFlightItems = 0;
+		duration_t m_OldestQueuedAge{};     // How long the oldest item that is still waiting has been queued
+		duration_t m_Interval{};            // Current minimum time between batches
+
+		uint64_t m_BatchesSent = 0;
+		uint64_t m_Throttled = 0;           // Batches the API told us to slow down for
+		uint64_t m_Failed = 0;              // Batches that failed for any other reason
+
+		uint64_t m_ItemsCompleted = 0;      // Items that got their data
+		uint64_t m_ItemsGivenUp = 0;        // Items that still had no data after MAX_ATTEMPTS batches
+		duration_t m_LastLatency{};         // Sent to response, most recent batch
+		duration_t m_AverageTimeToData{};   // Queued to data arriving, per item
+		duration_t m_MaxTimeToData{};
+	};
+
+	// True if a request failed because the API wants us to slow down (HTTP 429, 503)
+	bool IsThrottlingError(const std::exception& e);
+
+	// Decides when a BatchedAction may send its next batch. Starts out fast, so the first data
+	// after joining a server shows up quickly, then eases toward MIN_INTERVAL as long as requests
+	// succeed. The interval never drops below what the observed latency can keep up with, and
+	// doubles every time a request fails or gets throttled. Having nothing to send requests with
+	// at all isn't a failure, it just retries at INITIAL_INTERVAL.
+	class BatchedActionPacer final
+	{
+	public:
+		static constexpr duration_t MIN_INTERVAL = std::chrono::milliseconds(500);
+		static constexpr duration_t INITIAL_INTERVAL = std::chrono::seconds(1);
+		static constexpr duration_t MAX_INTERVAL = std::chrono::seconds(60);
+
+		BatchedActionPacer(size_t maxInFlight);
+
+		bool CanSend(time_point_t now, size_t inFlight) const;
+		void OnSent(time_point_t now);
+
+		void OnSucceeded(duration_t latency);
+		void OnFailed(time_point_t now, bool throttled);
+		void OnUnavailable(time_point_t now);
+
+		// Back to how it started out, for when requests can be sent again after a while
+		void Reset();
+
+		duration_t GetInterval() const { return m_Interval; }
+
+	private:
+		size_t m_MaxInFlight;
+		duration_t m_Interval = INITIAL_INTERVAL;
+		time_point_t m_NextSend{};
+	};
+
+	// Collects items (usually SteamIDs) that need something looked up from a web API, and
+	// sends them off in batches of up to GetMaxBatchSize(), with up to MAX_IN_FLIGHT batches
+	// outstanding at once. See BatchedActionPacer for how often batches go out. Items that
+	// still haven't gotten their data after MAX_ATTEMPTS batches are handed to OnGaveUp().
 	template<typename TState, typename TItem, typename TResponse>
 	class BatchedAction
 	{
@@ -17,81 +83,240 @@ namespace tf2_bot_detector
 		using response_type = TResponse;
 		using response_future_type = mh::task<response_type>;
 
+		static constexpr size_t MAX_IN_FLIGHT = 3;
+
+		// Batches that were answered without an item, or that failed outright. Being throttled
+		// doesn't count, that says nothing about the items.
+		static constexpr uint32_t MAX_ATTEMPTS = 5;
+
 		BatchedAction() = default;
 		BatchedAction(const TState& state) : m_State(state) {}
 		BatchedAction(TState&& state) : m_State(std::move(state)) {}
 
+		// Also true while the item is in a batch that is in flight
 		bool IsQueued(const TItem& item) const
 		{
 			std::lock_guard lock(m_Mutex);
-			return m_Queued.contains(item);
+			if (m_Queued.contains(item))
+				return true;
+
+			for (const InFlightBatch& batch : m_InFlight)
+			{
+				if (batch.m_Items.contains(item))
+					return true;
+			}
+
+			return false;
 		}
 
 		void Queue(TItem&& item)
 		{
 			std::lock_guard lock(m_Mutex);
-			m_Queued.insert(std::move(item));
+			if (!IsQueued(item))
+				m_QueueOrder.push_back({ *m_Queued.insert(std::move(item)).first, clock_t::now() });
 		}
 		void Queue(const TItem& item)
 		{
 			std::lock_guard lock(m_Mutex);
-			m_Queued.insert(item);
+			if (!IsQueued(item))
+				m_QueueOrder.push_back({ *m_Queued.insert(item).first, clock_t::now() });
 		}
 
-		void Update()
+		void Update() { Update(clock_t::now()); }
+		void Update(time_point_t curTime)
 		{
-			std::invoke([&]
+			std::lock_guard lock(m_Mutex);
+
+			for (auto it = m_InFlight.begin(); it != m_InFlight.end(); )
+			{
+				if (it->m_Response.is_ready())
+				{
+					OnBatchFinished(*it, curTime);
+					it = m_InFlight.erase(it);
+				}
+				else
 				{
-					if (m_Queued.empty())
-						return;
+					++it;
+				}
+			}
+
+			if (!m_QueueOrder.empty() && m_Pacer.CanSend(curTime, m_InFlight.size()))
+				SendBatch(curTime);
+		}
+
+		BatchedActionStats GetStats() const
+		{
+			std::lock_guard lock(m_Mutex);
+
+			BatchedActionStats stats = m_Stats;
+			stats.m_Queued = m_QueueOrder.size();
+			stats.m_InFlightBatches = m_InFlight.size();
+			for (const InFlightBatch& batch : m_InFlight)
+				stats.m_InFlightItems += batch.m_Items.size();
 
-					if (m_ResponseFuture.valid())
-						return;
+			if (!m_QueueOrder.empty())
+				stats.m_OldestQueuedAge = clock_t::now() - m_QueueOrder.front().m_QueueTime;
 
-					const auto curTime = clock_t::now();
-					if (curTime < (m_LastUpdate + MIN_INTERVAL))
-						return;
+			stats.m_Interval = m_Pacer.GetInterval();
 
-					m_LastUpdate = curTime;
+			if (m_Stats.m_ItemsCompleted > 0)
+				stats.m_AverageTimeToData = m_TotalTimeToData / m_Stats.m_ItemsCompleted;
 
-					m_ResponseFuture = SendRequest(m_State, m_Queued);
-				});
+			return stats;
+		}
+
+	protected:
+		// Every API we batch for takes up to 100 IDs per request
+		virtual size_t GetMaxBatchSize() const { return 100; }
+
+		// collection is just the items in this batch. Anything still in it after OnDataReady()
+		// returns didn't get its data, and is queued again.
+		virtual response_future_type SendRequest(state_type& state, queue_collection_type& collection) = 0;
+		virtual void OnDataReady(state_type& state, const response_type& response, queue_collection_type& collection) = 0;
+
+		// The item isn't queued again unless Queue() is called for it
+		virtual void OnGaveUp(state_type& state, const TItem& item) {}
+
+	private:
+		struct QueuedItem
+		{
+			TItem m_Item;
+			time_point_t m_QueueTime{};
+			uint32_t m_Attempts = 0;
+		};
+
+		struct InFlightBatch
+		{
+			response_future_type m_Response;
+			queue_collection_type m_Items;          // What SendRequest()/OnDataReady() get to see
+			std::vector<QueuedItem> m_QueuedItems;  // The same items, oldest first
+			time_point_t m_SendTime{};
+		};
 
-			if (m_ResponseFuture.is_ready())
+		void SendBatch(time_point_t curTime)
+		{
+			InFlightBatch batch;
+			const size_t maxBatchSize = GetMaxBatchSize();
+			while (!m_QueueOrder.empty() && batch.m_QueuedItems.size() < maxBatchSize)
+			{
+				QueuedItem& next = m_QueueOrder.front();
+				m_Queued.erase(next.m_Item);
+				batch.m_Items.insert(next.m_Item);
+				batch.m_QueuedItems.push_back(std::move(next));
+				m_QueueOrder.pop_front();
+			}
+
+			batch.m_SendTime = curTime;
+
+			try
+			{
+				batch.m_Response = SendRequest(m_State, batch.m_Items);
+			}
+			catch (const std::exception& e)
+			{
+				LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to send batched action request");
+			}
+
+			if (!batch.m_Response.valid())
+			{
+				// Nothing to send it with right now (no HTTP client, API disabled...), try again later
+				m_Pacer.OnUnavailable(curTime);
+				m_Unavailable = true;
+				Requeue(batch, false);
+				return;
+			}
+
+			// Whatever held things up before has nothing to do with how fast we can go now
+			if (std::exchange(m_Unavailable, false))
+				m_Pacer.Reset();
+
+			m_Pacer.OnSent(curTime);
+			m_Stats.m_BatchesSent++;
+			m_InFlight.push_back(std::move(batch));
+		}
+
+		void OnBatchFinished(InFlightBatch& batch, time_point_t curTime)
+		{
+			bool throttled = false;
+			try
 			{
-				std::lock_guard lock(m_Mutex);
+				const auto& response = batch.m_Response.get();
+
+				m_Stats.m_LastLatency = curTime - batch.m_SendTime;
+				m_Pacer.OnSucceeded(m_Stats.m_LastLatency);
+
 				try
 				{
-					const auto& response = m_ResponseFuture.get();
+					OnDataReady(m_State, response, batch.m_Items);
+				}
+				catch (const std::exception& e)
+				{
+					LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to process batched action");
+				}
+			}
+			catch (const std::exception& e)
+			{
+				throttled = IsThrottlingError(e);
+				(throttled ? m_Stats.m_Throttled : m_Stats.m_Failed)++;
+				m_Pacer.OnFailed(curTime, throttled);
+
+				LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to get batched action future");
+			}
+
+			for (const QueuedItem& item : batch.m_QueuedItems)
+			{
+				if (batch.m_Items.contains(item.m_Item))
+					continue;
+
+				const duration_t timeToData = curTime - item.m_QueueTime;
+				m_Stats.m_ItemsCompleted++;
+				m_Stats.m_MaxTimeToData = std::max(m_Stats.m_MaxTimeToData, timeToData);
+				m_TotalTimeToData += timeToData;
+			}
+
+			Requeue(batch, !throttled);
+		}
+
+		// Puts anything left in the batch back at the front of the queue, keeping when it was
+		// first queued, so it goes out again in the next batch. Unless it has had MAX_ATTEMPTS
+		// already.
+		void Requeue(InFlightBatch& batch, bool countAttempt)
+		{
+			for (auto it = batch.m_QueuedItems.rbegin(); it != batch.m_QueuedItems.rend(); ++it)
+			{
+				if (!batch.m_Items.contains(it->m_Item))
+					continue;
+
+				if (countAttempt && ++it->m_Attempts >= MAX_ATTEMPTS)
+				{
+					m_Stats.m_ItemsGivenUp++;
 
 					try
 					{
-						OnDataReady(m_State, response, m_Queued);
+						OnGaveUp(m_State, it->m_Item);
 					}
 					catch (const std::exception& e)
 					{
-						LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to process batched action");
+						LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to give up on batched action item");
 					}
-				}
-				catch (const std::exception& e)
-				{
-					LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to get batched action future");
+
+					continue;
 				}
 
-				m_ResponseFuture = {};
+				if (m_Queued.insert(it->m_Item).second)
+					m_QueueOrder.push_front(std::move(*it));
 			}
 		}
 
-	protected:
-		virtual response_future_type SendRequest(state_type& state, queue_collection_type& collection) = 0;
-		virtual void OnDataReady(state_type& state, const response_type& response, queue_collection_type& collection) = 0;
-
-	private:
-		static constexpr duration_t MIN_INTERVAL = std::chrono::seconds(5);
 		state_type m_State{};
-		std::recursive_mutex m_Mutex;
-		queue_collection_type m_Queued;
-		response_future_type m_ResponseFuture;
-		time_point_t m_LastUpdate{};
+		mutable std::recursive_mutex m_Mutex;
+		queue_collection_type m_Queued;       // Waiting to be sent
+		std::deque<QueuedItem> m_QueueOrder;  // The same items, oldest first
+		std::vector<InFlightBatch> m_InFlight;
+
+		BatchedActionPacer m_Pacer{ MAX_IN_FLIGHT };
+		bool m_Unavailable = false;  // The last time we tried, SendRequest() had nothing to send with
+		BatchedActionStats m_Stats;
+		duration_t m_TotalTimeToData{};
 	};
 }
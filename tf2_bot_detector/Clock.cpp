@@ -2,8 +2,16 @@
 
 #include <mh/chrono/chrono_helpers.hpp>
 
+#include <atomic>
+
 using namespace tf2_bot_detector;
 
+namespace
+{
+	std::atomic_bool s_VirtualTimeOverridden = false;
+	std::atomic<duration_t::rep> s_VirtualTime = 0;
+}
+
 tm tf2_bot_detector::ToTM(const time_point_t& ts)
 {
 	return mh::chrono::to_tm(ts, mh::chrono::time_zone::local);
@@ -18,3 +26,19 @@ time_point_t tf2_bot_detector::GetLocalTimePoint()
 {
 	return mh::chrono::current_time_point();
 }
+
+time_point_t tf2_bot_detector::GetVirtualTime()
+{
+	if (s_VirtualTimeOverridden)
+		return time_point_t(duration_t(s_VirtualTime.load()));
+
+	return clock_t::now();
+}
+
+void tf2_bot_detector::SetVirtualTimeOverride(std::optional<time_point_t> time)
+{
+	if (time)
+		s_VirtualTime = time->time_since_epoch().count();
+
+	s_VirtualTimeOverridden = time.has_value();
+}
@@ -3,6 +3,7 @@
 #include <cassert>
 #include <chrono>
 #include <ctime>
+#include <optional>
 #include <ostream>
 
 namespace tf2_bot_detector
@@ -56,6 +57,12 @@ namespace tf2_bot_detector
 	tm GetLocalTM();
 	time_point_t GetLocalTimePoint();
 
+	// "Now" for anything that gets compared against console log timestamps. This is just
+	// clock_t::now(), unless a console log replay has taken over the clock so that the
+	// recorded timestamps look current.
+	time_point_t GetVirtualTime();
+	void SetVirtualTimeOverride(std::optional<time_point_t> time);
+
 	template<typename TRep, typename TPeriod>
 	struct HumanDuration
 	{
@@ -11,7 +11,7 @@ void CompensatedTS::SetRecorded(time_point_t recorded)
 	assert(recorded.time_since_epoch() > 0s);
 	m_Recorded = recorded;
 
-	const auto now = clock_t::now();
+	const auto now = GetVirtualTime();
 	if (m_Snapshot && (now - *m_Snapshot) >= 1s)
 		m_Snapshot.reset();
 
@@ -23,7 +23,7 @@ void CompensatedTS::SetRecorded(time_point_t recorded)
 
 void CompensatedTS::Snapshot()
 {
-	const auto now = clock_t::now();
+	const auto now = GetVirtualTime();
 	const auto extra = now - m_Parsed;
 	[[maybe_unused]] const auto extraSeconds = to_seconds(extra);
 	const time_point_t adjustedTS = m_Recorded.value() + extra;
@@ -0,0 +1,251 @@
+#include "ChatWrapperMatcher.h"
+
+#include <algorithm>
+#include <bit>
+#include <deque>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	constexpr uint32_t NO_TRANSITION = ~uint32_t(0);
+}
+
+ChatWrapperMatcher::ChatWrapperMatcher(const ChatWrappers& wrappers)
+{
+	std::array<std::string_view, MARKER_COUNT> markers;
+	for (size_t i = 0; i < size_t(ChatCategory::COUNT); i++)
+	{
+		const auto& type = wrappers.m_Types[i];
+		const auto category = ChatCategory(i);
+		markers[GetMarkerIndex(category, MarkerType::FullStart)] = type.m_Full.m_Start.m_Narrow;
+		markers[GetMarkerIndex(category, MarkerType::FullEnd)] = type.m_Full.m_End.m_Narrow;
+		markers[GetMarkerIndex(category, MarkerType::NameStart)] = type.m_Name.m_Start.m_Narrow;
+		markers[GetMarkerIndex(category, MarkerType::NameEnd)] = type.m_Name.m_End.m_Narrow;
+		markers[GetMarkerIndex(category, MarkerType::MessageStart)] = type.m_Message.m_Start.m_Narrow;
+		markers[GetMarkerIndex(category, MarkerType::MessageEnd)] = type.m_Message.m_End.m_Narrow;
+
+		for (size_t t = 0; t < size_t(MarkerType::COUNT); t++)
+		{
+			if (MarkerType(t) != MarkerType::FullStart)
+				m_BodyMarkers[i] |= uint64_t(1) << GetMarkerIndex(category, MarkerType(t));
+		}
+	}
+
+	// Only the bytes that actually show up in a wrapper need their own column in the
+	// transition table, everything else behaves the same
+	for (const auto& marker : markers)
+	{
+		for (char c : marker)
+		{
+			if (m_ByteClasses[uint8_t(c)] == 0)
+				m_ByteClasses[uint8_t(c)] = uint8_t(m_ByteClassCount++);
+		}
+	}
+
+	// Build the trie
+	const auto AddState = [&](uint32_t depth) -> state_t
+	{
+		m_Transitions.resize(m_Transitions.size() + m_ByteClassCount, NO_TRANSITION);
+		m_Outputs.push_back(0);
+		m_Depths.push_back(depth);
+		return state_t(m_Outputs.size() - 1);
+	};
+
+	AddState(0);
+	for (size_t i = 0; i < MARKER_COUNT; i++)
+	{
+		const auto& marker = markers[i];
+		m_MarkerLengths[i] = marker.size();
+
+		if ((i % size_t(MarkerType::COUNT)) == size_t(MarkerType::FullStart))
+			m_MaxStartLength = std::max(m_MaxStartLength, marker.size());
+
+		if (marker.empty())
+			continue; // Handled in Match()
+
+		state_t state = 0;
+		for (size_t c = 0; c < marker.size(); c++)
+		{
+			const size_t transition = state * m_ByteClassCount + m_ByteClasses[uint8_t(marker[c])];
+			if (m_Transitions[transition] == NO_TRANSITION)
+			{
+				const state_t newState = AddState(uint32_t(c + 1));
+				m_Transitions[transition] = newState;
+			}
+
+			state = m_Transitions[transition];
+		}
+
+		m_Outputs[state] |= uint64_t(1) << i;
+	}
+
+	// Turn it into a DFA: missing transitions follow the failure links, and every state also
+	// outputs whatever its failure state does
+	std::vector<state_t> failures(m_Outputs.size(), 0);
+	std::deque<state_t> queue;
+
+	for (size_t byteClass = 0; byteClass < m_ByteClassCount; byteClass++)
+	{
+		state_t& next = m_Transitions[byteClass];
+		if (next == NO_TRANSITION)
+			next = 0;
+		else
+			queue.push_back(next);
+	}
+
+	while (!queue.empty())
+	{
+		const state_t state = queue.front();
+		queue.pop_front();
+
+		for (size_t byteClass = 0; byteClass < m_ByteClassCount; byteClass++)
+		{
+			state_t& next = m_Transitions[state * m_ByteClassCount + byteClass];
+			const state_t failureNext = m_Transitions[failures[state] * m_ByteClassCount + byteClass];
+
+			if (next == NO_TRANSITION)
+			{
+				next = failureNext;
+			}
+			else
+			{
+				failures[next] = failureNext;
+				m_Outputs[next] |= m_Outputs[failureNext];
+				queue.push_back(next);
+			}
+		}
+	}
+
+	// Widen each row to a power of two, so going from a transition back to a state index is a shift
+	m_StateShift = uint32_t(std::countr_zero(std::bit_ceil(m_ByteClassCount)));
+	std::vector<state_t> transitions(m_Outputs.size() << m_StateShift, 0);
+	for (size_t state = 0; state < m_Outputs.size(); state++)
+	{
+		for (size_t byteClass = 0; byteClass < m_ByteClassCount; byteClass++)
+		{
+			const state_t next = m_Transitions[state * m_ByteClassCount + byteClass];
+			transitions[(state << m_StateShift) + byteClass] = (next << m_StateShift) | (m_Outputs[next] ? STATE_HAS_OUTPUT : 0);
+		}
+	}
+
+	m_Transitions = std::move(transitions);
+}
+
+ChatWrapperMatchResult ChatWrapperMatcher::Match(const std::string_view& text, ChatWrapperMatch& match) const
+{
+	// Find the first category (in enum order) whose start wrapper begins the text
+	size_t category = size_t(ChatCategory::COUNT);
+	for (size_t i = 0; i < size_t(ChatCategory::COUNT); i++)
+	{
+		if (m_MarkerLengths[GetMarkerIndex(ChatCategory(i), MarkerType::FullStart)] == 0)
+		{
+			category = i;
+			break;
+		}
+	}
+
+	{
+		state_t state = 0;
+		const size_t end = std::min(text.size(), m_MaxStartLength);
+		for (size_t i = 0; i < end; i++)
+		{
+			state = Step(state, text[i]);
+			if (m_Depths[GetStateIndex(state)] != i + 1)
+				break; // The longest wrapper that ends here started after the beginning of the text
+
+			for (uint64_t outputs = m_Outputs[GetStateIndex(state)]; outputs; outputs &= outputs - 1)
+			{
+				const size_t marker = size_t(std::countr_zero(outputs));
+				if ((marker % size_t(MarkerType::COUNT)) == size_t(MarkerType::FullStart) &&
+					m_MarkerLengths[marker] == (i + 1))
+				{
+					category = std::min(category, marker / size_t(MarkerType::COUNT));
+				}
+			}
+		}
+	}
+
+	if (category >= size_t(ChatCategory::COUNT))
+		return ChatWrapperMatchResult::NotChat;
+
+	const auto GetLength = [&](MarkerType type) { return m_MarkerLengths[GetMarkerIndex(ChatCategory(category), type)]; };
+
+	const size_t bodyBegin = GetLength(MarkerType::FullStart);
+	const auto body = text.substr(bodyBegin);
+
+	// Start of the first occurrence of each marker in the body
+	std::array<size_t, size_t(MarkerType::COUNT)> firstStarts;
+	for (size_t type = 0; type < size_t(MarkerType::COUNT); type++)
+		firstStarts[type] = GetLength(MarkerType(type)) == 0 ? 0 : ChatWrapperMatch::npos;
+
+	size_t& bodyEnd = firstStarts[size_t(MarkerType::FullEnd)];
+	if (bodyEnd == ChatWrapperMatch::npos)
+	{
+		const uint64_t interesting = m_BodyMarkers[category];
+		state_t state = 0;
+		for (size_t i = 0; i < body.size() && bodyEnd == ChatWrapperMatch::npos; i++)
+		{
+			// Plain text (player names, messages) keeps us at the root, and doesn't need to go
+			// through the transition table
+			if (state == 0)
+			{
+				while (i < body.size() && m_ByteClasses[uint8_t(body[i])] == 0)
+					i++;
+
+				if (i == body.size())
+					break;
+			}
+
+			state = Step(state, body[i]);
+			if (!(state & STATE_HAS_OUTPUT))
+				continue;
+
+			// Every marker has a fixed length, so the first time we see one end is also where its
+			// first occurrence starts
+			for (uint64_t outputs = m_Outputs[GetStateIndex(state)] & interesting; outputs; outputs &= outputs - 1)
+			{
+				const size_t marker = size_t(std::countr_zero(outputs));
+				size_t& firstStart = firstStarts[marker % size_t(MarkerType::COUNT)];
+				if (firstStart == ChatWrapperMatch::npos)
+					firstStart = i + 1 - m_MarkerLengths[marker];
+			}
+		}
+
+		if (bodyEnd == ChatWrapperMatch::npos)
+			return ChatWrapperMatchResult::Incomplete;
+	}
+
+	// Name/message wrappers only count if they are entirely before the end wrapper
+	const auto GetInnerMarker = [&](MarkerType type)
+	{
+		const size_t start = firstStarts[size_t(type)];
+		if (start == ChatWrapperMatch::npos || (start + GetLength(type)) > bodyEnd)
+			return ChatWrapperMatch::npos;
+
+		return start;
+	};
+
+	match = {};
+	match.m_Category = ChatCategory(category);
+	match.m_BodyLength = bodyEnd;
+	match.m_Length = bodyBegin + bodyEnd + GetLength(MarkerType::FullEnd);
+	match.m_NameBegin = GetInnerMarker(MarkerType::NameStart);
+	match.m_NameEnd = GetInnerMarker(MarkerType::NameEnd);
+	match.m_MessageBegin = GetInnerMarker(MarkerType::MessageStart);
+	match.m_MessageEnd = GetInnerMarker(MarkerType::MessageEnd);
+
+	if (match.HasNameAndMessage())
+	{
+		const auto bodyText = body.substr(0, bodyEnd);
+		const size_t nameStartLength = GetLength(MarkerType::NameStart);
+		const size_t messageStartLength = GetLength(MarkerType::MessageStart);
+
+		match.m_Name = bodyText.substr(match.m_NameBegin + nameStartLength,
+			match.m_NameEnd - match.m_NameBegin - nameStartLength);
+		match.m_Message = bodyText.substr(match.m_MessageBegin + messageStartLength,
+			match.m_MessageEnd - match.m_MessageBegin - messageStartLength);
+	}
+
+	return ChatWrapperMatchResult::Match;
+}
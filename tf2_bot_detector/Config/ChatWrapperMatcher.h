@@ -0,0 +1,103 @@
+#pragma once
+
+#include "ChatWrappers.h"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	enum class ChatWrapperMatchResult
+	{
+		NotChat,      // The text doesn't start with any chat wrapper
+		Incomplete,   // The text starts with a chat wrapper, but its end isn't in the text (yet)
+		Match,
+	};
+
+	struct ChatWrapperMatch
+	{
+		static constexpr size_t npos = std::string_view::npos;
+
+		ChatCategory m_Category{};
+		size_t m_Length = 0;              // Length of the whole wrapped message, including the outer wrappers
+		size_t m_BodyLength = 0;          // Length of everything between the outer wrappers
+
+		// Offsets of the name/message wrappers, relative to the start of the body. npos if missing.
+		size_t m_NameBegin = npos;
+		size_t m_NameEnd = npos;
+		size_t m_MessageBegin = npos;
+		size_t m_MessageEnd = npos;
+
+		// Only set if all four of the wrappers above were found
+		std::string_view m_Name;
+		std::string_view m_Message;
+
+		bool HasNameAndMessage() const
+		{
+			return m_NameBegin != npos && m_NameEnd != npos && m_MessageBegin != npos && m_MessageEnd != npos;
+		}
+	};
+
+	// All of the wrapper sequences in a ChatWrappers, compiled into a single Aho-Corasick
+	// automaton. Finds the category of a wrapped chat message and splits out the player name
+	// and message in one pass over the text, instead of testing each category's wrappers with
+	// separate starts_with()/find() calls.
+	class ChatWrapperMatcher final
+	{
+	public:
+		explicit ChatWrapperMatcher(const ChatWrappers& wrappers);
+
+		// text starts at the beginning of a console line, and may continue on past the end of it
+		// (chat messages can contain newlines, so the closing wrapper may be several lines away).
+		// Behaves exactly like checking each category in order for a line that starts with
+		// m_Full.m_Start, then searching the text after it for the first m_Full.m_End, and
+		// finally searching between the two for the first occurrence of each name/message wrapper.
+		ChatWrapperMatchResult Match(const std::string_view& text, ChatWrapperMatch& match) const;
+
+	private:
+		enum class MarkerType : uint8_t
+		{
+			FullStart,
+			FullEnd,
+			NameStart,
+			NameEnd,
+			MessageStart,
+			MessageEnd,
+
+			COUNT,
+		};
+
+		static constexpr size_t MARKER_COUNT = size_t(ChatCategory::COUNT) * size_t(MarkerType::COUNT);
+		static_assert(MARKER_COUNT <= 64, "Marker sets are stored as 64 bit masks");
+
+		static constexpr size_t GetMarkerIndex(ChatCategory category, MarkerType type)
+		{
+			return size_t(category) * size_t(MarkerType::COUNT) + size_t(type);
+		}
+
+		// States are stored pre-shifted by m_StateShift (enough bits for every byte class), so they
+		// can be used as an index into m_Transitions directly. States that output at least one
+		// marker have STATE_HAS_OUTPUT set in every transition that leads to them.
+		using state_t = uint32_t;
+		static constexpr state_t STATE_HAS_OUTPUT = state_t(1) << 31;
+
+		std::array<uint8_t, 256> m_ByteClasses{};  // Bytes that don't appear in any wrapper share class 0
+		size_t m_ByteClassCount = 1;
+		uint32_t m_StateShift = 0;
+		std::vector<state_t> m_Transitions;         // [state + byteClass]
+		std::vector<uint64_t> m_Outputs;            // Markers that end at each state, [state >> m_StateShift]
+		std::vector<uint32_t> m_Depths;             // Length of the path from the root to each state, [state >> m_StateShift]
+
+		std::array<size_t, MARKER_COUNT> m_MarkerLengths{};
+		std::array<uint64_t, size_t(ChatCategory::COUNT)> m_BodyMarkers{}; // Everything but m_Full.m_Start
+		size_t m_MaxStartLength = 0;
+
+		state_t Step(state_t state, char c) const
+		{
+			return m_Transitions[(state & ~STATE_HAS_OUTPUT) + m_ByteClasses[uint8_t(c)]];
+		}
+		size_t GetStateIndex(state_t state) const { return (state & ~STATE_HAS_OUTPUT) >> m_StateShift; }
+	};
+}
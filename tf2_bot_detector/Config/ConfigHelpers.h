@@ -8,6 +8,7 @@
 #include <nlohmann/json_fwd.hpp>
 
 #include <cassert>
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <vector>
@@ -133,6 +134,17 @@ namespace tf2_bot_detector
 		co_return file;
 	}
 
+	// Identifies what a ConfigFileGroupBase has loaded so far. The official and third party lists
+	// load in the background, so this changes when they finish, not just when LoadFiles() is called.
+	struct ConfigFileGroupVersion
+	{
+		uint64_t m_LoadCount = 0;
+		bool m_OfficialLoaded = false;
+		bool m_ThirdPartyLoaded = false;
+
+		bool operator==(const ConfigFileGroupVersion&) const = default;
+	};
+
 	template<typename T, typename TOthers = typename T::collection_type>
 	class ConfigFileGroupBase
 	{
@@ -160,6 +172,7 @@ namespace tf2_bot_detector
 				m_OfficialList = mh::make_ready_task<T>();
 
 			m_ThirdPartyLists = LoadThirdPartyListsAsync(paths);
+			m_LoadCount++;
 		}
 
 		void SaveFiles() const
@@ -229,12 +242,19 @@ namespace tf2_bot_detector
 			return retVal;
 		}
 
+		ConfigFileGroupVersion GetVersion() const
+		{
+			return { m_LoadCount, m_OfficialList.try_get() != nullptr, m_ThirdPartyLists.try_get() != nullptr };
+		}
+
 		const Settings* m_Settings = nullptr;
 		mh::task<T> m_OfficialList;
 		std::optional<T> m_UserList;
 		mh::task<collection_type> m_ThirdPartyLists;
 
 	private:
+		uint64_t m_LoadCount = 0;
+
 		mh::task<collection_type> LoadThirdPartyListsAsync(ConfigFilePaths paths)
 		{
 			collection_type collection;
@@ -135,16 +135,16 @@ std::string DRPInfo::Map::GetFriendlyName() const
 bool DRPInfo::Map::Matches(const std::string_view& mapName) const
 {
 	mh::fmtstr<512> buf("{}{}", m_MapNames.at(0).c_str(), R"regex(?(?:_(?!.*_)(?:(?:rc)|(?:final)|(?:[abv]))\d*[a-zA-Z]?)?)regex");
-	const std::regex s_MainRegex(buf.c_str(), std::regex::icase);
+	const std::regex& mainRegex = GetCachedRegex(buf.c_str(), std::regex::icase);
 
-	if (std::regex_match(mapName.begin(), mapName.end(), s_MainRegex))
+	if (std::regex_match(mapName.begin(), mapName.end(), mainRegex))
 		return true;
 
 	for (size_t i = 1; i < m_MapNames.size(); i++)
 	{
 		try
 		{
-			const std::regex regex(m_MapNames[i], std::regex::icase);
+			const std::regex& regex = GetCachedRegex(m_MapNames[i], std::regex::icase);
 			if (std::regex_match(mapName.begin(), mapName.end(), regex))
 				return true;
 		}
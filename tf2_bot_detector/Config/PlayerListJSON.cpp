@@ -226,7 +226,7 @@ bool PlayerListJSON::LoadFiles()
 		}
 
 		if (action != ModifyPlayerAction::NoChanges)
-			m_CFGGroup.SaveFiles();
+			SaveFiles();
 	}
 
 	return true;
@@ -234,6 +234,9 @@ bool PlayerListJSON::LoadFiles()
 
 void PlayerListJSON::SaveFiles() const
 {
+	if (m_Settings->m_Unsaved.m_ReadOnlyConfigs)
+		return;
+
 	m_CFGGroup.SaveFiles();
 }
 
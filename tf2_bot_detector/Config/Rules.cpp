@@ -1,6 +1,7 @@
 #include "Rules.h"
 #include "Networking/SteamAPI.h"
 #include "Util/JSONUtils.h"
+#include "Util/RegexUtils.h"
 #include "IPlayer.h"
 #include "Log.h"
 #include "PlayerListJSON.h"
@@ -325,7 +326,7 @@ bool TextMatch::Match(const std::string_view& text) const try
 					if (!m_CaseSensitive)
 						options = std::regex_constants::icase;
 
-					std::regex r(pattern.begin(), pattern.end(), options);
+					const std::regex& r = GetCachedRegex(pattern, options);
 					return std::regex_match(text.begin(), text.end(), r);
 				}
 				catch (const std::regex_error&)
@@ -601,6 +602,17 @@ bool ModerationRule::Match(const IPlayer& player, const std::string_view& chatMs
 	return MatchRules(m_Triggers.m_Mode, usernameMatch, chatMsgMatch, avatarMatch, personanameMatch);
 }
 
+ModerationRuleInputs::ModerationRuleInputs(const ConfigFileGroupVersion& rules, const IPlayer& player) :
+	m_Rules(rules),
+	m_Name(player.GetNameUnsafe())
+{
+	if (const auto& summary = player.GetPlayerSummary())
+	{
+		m_Nickname = summary->m_Nickname;
+		m_AvatarHash = summary->m_AvatarHash;
+	}
+}
+
 bool AvatarMatch::Match(const std::string_view& avatarHash) const
 {
 	return m_AvatarHash == avatarHash;
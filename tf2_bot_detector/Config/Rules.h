@@ -7,6 +7,7 @@
 
 #include <filesystem>
 #include <optional>
+#include <string>
 #include <vector>
 
 namespace tf2_bot_detector
@@ -82,6 +83,21 @@ namespace tf2_bot_detector
 		} m_Actions;
 	};
 
+	// Everything ModerationRule::Match() looks at, other than chat messages, for one player
+	// against one version of the rules. If this is the same as the last time the rules were run
+	// against a player, running them again gives the same result.
+	struct ModerationRuleInputs
+	{
+		ModerationRuleInputs(const ConfigFileGroupVersion& rules, const IPlayer& player);
+
+		ConfigFileGroupVersion m_Rules;
+		std::string m_Name;
+		std::optional<std::string> m_Nickname;   // Empty until the player summary arrives
+		std::optional<std::string> m_AvatarHash;
+
+		bool operator==(const ModerationRuleInputs&) const = default;
+	};
+
 	class ModerationRules
 	{
 	public:
@@ -93,6 +109,9 @@ namespace tf2_bot_detector
 		mh::generator<const ModerationRule&> GetRules() const;
 		size_t GetRuleCount() const { return m_CFGGroup.size(); }
 
+		// Changes whenever GetRules() might yield something different
+		ConfigFileGroupVersion GetVersion() const { return m_CFGGroup.GetVersion(); }
+
 	private:
 		using RuleList_t = std::vector<ModerationRule>;
 		struct RuleFile final : SharedConfigFileBase
@@ -345,10 +345,19 @@ catch (...)
 	throw;
 }
 
+Settings::Settings(DefaultsOnly) :
+	m_FileBacked(false)
+{
+	PostLoad(false);
+}
+
 Settings::~Settings() = default;
 
 void Settings::LoadFile() try
 {
+	if (!m_FileBacked)
+		return;
+
 	ConfigFileBase::LoadFileAsync("cfg/settings.json").get();
 }
 catch (...)
@@ -359,6 +368,9 @@ catch (...)
 
 bool Settings::SaveFile() const try
 {
+	if (!m_FileBacked)
+		return true;
+
 	return !ConfigFileBase::SaveFile("cfg/settings.json");
 }
 catch (...)
@@ -466,6 +478,7 @@ void Settings::Deserialize(const nlohmann::json& json)
 		try_get_to_defaulted(*found, m_AutoVotekickDelay, "auto_votekick_delay", DEFAULTS.m_AutoVotekickDelay);
 		try_get_to_defaulted(*found, m_AutoMark, "auto_mark", DEFAULTS.m_AutoMark);
 		try_get_to_defaulted(*found, m_LazyLoadAPIData, "lazy_load_api_data", DEFAULTS.m_LazyLoadAPIData);
+		try_get_to_defaulted(*found, m_PlayerCacheMemoryLimitMB, "player_cache_memory_limit_mb", DEFAULTS.m_PlayerCacheMemoryLimitMB);
 		try_get_to_defaulted(*found, m_ConfigCompatibilityMode, "config_compatibility_mode", DEFAULTS.m_ConfigCompatibilityMode);
 
 		{
@@ -544,6 +557,7 @@ void Settings::Serialize(nlohmann::json& json) const
 				{ "auto_votekick_delay", m_AutoVotekickDelay },
 				{ "auto_mark", m_AutoMark },
 				{ "lazy_load_api_data", m_LazyLoadAPIData },
+				{ "player_cache_memory_limit_mb", m_PlayerCacheMemoryLimitMB },
 				{ "config_compatibility_mode", m_ConfigCompatibilityMode },
 			}
 		},
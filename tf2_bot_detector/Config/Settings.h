@@ -8,6 +8,7 @@
 #include <nlohmann/json_fwd.hpp>
 
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -29,6 +30,7 @@ namespace tf2_bot_detector
 	void to_json(nlohmann::json& j, const Font& d);
 	void from_json(const nlohmann::json& j, Font& d);
 
+	class ChatWrapperMatcher;
 	class IHTTPClient;
 	enum class ReleaseChannel;
 
@@ -119,6 +121,10 @@ namespace tf2_bot_detector
 
 		bool m_LazyLoadAPIData = true;
 
+		// Players who have left are moved out of memory, least recently seen first, once
+		// everyone we know about takes up more than this
+		int m_PlayerCacheMemoryLimitMB = 16;
+
 		bool m_ConfigCompatibilityMode = true;
 
 		std::optional<ReleaseChannel> m_ReleaseChannel;
@@ -150,6 +156,11 @@ namespace tf2_bot_detector
 		Settings();
 		~Settings();
 
+		// Just the defaults. cfg/settings.json is never read or written, not even by LoadFile()
+		// or SaveFile(). For offline replays and tests, which mustn't touch the user's settings.
+		struct DefaultsOnly {};
+		explicit Settings(DefaultsOnly);
+
 		void LoadFile();
 		bool SaveFile() const;
 
@@ -161,8 +172,16 @@ namespace tf2_bot_detector
 
 			bool m_DebugShowCommands = false;
 
+			// Keep changes to the playerlist in memory instead of writing them to disk
+			bool m_ReadOnlyConfigs = false;
+
+			// Fold bursts of voice/split packet/user message lines into summaries, see ConsoleLineCoalescer.
+			// Off by default: dispatching those lines one at a time is cheaper than summarizing them.
+			bool m_CoalesceConsoleLines = false;
+
 			uint32_t m_ChatMsgWrappersToken{};
 			std::optional<ChatWrappers> m_ChatMsgWrappers;
+			std::shared_ptr<const ChatWrapperMatcher> m_ChatMsgWrappersMatcher; // Compiled from m_ChatMsgWrappers
 			std::unique_ptr<srcon::async_client> m_RCONClient;
 
 		} m_Unsaved;
@@ -253,6 +272,8 @@ namespace tf2_bot_detector
 		void AddDefaultGotoProfileSites();
 
 		mutable std::shared_ptr<IHTTPClient> m_HTTPClient;
+
+		bool m_FileBacked = true;
 	};
 }
 
@@ -0,0 +1,160 @@
+#include "ConsoleLineCoalescer.h"
+#include "ConsoleLines.h"
+#include "NetworkStatus.h"
+#include "GameData/UserMessageType.h"
+#include "UI/ImGui_TF2BotDetector.h"
+
+#include <mh/text/format.hpp>
+
+#include <algorithm>
+
+using namespace tf2_bot_detector;
+
+VoiceReceiveSummaryLine::VoiceReceiveSummaryLine(time_point_t timestamp) :
+	BaseClass(timestamp)
+{
+}
+
+std::shared_ptr<IConsoleLine> VoiceReceiveSummaryLine::TryParse(const ConsoleLineTryParseArgs& args)
+{
+	return nullptr; // Only ever made by ConsoleLineCoalescer
+}
+
+void VoiceReceiveSummaryLine::Print(const PrintArgs& args) const
+{
+	for (const Entity& entity : m_Entities)
+		ImGui::TextFmt("Voice - ent {}: {} packets, {} bytes", entity.m_EntIndex, entity.m_Packets, entity.m_Bytes);
+}
+
+SplitPacketSummaryLine::SplitPacketSummaryLine(time_point_t timestamp) :
+	BaseClass(timestamp)
+{
+}
+
+std::shared_ptr<IConsoleLine> SplitPacketSummaryLine::TryParse(const ConsoleLineTryParseArgs& args)
+{
+	return nullptr; // Only ever made by ConsoleLineCoalescer
+}
+
+void SplitPacketSummaryLine::Print(const PrintArgs& args) const
+{
+	for (const Sequence& seq : m_Sequences)
+	{
+		ImGui::TextFmt("<-- [{}] Split packet {} from {}: {}/{} fragments, {} bytes", int(seq.m_SocketType),
+			seq.m_Sequence, m_Address, seq.m_Received, seq.m_Count, seq.m_Bytes);
+	}
+}
+
+SVCUserMessageSummaryLine::SVCUserMessageSummaryLine(time_point_t timestamp) :
+	BaseClass(timestamp)
+{
+}
+
+std::shared_ptr<IConsoleLine> SVCUserMessageSummaryLine::TryParse(const ConsoleLineTryParseArgs& args)
+{
+	return nullptr; // Only ever made by ConsoleLineCoalescer
+}
+
+void SVCUserMessageSummaryLine::Print(const PrintArgs& args) const
+{
+	for (const Message& msg : m_Messages)
+	{
+		ImGui::TextFmt("Msg from {}: svc_UserMessage: type {}, {} messages, {} bytes",
+			m_Address, int(msg.m_Type), msg.m_Count, msg.m_Bytes);
+	}
+}
+
+ConsoleLineCoalescer::ConsoleLineCoalescer(ConsoleLineTypeMask types) :
+	m_Types(types)
+{
+	m_Pending.reserve(3);
+}
+
+template<typename T>
+T& ConsoleLineCoalescer::GetOrCreatePending(std::shared_ptr<T>& summary, time_point_t timestamp)
+{
+	if (!summary)
+	{
+		summary = std::make_shared<T>(timestamp);
+		m_Pending.push_back(summary);
+		m_PendingTimestamp = timestamp;
+	}
+
+	return *summary;
+}
+
+bool ConsoleLineCoalescer::TryCoalesce(const IConsoleLine& line)
+{
+	const ConsoleLineType type = line.GetType();
+	if (!m_Types.Contains(type))
+		return false;
+
+	switch (type)
+	{
+	case ConsoleLineType::VoiceReceive:
+	{
+		auto& voiceLine = static_cast<const VoiceReceiveLine&>(line);
+		auto& entities = GetOrCreatePending(m_Voice, line.GetTimestamp()).m_Entities;
+
+		auto entity = std::find_if(entities.begin(), entities.end(),
+			[&](const VoiceReceiveSummaryLine::Entity& e) { return e.m_EntIndex == voiceLine.GetEntIndex(); });
+		if (entity == entities.end())
+			entity = entities.insert(entities.end(), { .m_EntIndex = voiceLine.GetEntIndex() });
+
+		entity->m_Packets++;
+		entity->m_Bytes += voiceLine.GetBufSize();
+		break;
+	}
+	case ConsoleLineType::SplitPacket:
+	{
+		const SplitPacket& packet = static_cast<const SplitPacketLine&>(line).GetSplitPacket();
+		auto& summary = GetOrCreatePending(m_SplitPackets, line.GetTimestamp());
+
+		auto seq = std::find_if(summary.m_Sequences.begin(), summary.m_Sequences.end(),
+			[&](const SplitPacketSummaryLine::Sequence& s)
+			{
+				return s.m_Sequence == packet.m_Sequence && s.m_SocketType == packet.m_SocketType;
+			});
+		if (seq == summary.m_Sequences.end())
+		{
+			seq = summary.m_Sequences.insert(summary.m_Sequences.end(),
+				{ .m_SocketType = packet.m_SocketType, .m_Sequence = packet.m_Sequence, .m_Count = packet.m_Count });
+		}
+
+		seq->m_Received++;
+		seq->m_Bytes += packet.m_Size;
+		if (summary.m_Address != packet.m_Address)
+			summary.m_Address = packet.m_Address;
+
+		break;
+	}
+	case ConsoleLineType::SVC_UserMessage:
+	{
+		auto& msgLine = static_cast<const SVCUserMessageLine&>(line);
+		const UserMessageType msgType = msgLine.GetUserMessageType();
+
+		if (IsVoteUserMessage(msgType))
+			return false;
+
+		auto& summary = GetOrCreatePending(m_UserMessages, line.GetTimestamp());
+
+		auto msg = std::find_if(summary.m_Messages.begin(), summary.m_Messages.end(),
+			[&](const SVCUserMessageSummaryLine::Message& m) { return m.m_Type == msgType; });
+		if (msg == summary.m_Messages.end())
+			msg = summary.m_Messages.insert(summary.m_Messages.end(), { .m_Type = msgType });
+
+		msg->m_Count++;
+		msg->m_Bytes += msgLine.GetUserMessageBytes();
+		if (summary.m_Address != msgLine.GetAddress())
+			summary.m_Address = msgLine.GetAddress();
+
+		break;
+	}
+
+	default:
+		return false;
+	}
+
+	m_Stats.m_LinesCoalesced++;
+	return true;
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Clock.h"
+#include "ConsoleLineListener.h"
+#include "IConsoleLine.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	enum class SocketType : uint8_t;
+	enum class UserMessageType;
+
+	// Every VoiceReceiveLine from one tick
+	class VoiceReceiveSummaryLine final : public ConsoleLineBase<VoiceReceiveSummaryLine, false>
+	{
+		using BaseClass = ConsoleLineBase;
+
+	public:
+		struct Entity
+		{
+			uint8_t m_EntIndex{};
+			uint32_t m_Packets{};
+			uint32_t m_Bytes{};
+		};
+
+		VoiceReceiveSummaryLine(time_point_t timestamp);
+		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+
+		const std::vector<Entity>& GetEntities() const { return m_Entities; }
+
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::VoiceReceiveSummary;
+		ConsoleLineType GetType() const override { return TYPE; }
+		bool ShouldPrint() const override { return false; }
+		void Print(const PrintArgs& args) const override;
+
+	private:
+		friend class ConsoleLineCoalescer;
+		std::vector<Entity> m_Entities;
+	};
+
+	// Every SplitPacketLine from one tick, by sequence
+	class SplitPacketSummaryLine final : public ConsoleLineBase<SplitPacketSummaryLine, false>
+	{
+		using BaseClass = ConsoleLineBase;
+
+	public:
+		struct Sequence
+		{
+			SocketType m_SocketType{};
+			uint16_t m_Sequence{};
+			uint8_t m_Count{};      // Fragments the packet was split into
+			uint8_t m_Received{};   // Fragments seen this tick
+			uint32_t m_Bytes{};
+		};
+
+		SplitPacketSummaryLine(time_point_t timestamp);
+		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+
+		const std::vector<Sequence>& GetSequences() const { return m_Sequences; }
+		const std::string& GetAddress() const { return m_Address; }
+
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::SplitPacketSummary;
+		ConsoleLineType GetType() const override { return TYPE; }
+		bool ShouldPrint() const override { return false; }
+		void Print(const PrintArgs& args) const override;
+
+	private:
+		friend class ConsoleLineCoalescer;
+		std::vector<Sequence> m_Sequences;
+		std::string m_Address;  // Of the most recent packet
+	};
+
+	// Every SVCUserMessageLine from one tick, by message type
+	class SVCUserMessageSummaryLine final : public ConsoleLineBase<SVCUserMessageSummaryLine, false>
+	{
+		using BaseClass = ConsoleLineBase;
+
+	public:
+		struct Message
+		{
+			UserMessageType m_Type{};
+			uint32_t m_Count{};
+			uint32_t m_Bytes{};
+		};
+
+		SVCUserMessageSummaryLine(time_point_t timestamp);
+		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+
+		const std::vector<Message>& GetMessages() const { return m_Messages; }
+		const std::string& GetAddress() const { return m_Address; }
+
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::SVCUserMessageSummary;
+		ConsoleLineType GetType() const override { return TYPE; }
+		bool ShouldPrint() const override { return false; }
+		void Print(const PrintArgs& args) const override;
+
+	private:
+		friend class ConsoleLineCoalescer;
+		std::vector<Message> m_Messages;
+		std::string m_Address;  // Of the most recent message
+	};
+
+	struct ConsoleLineCoalescerStats
+	{
+		uint64_t m_LinesCoalesced = 0;
+		uint64_t m_SummariesEmitted = 0;
+	};
+
+	// With voice chat going and net_showmsg on, voice, split packet and svc_UserMessage lines
+	// can show up hundreds of times a second, and nobody cares about them one at a time. This
+	// folds them into one summary line per type per tick (console.log timestamps only have
+	// second resolution, so a tick is a second).
+	//
+	// Types not in the mask go through untouched, and so do user messages that have to be seen
+	// individually (votes). Summaries are handed back before any line that goes through
+	// untouched, once a line from a later tick comes through, or when Flush() is called. They
+	// always come after every line they summarize, and before every line that came after
+	// those. Listeners never see a summary after a line that was printed after it, so a
+	// summary can't land on the wrong side of e.g. a ConnectingLine. The cost is that a tick
+	// with other lines mixed in can get more than one summary of each type.
+	//
+	// Summaries aren't printed, and neither are the lines they replace. The only user messages
+	// that get printed are votes, and those go through untouched.
+	class ConsoleLineCoalescer final
+	{
+	public:
+		static constexpr ConsoleLineTypeMask DEFAULT_TYPES{
+			ConsoleLineType::VoiceReceive,
+			ConsoleLineType::SplitPacket,
+			ConsoleLineType::SVC_UserMessage,
+		};
+
+		ConsoleLineCoalescer(ConsoleLineTypeMask types = DEFAULT_TYPES);
+
+		// Call for every parsed line, in order, before dispatching it. Summaries of the lines
+		// before it that it can't be folded into are passed to emit first. Returns true if the
+		// line was folded into a summary, in which case it should not be dispatched by itself.
+		template<typename TFunc>
+		bool AddLine(const IConsoleLine& line, TFunc&& emit)
+		{
+			if (!m_Pending.empty() && line.GetTimestamp() != m_PendingTimestamp)
+				Flush(emit);
+
+			if (TryCoalesce(line))
+				return true;
+
+			Flush(emit);
+			return false;
+		}
+
+		// Passes any summaries that are still pending to emit
+		template<typename TFunc>
+		void Flush(TFunc&& emit)
+		{
+			for (const std::shared_ptr<IConsoleLine>& summary : m_Pending)
+				emit(*summary);
+
+			m_Stats.m_SummariesEmitted += m_Pending.size();
+			m_Pending.clear();
+			m_Voice.reset();
+			m_SplitPackets.reset();
+			m_UserMessages.reset();
+		}
+
+		bool HasPending() const { return !m_Pending.empty(); }
+		const ConsoleLineCoalescerStats& GetStats() const { return m_Stats; }
+
+	private:
+		bool TryCoalesce(const IConsoleLine& line);
+
+		template<typename T>
+		T& GetOrCreatePending(std::shared_ptr<T>& summary, time_point_t timestamp);
+
+		ConsoleLineTypeMask m_Types;
+		ConsoleLineCoalescerStats m_Stats;
+
+		time_point_t m_PendingTimestamp{};
+		std::vector<std::shared_ptr<IConsoleLine>> m_Pending;  // In the order they were started
+		std::shared_ptr<VoiceReceiveSummaryLine> m_Voice;
+		std::shared_ptr<SplitPacketSummaryLine> m_SplitPackets;
+		std::shared_ptr<SVCUserMessageSummaryLine> m_UserMessages;
+	};
+}
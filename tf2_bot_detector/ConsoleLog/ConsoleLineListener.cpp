@@ -3,37 +3,42 @@
 
 using namespace tf2_bot_detector;
 
-AutoConsoleLineListener::AutoConsoleLineListener(IWorldState& world) :
-	m_World(&world)
+AutoConsoleLineListener::AutoConsoleLineListener(IWorldState& world, ConsoleLineTypeMask interest) :
+	m_World(&world),
+	m_Interest(interest)
 {
-	m_World->AddConsoleLineListener(this);
+	m_World->AddConsoleLineListener(this, m_Interest);
 }
 
 AutoConsoleLineListener::AutoConsoleLineListener(const AutoConsoleLineListener& other) :
-	m_World(other.m_World)
+	m_World(other.m_World),
+	m_Interest(other.m_Interest)
 {
-	m_World->AddConsoleLineListener(this);
+	m_World->AddConsoleLineListener(this, m_Interest);
 }
 
 AutoConsoleLineListener& AutoConsoleLineListener::operator=(const AutoConsoleLineListener& other)
 {
 	m_World->RemoveConsoleLineListener(this);
 	m_World = other.m_World;
-	m_World->AddConsoleLineListener(this);
+	m_Interest = other.m_Interest;
+	m_World->AddConsoleLineListener(this, m_Interest);
 	return *this;
 }
 
 AutoConsoleLineListener::AutoConsoleLineListener(AutoConsoleLineListener&& other) :
-	m_World(other.m_World)
+	m_World(other.m_World),
+	m_Interest(other.m_Interest)
 {
-	m_World->AddConsoleLineListener(this);
+	m_World->AddConsoleLineListener(this, m_Interest);
 }
 
 AutoConsoleLineListener& AutoConsoleLineListener::operator=(AutoConsoleLineListener&& other)
 {
 	m_World->RemoveConsoleLineListener(this);
 	m_World = other.m_World;
-	m_World->AddConsoleLineListener(this);
+	m_Interest = other.m_Interest;
+	m_World->AddConsoleLineListener(this, m_Interest);
 	return *this;
 }
 
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "Clock.h"
+#include "IConsoleLine.h"
 
+#include <cstdint>
+#include <initializer_list>
 #include <string_view>
 
 namespace tf2_bot_detector
@@ -9,6 +12,39 @@ namespace tf2_bot_detector
 	class IConsoleLine;
 	class IWorldState;
 
+	// The ConsoleLineTypes a listener wants OnConsoleLineParsed() for. Lines of any other type
+	// never reach it. OnConsoleLineUnparsed() and OnConsoleLogChunkParsed() always do.
+	class ConsoleLineTypeMask final
+	{
+	public:
+		constexpr ConsoleLineTypeMask() = default;
+		constexpr ConsoleLineTypeMask(std::initializer_list<ConsoleLineType> types)
+		{
+			for (ConsoleLineType type : types)
+				m_Bits |= Bit(type);
+		}
+
+		static constexpr ConsoleLineTypeMask None() { return {}; }
+		static constexpr ConsoleLineTypeMask All()
+		{
+			ConsoleLineTypeMask retVal;
+			retVal.m_Bits = ALL_BITS;
+			return retVal;
+		}
+
+		constexpr bool Contains(ConsoleLineType type) const { return m_Bits & Bit(type); }
+		constexpr bool operator==(const ConsoleLineTypeMask& other) const = default;
+
+	private:
+		static_assert(CONSOLE_LINE_TYPE_COUNT <= 64, "ConsoleLineTypeMask needs more bits");
+		static constexpr uint64_t ALL_BITS = (CONSOLE_LINE_TYPE_COUNT == 64) ?
+			~uint64_t(0) : ((uint64_t(1) << CONSOLE_LINE_TYPE_COUNT) - 1);
+
+		static constexpr uint64_t Bit(ConsoleLineType type) { return uint64_t(1) << size_t(type); }
+
+		uint64_t m_Bits = 0;
+	};
+
 	class IConsoleLineListener
 	{
 	public:
@@ -24,6 +60,13 @@ namespace tf2_bot_detector
 		/// <param name="consoleLinesParsed">True if console lines were parsed from this chunk.
 		/// False if everything ended up going to OnConsoleLineUnparsed().</param>
 		virtual void OnConsoleLogChunkParsed(IWorldState& world, bool consoleLinesParsed) = 0;
+
+		/// <summary>
+		/// Called once everything written to console.log so far has been parsed. Unlike
+		/// OnConsoleLogChunkParsed(), this never happens partway through output that was
+		/// written all at once, even if it was read or dispatched in pieces.
+		/// </summary>
+		virtual void OnConsoleLogCaughtUp(IWorldState& world) = 0;
 	};
 
 	class BaseConsoleLineListener : public IConsoleLineListener
@@ -33,12 +76,13 @@ namespace tf2_bot_detector
 		void OnConsoleLineUnparsed(IWorldState& world, const std::string_view& text) override {}
 
 		void OnConsoleLogChunkParsed(IWorldState& world, bool consoleLinesParsed) override {}
+		void OnConsoleLogCaughtUp(IWorldState& world) override {}
 	};
 
 	class AutoConsoleLineListener : public BaseConsoleLineListener
 	{
 	public:
-		AutoConsoleLineListener(IWorldState& world);
+		AutoConsoleLineListener(IWorldState& world, ConsoleLineTypeMask interest = ConsoleLineTypeMask::All());
 		AutoConsoleLineListener(const AutoConsoleLineListener& other);
 		AutoConsoleLineListener& operator=(const AutoConsoleLineListener& other);
 		AutoConsoleLineListener(AutoConsoleLineListener&& other);
@@ -47,5 +91,6 @@ namespace tf2_bot_detector
 
 	private:
 		IWorldState* m_World = nullptr;
+		ConsoleLineTypeMask m_Interest;
 	};
 }
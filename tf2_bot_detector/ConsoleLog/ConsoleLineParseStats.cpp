@@ -0,0 +1,288 @@
+#include "ConsoleLineParseStats.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <random>
+
+using namespace tf2_bot_detector;
+using namespace std::chrono_literals;
+
+namespace
+{
+	using profiler_clock_t = std::chrono::steady_clock;
+
+	constexpr size_t UNPARSED_SAMPLE_COUNT = 32;
+	constexpr size_t UNPARSED_SAMPLE_MAX_LENGTH = 256;
+
+	// Log-linear histogram of nanoseconds: every power of two is split into 4 buckets, so any
+	// percentile we read back is at most 25% too high.
+	constexpr size_t TIME_BUCKET_SUBDIVISIONS = 4;
+	constexpr size_t TIME_BUCKET_COUNT = 40 * TIME_BUCKET_SUBDIVISIONS; // Up to ~18 minutes
+
+	constexpr size_t GetTimeBucket(uint64_t nanoseconds)
+	{
+		if (nanoseconds < TIME_BUCKET_SUBDIVISIONS)
+			return size_t(nanoseconds);
+
+		const size_t exponent = size_t(std::bit_width(nanoseconds)) - 1;
+		const size_t subdivision = size_t(nanoseconds >> (exponent - 2)) & (TIME_BUCKET_SUBDIVISIONS - 1);
+		return std::min((exponent - 1) * TIME_BUCKET_SUBDIVISIONS + subdivision, TIME_BUCKET_COUNT - 1);
+	}
+
+	// Exclusive upper bound of the values that go in a bucket
+	constexpr uint64_t GetTimeBucketEnd(size_t bucket)
+	{
+		if (bucket < TIME_BUCKET_SUBDIVISIONS)
+			return bucket + 1;
+
+		const size_t exponent = (bucket / TIME_BUCKET_SUBDIVISIONS) + 1;
+		const size_t subdivision = bucket % TIME_BUCKET_SUBDIVISIONS;
+		return uint64_t(TIME_BUCKET_SUBDIVISIONS + subdivision + 1) << (exponent - 2);
+	}
+
+	static_assert(GetTimeBucket(3) == 3);
+	static_assert(GetTimeBucket(4) == 4 && GetTimeBucketEnd(4) == 5);
+	static_assert(GetTimeBucket(7) == 7 && GetTimeBucketEnd(7) == 8);
+	static_assert(GetTimeBucket(8) == 8 && GetTimeBucketEnd(8) == 10);
+	static_assert(GetTimeBucket(1000) == GetTimeBucket(GetTimeBucketEnd(GetTimeBucket(1000)) - 1));
+
+	std::string GetTypeName(const std::type_info& type)
+	{
+		std::string_view name = type.name();
+		if (auto lastNamespace = name.rfind("::"); lastNamespace != name.npos)
+			name.remove_prefix(lastNamespace + 2);
+
+		return std::string(name);
+	}
+
+	int64_t GetNowNanoseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(profiler_clock_t::now().time_since_epoch()).count();
+	}
+}
+
+struct ConsoleLineParseProfiler::TypeCounters
+{
+	explicit TypeCounters(std::string typeName) : m_TypeName(std::move(typeName)) {}
+
+	const std::string m_TypeName;
+	std::atomic<uint64_t> m_Attempts{};
+	std::atomic<uint64_t> m_Hits{};
+	std::atomic<uint64_t> m_TotalNanoseconds{};
+	std::array<std::atomic<uint64_t>, TIME_BUCKET_COUNT> m_TimeHistogram{};
+
+	std::chrono::nanoseconds GetPercentile(double percentile) const
+	{
+		std::array<uint64_t, TIME_BUCKET_COUNT> histogram;
+		uint64_t total = 0;
+		for (size_t i = 0; i < TIME_BUCKET_COUNT; i++)
+			total += histogram[i] = m_TimeHistogram[i].load(std::memory_order_relaxed);
+
+		if (total == 0)
+			return 0ns;
+
+		const auto target = uint64_t(std::ceil(total * percentile));
+		uint64_t cumulative = 0;
+		for (size_t i = 0; i < TIME_BUCKET_COUNT; i++)
+		{
+			cumulative += histogram[i];
+			if (cumulative >= target)
+				return std::chrono::nanoseconds(GetTimeBucketEnd(i));
+		}
+
+		return std::chrono::nanoseconds(GetTimeBucketEnd(TIME_BUCKET_COUNT - 1));
+	}
+};
+
+namespace
+{
+	struct ProfilerState
+	{
+		std::deque<ConsoleLineParseProfiler::TypeCounters> m_Types;
+
+		std::atomic_bool m_TimingEnabled = false;
+		std::atomic<int64_t> m_ResetTime = GetNowNanoseconds();
+		std::atomic<uint64_t> m_Lines{};
+		std::atomic<uint64_t> m_UnparsedLines{};
+		std::atomic<uint64_t> m_Bytes{};
+		std::atomic<uint64_t> m_ParseNanoseconds{};
+
+		std::mutex m_UnparsedSamplesMutex;
+		std::vector<std::string> m_UnparsedSamples;
+	};
+
+	ProfilerState& GetState()
+	{
+		static ProfilerState s_State;
+		return s_State;
+	}
+}
+
+double ConsoleLineParseStats::GetLinesPerSecond() const
+{
+	return m_Elapsed > 0ns ? m_Lines / std::chrono::duration<double>(m_Elapsed).count() : 0;
+}
+
+double ConsoleLineParseStats::GetBytesPerSecond() const
+{
+	return m_Elapsed > 0ns ? m_Bytes / std::chrono::duration<double>(m_Elapsed).count() : 0;
+}
+
+void tf2_bot_detector::to_json(nlohmann::json& j, const ConsoleLineParseStats& d)
+{
+	auto types = nlohmann::json::array();
+	for (const ConsoleLineTypeParseStats& type : d.m_Types)
+	{
+		types.push_back(
+			{
+				{ "type", type.m_TypeName },
+				{ "attempts", type.m_Attempts },
+				{ "hits", type.m_Hits },
+				{ "total_time_ns", type.m_TotalTime.count() },
+				{ "average_time_ns", type.GetAverageTime().count() },
+				{ "p99_time_ns", type.m_P99Time.count() },
+			});
+	}
+
+	j =
+	{
+		{ "lines", d.m_Lines },
+		{ "unparsed_lines", d.m_UnparsedLines },
+		{ "bytes", d.m_Bytes },
+		{ "parse_time_ns", d.m_ParseTime.count() },
+		{ "elapsed_ns", d.m_Elapsed.count() },
+		{ "lines_per_second", d.GetLinesPerSecond() },
+		{ "bytes_per_second", d.GetBytesPerSecond() },
+		{ "types", std::move(types) },
+		{ "unparsed_samples", d.m_UnparsedSamples },
+	};
+}
+
+auto ConsoleLineParseProfiler::RegisterType(const std::type_info& type) -> TypeCounters&
+{
+	return GetState().m_Types.emplace_back(GetTypeName(type));
+}
+
+bool ConsoleLineParseProfiler::IsTimingEnabled()
+{
+	return GetState().m_TimingEnabled.load(std::memory_order_relaxed);
+}
+
+void ConsoleLineParseProfiler::SetTimingEnabled(bool enabled)
+{
+	GetState().m_TimingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void ConsoleLineParseProfiler::RecordAttempt(TypeCounters& counters, bool hit, std::chrono::nanoseconds time)
+{
+	counters.m_Attempts.fetch_add(1, std::memory_order_relaxed);
+	if (hit)
+		counters.m_Hits.fetch_add(1, std::memory_order_relaxed);
+
+	if (time > 0ns)
+	{
+		counters.m_TotalNanoseconds.fetch_add(uint64_t(time.count()), std::memory_order_relaxed);
+		counters.m_TimeHistogram[GetTimeBucket(uint64_t(time.count()))].fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void ConsoleLineParseProfiler::RecordLine(const std::string_view& text, bool parsed, std::chrono::nanoseconds time)
+{
+	ProfilerState& state = GetState();
+	state.m_Lines.fetch_add(1, std::memory_order_relaxed);
+	state.m_Bytes.fetch_add(text.size(), std::memory_order_relaxed);
+	if (time > 0ns)
+		state.m_ParseNanoseconds.fetch_add(uint64_t(time.count()), std::memory_order_relaxed);
+
+	if (parsed)
+		return;
+
+	// Reservoir sampling, so every unparsed line has the same chance of ending up in the
+	// samples no matter how many of them there are
+	const uint64_t unparsedCount = state.m_UnparsedLines.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	size_t replaceIndex = 0;
+	if (unparsedCount > UNPARSED_SAMPLE_COUNT)
+	{
+		thread_local std::mt19937_64 s_Random{ std::random_device{}() };
+		replaceIndex = size_t(std::uniform_int_distribution<uint64_t>(0, unparsedCount - 1)(s_Random));
+		if (replaceIndex >= UNPARSED_SAMPLE_COUNT)
+			return;
+	}
+
+	std::string sample(text.substr(0, UNPARSED_SAMPLE_MAX_LENGTH));
+
+	std::lock_guard lock(state.m_UnparsedSamplesMutex);
+	if (state.m_UnparsedSamples.size() < UNPARSED_SAMPLE_COUNT)
+		state.m_UnparsedSamples.push_back(std::move(sample));
+	else
+		state.m_UnparsedSamples[replaceIndex] = std::move(sample);
+}
+
+ConsoleLineParseStats ConsoleLineParseProfiler::GetStats()
+{
+	ProfilerState& state = GetState();
+
+	ConsoleLineParseStats stats;
+	stats.m_Lines = state.m_Lines.load(std::memory_order_relaxed);
+	stats.m_UnparsedLines = state.m_UnparsedLines.load(std::memory_order_relaxed);
+	stats.m_Bytes = state.m_Bytes.load(std::memory_order_relaxed);
+	stats.m_ParseTime = std::chrono::nanoseconds(state.m_ParseNanoseconds.load(std::memory_order_relaxed));
+	stats.m_Elapsed = std::chrono::nanoseconds(GetNowNanoseconds() - state.m_ResetTime.load(std::memory_order_relaxed));
+
+	for (const TypeCounters& counters : state.m_Types)
+	{
+		ConsoleLineTypeParseStats& type = stats.m_Types.emplace_back();
+		type.m_TypeName = counters.m_TypeName;
+		type.m_Attempts = counters.m_Attempts.load(std::memory_order_relaxed);
+		type.m_Hits = counters.m_Hits.load(std::memory_order_relaxed);
+		type.m_TotalTime = std::chrono::nanoseconds(counters.m_TotalNanoseconds.load(std::memory_order_relaxed));
+		type.m_P99Time = counters.GetPercentile(0.99);
+	}
+
+	std::stable_sort(stats.m_Types.begin(), stats.m_Types.end(),
+		[](const ConsoleLineTypeParseStats& lhs, const ConsoleLineTypeParseStats& rhs)
+		{
+			if (lhs.m_TotalTime != rhs.m_TotalTime)
+				return lhs.m_TotalTime > rhs.m_TotalTime;
+
+			return lhs.m_Attempts > rhs.m_Attempts;
+		});
+
+	{
+		std::lock_guard lock(state.m_UnparsedSamplesMutex);
+		stats.m_UnparsedSamples = state.m_UnparsedSamples;
+	}
+
+	return stats;
+}
+
+void ConsoleLineParseProfiler::Reset()
+{
+	ProfilerState& state = GetState();
+
+	for (TypeCounters& counters : state.m_Types)
+	{
+		counters.m_Attempts.store(0, std::memory_order_relaxed);
+		counters.m_Hits.store(0, std::memory_order_relaxed);
+		counters.m_TotalNanoseconds.store(0, std::memory_order_relaxed);
+		for (auto& bucket : counters.m_TimeHistogram)
+			bucket.store(0, std::memory_order_relaxed);
+	}
+
+	state.m_Lines.store(0, std::memory_order_relaxed);
+	state.m_Bytes.store(0, std::memory_order_relaxed);
+	state.m_ParseNanoseconds.store(0, std::memory_order_relaxed);
+	state.m_ResetTime.store(GetNowNanoseconds(), std::memory_order_relaxed);
+
+	std::lock_guard lock(state.m_UnparsedSamplesMutex);
+	state.m_UnparsedLines.store(0, std::memory_order_relaxed);
+	state.m_UnparsedSamples.clear();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	struct ConsoleLineTypeParseStats
+	{
+		std::string m_TypeName;
+		uint64_t m_Attempts = 0;                 // Calls to TryParse
+		uint64_t m_Hits = 0;                     // Calls to TryParse that returned a line
+		std::chrono::nanoseconds m_TotalTime{};  // Time spent in TryParse, zero if timing was disabled
+		std::chrono::nanoseconds m_P99Time{};    // Upper bound, within 25%
+
+		double GetHitRate() const { return m_Attempts ? double(m_Hits) / m_Attempts : 0; }
+		std::chrono::nanoseconds GetAverageTime() const { return m_Attempts ? m_TotalTime / int64_t(m_Attempts) : m_TotalTime; }
+	};
+
+	struct ConsoleLineParseStats
+	{
+		std::vector<ConsoleLineTypeParseStats> m_Types;   // Most expensive first
+		std::vector<std::string> m_UnparsedSamples;       // Uniform random sample of the lines nothing could parse
+
+		uint64_t m_Lines = 0;
+		uint64_t m_UnparsedLines = 0;
+		uint64_t m_Bytes = 0;
+		std::chrono::nanoseconds m_ParseTime{};   // Time spent in IConsoleLine::ParseConsoleLine(), zero if timing was disabled
+		std::chrono::nanoseconds m_Elapsed{};     // Since the stats were last reset
+
+		double GetLinesPerSecond() const;   // Over m_Elapsed
+		double GetBytesPerSecond() const;   // Over m_Elapsed
+	};
+
+	void to_json(nlohmann::json& j, const ConsoleLineParseStats& d);
+
+	// Thread safe counters for IConsoleLine::ParseConsoleLine(), which is called from the main
+	// thread, the WorldState parsing thread and the bulk parser's worker threads all at once.
+	// Shows which line types dominate parsing cost, and which lines fall through every parser.
+	namespace ConsoleLineParseProfiler
+	{
+		struct TypeCounters;
+
+		// Only called while the line types register themselves during static initialization
+		TypeCounters& RegisterType(const std::type_info& type);
+
+		// Counting attempts is cheap enough to always do. Timing them reads the clock twice per
+		// attempt, so it is off until turned on from the parse stats window (or a replay).
+		bool IsTimingEnabled();
+		void SetTimingEnabled(bool enabled);
+
+		void RecordAttempt(TypeCounters& counters, bool hit, std::chrono::nanoseconds time);
+		void RecordLine(const std::string_view& text, bool parsed, std::chrono::nanoseconds time);
+
+		ConsoleLineParseStats GetStats();
+		void Reset();
+	}
+}
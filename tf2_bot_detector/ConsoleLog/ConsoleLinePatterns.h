@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Util/StaticRegex.h"
+
+// Compile-time equivalents of the std::regex patterns the console line parsers used to use.
+// The original pattern is above each one; Tests/ConsoleLinePatternTests.cpp checks that they
+// still produce identical capture groups.
+namespace tf2_bot_detector::ConsoleLinePatterns
+{
+	using namespace StaticRegex;
+
+	using UInt = Plus<Digit>;
+	using Spaces = Plus<OneOf<" ">>;
+	using Bracketed = Seq<Lit<"[">, Star<Dot>, Lit<"]">>;
+
+	// CTFLobbyShared: ID:([0-9a-f]*)\s+(\d+) member\(s\), (\d+) pending
+	using LobbyHeader = Seq<
+		Lit<"CTFLobbyShared: ID:">, Cap<1, Star<AnyOf<Digit, Range<'a', 'f'>>>>, Plus<Space>,
+		Cap<2, UInt>, Lit<" member(s), ">, Cap<3, UInt>, Lit<" pending">>;
+
+	// \s+(?:(?:Member)|(Pending))\[(\d+)\] (\[.*\])\s+team = (\w+)\s+type = (\w+)
+	using LobbyMember = Seq<
+		Plus<Space>, Alt<Lit<"Member">, Cap<1, Lit<"Pending">>>, Lit<"[">, Cap<2, UInt>, Lit<"] ">,
+		Cap<3, Bracketed>, Plus<Space>, Lit<"team = ">, Cap<4, Plus<Word>>, Plus<Space>, Lit<"type = ">, Cap<5, Plus<Word>>>;
+
+	// #\s+(\d+)\s+"((?:.|[\r\n])+)"\s+(\[.*\])\s+(?:(\d+):)?(\d+):(\d+)\s+(\d+)\s+(\d+)\s+(\w+)(?:\s+(\S+))?
+	using ServerStatusPlayer = Seq<
+		Lit<"#">, Plus<Space>, Cap<1, UInt>, Plus<Space>, Lit<"\"">, Cap<2, Plus<AnyChar>>, Lit<"\"">, Plus<Space>,
+		Cap<3, Bracketed>, Plus<Space>, Opt<Seq<Cap<4, UInt>, Lit<":">>>, Cap<5, UInt>, Lit<":">, Cap<6, UInt>, Plus<Space>,
+		Cap<7, UInt>, Plus<Space>, Cap<8, UInt>, Plus<Space>, Cap<9, Plus<Word>>, Opt<Seq<Plus<Space>, Cap<10, Plus<NotSpace>>>>>;
+
+	// #(\d+) - (.+)
+	using ServerStatusShortPlayer = Seq<Lit<"#">, Cap<1, UInt>, Lit<" - ">, Cap<2, Plus<Dot>>>;
+
+	// (.*) killed (.*) with (.*)\.( \(crit\))?
+	using KillNotification = Seq<
+		Cap<1, Star<Dot>>, Lit<" killed ">, Cap<2, Star<Dot>>, Lit<" with ">, Cap<3, Star<Dot>>, Lit<".">,
+		Opt<Cap<4, Lit<" (crit)">>>>;
+
+	// (\S+)\s+:\s+([-\d.]+)\s+:\s+(.+)?\s+:[\t ]+(.+)?
+	using CvarlistConvar = Seq<
+		Cap<1, Plus<NotSpace>>, Plus<Space>, Lit<":">, Plus<Space>, Cap<2, Plus<OneOf<"-0123456789.">>>,
+		Plus<Space>, Lit<":">, Plus<Space>, Opt<Cap<3, Plus<Dot>>>, Plus<Space>, Lit<":">, Plus<OneOf<"\t ">>,
+		Opt<Cap<4, Plus<Dot>>>>;
+
+	// Voice - chan (\d+), ent (\d+), bufsize: (\d+)
+	using VoiceReceive = Seq<
+		Lit<"Voice - chan ">, Cap<1, UInt>, Lit<", ent ">, Cap<2, UInt>, Lit<", bufsize: ">, Cap<3, UInt>>;
+
+	// players : (\d+) humans, (\d+) bots \((\d+) max\)
+	using ServerStatusPlayerCount = Seq<
+		Lit<"players : ">, Cap<1, UInt>, Lit<" humans, ">, Cap<2, UInt>, Lit<" bots (">, Cap<3, UInt>, Lit<" max)">>;
+
+	// edicts  : (\d+) used of (\d+) max
+	using EdictUsage = Seq<Lit<"edicts  : ">, Cap<1, UInt>, Lit<" used of ">, Cap<2, UInt>, Lit<" max">>;
+
+	//  *(\d+) ms : (.{1,32})
+	using Ping = Seq<Star<OneOf<" ">>, Cap<1, UInt>, Lit<" ms : ">, Cap<2, Repeat<Dot, 1, 32>>>;
+
+	// Msg from ((?:\d+\.\d+\.\d+\.\d+:\d+)|loopback): svc_UserMessage: type (\d+), bytes (\d+)
+	using SVCUserMessage = Seq<
+		Lit<"Msg from ">,
+		Cap<1, Alt<
+			Seq<UInt, Lit<".">, UInt, Lit<".">, UInt, Lit<".">, UInt, Lit<":">, UInt>,
+			Lit<"loopback">>>,
+		Lit<": svc_UserMessage: type ">, Cap<2, UInt>, Lit<", bytes ">, Cap<3, UInt>>;
+
+	// '(.*)' not present; not executing\.
+	using ConfigExecNotPresent = Seq<Lit<"'">, Cap<1, Star<Dot>>, Lit<"' not present; not executing.">>;
+
+	// map     : (.*) at: ((?:-|\d)+) x, ((?:-|\d)+) y, ((?:-|\d)+) z
+	using ServerStatusMap = Seq<
+		Lit<"map     : ">, Cap<1, Star<Dot>>, Lit<" at: ">,
+		Cap<2, Plus<OneOf<"-0123456789">>>, Lit<" x, ">,
+		Cap<3, Plus<OneOf<"-0123456789">>>, Lit<" y, ">,
+		Cap<4, Plus<OneOf<"-0123456789">>>, Lit<" z">>;
+
+	// Connecting to( matchmaking server)? (.*?)(\.\.\.)?
+	using Connecting = Seq<
+		Lit<"Connecting to">, Opt<Cap<1, Lit<" matchmaking server">>>, Lit<" ">, Cap<2, LazyStar<Dot>>,
+		Opt<Cap<3, Lit<"...">>>>;
+
+	// Retrying (.*)\.\.\.
+	using Retrying = Seq<Lit<"Retrying ">, Cap<1, Star<Dot>>, Lit<"...">>;
+
+	// TFParty:\s+ID:([0-9a-f]+)\s+(\d+) member\(s\)\s+LeaderID: (\[.*\])
+	using PartyHeader = Seq<
+		Lit<"TFParty:">, Plus<Space>, Lit<"ID:">, Cap<1, Plus<AnyOf<Digit, Range<'a', 'f'>>>>, Plus<Space>,
+		Cap<2, UInt>, Lit<" member(s)">, Plus<Space>, Lit<"LeaderID: ">, Cap<3, Bracketed>>;
+
+	//     MatchGroup: (\d+)\s+Started matchmaking:\s+(.*)\s+\(\d+ seconds ago, now is (.*)\)
+	using InQueue = Seq<
+		Lit<"    MatchGroup: ">, Cap<1, UInt>, Plus<Space>, Lit<"Started matchmaking:">, Plus<Space>,
+		Cap<2, Star<Dot>>, Plus<Space>, Lit<"(">, UInt, Lit<" seconds ago, now is ">, Cap<3, Star<Dot>>, Lit<")">>;
+
+	// \n(.*)\nMap: (.*)\nPlayers: (\d+) \/ (\d+)\nBuild: (\d+)\nServer Number: (\d+)\s+
+	using ServerJoin = Seq<
+		Lit<"\n">, Cap<1, Star<Dot>>, Lit<"\nMap: ">, Cap<2, Star<Dot>>,
+		Lit<"\nPlayers: ">, Cap<3, UInt>, Lit<" / ">, Cap<4, UInt>,
+		Lit<"\nBuild: ">, Cap<5, UInt>, Lit<"\nServer Number: ">, Cap<6, UInt>, Plus<Space>>;
+
+	// Dropped (.*) from server \((.*)\)
+	using ServerDroppedPlayer = Seq<Lit<"Dropped ">, Cap<1, Star<Dot>>, Lit<" from server (">, Cap<2, Star<Dot>>, Lit<")">>;
+
+	// udp\/ip  : (.*)  \(public ip: (.*)\)
+	using ServerStatusPlayerIP = Seq<Lit<"udp/ip  : ">, Cap<1, Star<Dot>>, Lit<"  (public ip: ">, Cap<2, Star<Dot>>, Lit<")">>;
+
+	// Differing lobby received\. Lobby: (.*)\/Match(\d+)\/Lobby(\d+) CurrentlyAssigned: (.*)\/Match(\d+)\/Lobby(\d+)
+	//   ConnectedToMatchServer: (\d+) HasLobby: (\d+) AssignedMatchEnded: (\d+)
+	using DifferingLobbyReceived = Seq<
+		Lit<"Differing lobby received. Lobby: ">, Cap<1, Star<Dot>>, Lit<"/Match">, Cap<2, UInt>, Lit<"/Lobby">, Cap<3, UInt>,
+		Lit<" CurrentlyAssigned: ">, Cap<4, Star<Dot>>, Lit<"/Match">, Cap<5, UInt>, Lit<"/Lobby">, Cap<6, UInt>,
+		Lit<" ConnectedToMatchServer: ">, Cap<7, UInt>, Lit<" HasLobby: ">, Cap<8, UInt>,
+		Lit<" AssignedMatchEnded: ">, Cap<9, UInt>>;
+
+	// (?:(casual)|(?:ranked))_banned_time: (\d+)
+	using MatchmakingBannedTime = Seq<Alt<Cap<1, Lit<"casual">>, Lit<"ranked">>, Lit<"_banned_time: ">, Cap<2, UInt>>;
+
+	// <-- \[(.{3})\] Split packet +(\d+)\/ +(\d+) seq +(\d+) size +(\d+) mtu +(\d+) from ([0-9.:a-fA-F]+:\d+)
+	using SplitPacket = Seq<
+		Lit<"<-- [">, Cap<1, Repeat<Dot, 3, 3>>, Lit<"] Split packet">, Spaces, Cap<2, UInt>, Lit<"/">, Spaces, Cap<3, UInt>,
+		Lit<" seq">, Spaces, Cap<4, UInt>, Lit<" size">, Spaces, Cap<5, UInt>, Lit<" mtu">, Spaces, Cap<6, UInt>,
+		Lit<" from ">, Cap<7, Seq<Plus<AnyOf<Digit, OneOf<".:">, Range<'a', 'f'>, Range<'A', 'F'>>>, Lit<":">, UInt>>>;
+
+	// - Config: (.*), (.*), (\d+) connections
+	using NetStatusConfig = Seq<
+		Lit<"- Config: ">, Cap<1, Star<Dot>>, Lit<", ">, Cap<2, Star<Dot>>, Lit<", ">, Cap<3, UInt>, Lit<" connections">>;
+
+	// \d+\.\d+
+	using Decimal = Seq<UInt, Lit<".">, UInt>;
+	// \d+\.\d
+	using Decimal1 = Seq<UInt, Lit<".">, Repeat<Digit, 1, 1>>;
+
+	// <prefix>(<decimal>)<middle>(<decimal>)<suffix>, the shape of all the net_channel/net_status float lines
+	template<FixedString TPrefix, FixedString TMiddle, FixedString TSuffix, typename TDecimal = Decimal>
+	using DualFloat = Seq<Lit<TPrefix>, Cap<1, TDecimal>, Lit<TMiddle>, Cap<2, TDecimal>, Lit<TSuffix>>;
+
+	// - latency: (\d+\.\d+), loss (\d+\.\d+)
+	using NetChannelLatencyLoss = DualFloat<"- latency: ", ", loss ", "">;
+	// - packets: in (\d+\.\d+)\/s, out (\d+\.\d+)\/s
+	using NetChannelPackets = DualFloat<"- packets: in ", "/s, out ", "/s">;
+	// - choke: in (\d+\.\d+), out (\d+\.\d+)
+	using NetChannelChoke = DualFloat<"- choke: in ", ", out ", "">;
+	// - flow: in (\d+\.\d+), out (\d+\.\d+) kB\/s
+	using NetChannelFlow = DualFloat<"- flow: in ", ", out ", " kB/s">;
+	// - total: in (\d+\.\d+), out (\d+\.\d+) MB
+	using NetChannelTotal = DualFloat<"- total: in ", ", out ", " MB">;
+	// - Latency: avg out (\d+\.\d+)s, in (\d+\.\d+)s
+	using NetLatency = DualFloat<"- Latency: avg out ", "s, in ", "s">;
+	// - Loss:    avg out (\d+\.\d+), in (\d+\.\d+)
+	using NetLoss = DualFloat<"- Loss:    avg out ", ", in ", "">;
+	// - Packets: net total out  (\d+\.\d)\/s, in (\d+\.\d)\/s
+	using NetPacketsTotal = DualFloat<"- Packets: net total out  ", "/s, in ", "/s", Decimal1>;
+	//            per client out (\d+\.\d)\/s, in (\d+\.\d)\/s
+	using NetPacketsPerClient = DualFloat<"           per client out ", "/s, in ", "/s", Decimal1>;
+	// - Data:    net total out  (\d+\.\d), in (\d+\.\d) kB\/s
+	using NetDataTotal = DualFloat<"- Data:    net total out  ", ", in ", " kB/s", Decimal1>;
+	//            per client out (\d+\.\d), in (\d+\.\d) kB\/s
+	using NetDataPerClient = DualFloat<"           per client out ", ", in ", " kB/s", Decimal1>;
+}
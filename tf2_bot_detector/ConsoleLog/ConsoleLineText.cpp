@@ -0,0 +1,50 @@
+#include "ConsoleLineText.h"
+
+#include <algorithm>
+#include <ostream>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	// Retained text only points into a slab if it is at least this fraction of it, see
+	// ConsoleLineText(). Otherwise a 30 byte chat message could keep a 64 KiB read alive for
+	// as long as the chat log shows it.
+	constexpr size_t RETAINED_SLAB_SHARE = 4;
+}
+
+ConsoleLineText::ConsoleLineText(const std::string_view& text) :
+	m_Size(text.size())
+{
+	if (text.empty())
+		return;
+
+	// Control block and characters in one allocation, however long the text is
+	auto copy = std::make_shared<char[]>(text.size());
+	std::copy(text.begin(), text.end(), copy.get());
+	const char* data = copy.get();
+	m_Data = std::shared_ptr<const char>(std::move(copy), data);
+}
+
+ConsoleLineText::ConsoleLineText(const std::string_view& text, const ConsoleTextSlab* slab, bool retained)
+{
+	if (slab && *slab && !text.empty())
+	{
+		const std::string& slabText = **slab;
+		const bool inSlab = (text.data() >= slabText.data()) && (text.data() + text.size() <= slabText.data() + slabText.size());
+
+		if (inSlab && (!retained || text.size() * RETAINED_SLAB_SHARE >= slabText.capacity()))
+		{
+			m_Data = std::shared_ptr<const char>(*slab, text.data());
+			m_Size = text.size();
+			return;
+		}
+	}
+
+	*this = ConsoleLineText(text);
+}
+
+std::ostream& tf2_bot_detector::operator<<(std::ostream& os, const ConsoleLineText& text)
+{
+	return os << text.view();
+}
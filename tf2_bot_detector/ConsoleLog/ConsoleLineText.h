@@ -0,0 +1,46 @@
+#pragma once
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace tf2_bot_detector
+{
+	// A block of console log text that parsed lines can point into. The owner (ConsoleLogParser)
+	// only ever writes to it while it holds the only reference, so as far as the lines are
+	// concerned it is immutable.
+	using ConsoleTextSlab = std::shared_ptr<std::string>;
+
+	// Text belonging to a parsed console line. If the text lives in a ConsoleTextSlab, this is
+	// just a view plus a reference that keeps the slab alive until the last line using it goes
+	// away. Otherwise, the text is copied into a single allocation of its own (not a std::string,
+	// which would need a second one for anything past its small string buffer).
+	class ConsoleLineText final
+	{
+	public:
+		ConsoleLineText() = default;
+		explicit ConsoleLineText(const std::string_view& text);
+
+		// Lines that are kept around after they have been dispatched (anything that ShouldPrint())
+		// should pass retained = true. Retained text is copied unless it makes up a good part of
+		// the slab, so a handful of old lines can't pin down whole reads.
+		ConsoleLineText(const std::string_view& text, const ConsoleTextSlab* slab, bool retained = false);
+
+		std::string_view view() const { return std::string_view(m_Data.get(), m_Size); }
+		operator std::string_view() const { return view(); }
+		std::string str() const { return std::string(view()); }
+
+		const char* data() const { return m_Data.get(); }
+		size_t size() const { return m_Size; }
+		bool empty() const { return m_Size == 0; }
+
+		bool operator==(const std::string_view& other) const { return view() == other; }
+
+	private:
+		std::shared_ptr<const char> m_Data;
+		size_t m_Size = 0;
+	};
+
+	std::ostream& operator<<(std::ostream& os, const ConsoleLineText& text);
+}
@@ -1,4 +1,5 @@
 #include "ConsoleLines.h"
+#include "ConsoleLinePatterns.h"
 #include "Application.h"
 #include "Config/Settings.h"
 #include "GameData/MatchmakingQueue.h"
@@ -9,14 +10,15 @@
 #include "Log.h"
 #include "WorldState.h"
 
-#include <mh/algorithm/multi_compare.hpp>
 #include <mh/text/charconv_helper.hpp>
 #include <mh/text/fmtstr.hpp>
 #include <mh/text/format.hpp>
 #include <mh/text/string_insertion.hpp>
 #include <imgui_desktop/ScopeGuards.h>
 
-#include <regex>
+#include <algorithm>
+#include <array>
+#include <bitset>
 #include <sstream>
 #include <stdexcept>
 
@@ -27,29 +29,26 @@ using namespace std::chrono_literals;
 using namespace std::string_literals;
 using namespace std::string_view_literals;
 
-GenericConsoleLine::GenericConsoleLine(time_point_t timestamp, std::string text) :
+GenericConsoleLine::GenericConsoleLine(time_point_t timestamp, ConsoleLineText text) :
 	BaseClass(timestamp), m_Text(std::move(text))
 {
-	m_Text.shrink_to_fit();
 }
 
 std::shared_ptr<IConsoleLine> GenericConsoleLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	return std::make_shared<GenericConsoleLine>(args.m_Timestamp, std::string(args.m_Text));
+	return std::make_shared<GenericConsoleLine>(args.m_Timestamp, ConsoleLineText(args.m_Text, args.m_TextSlab));
 }
 
 void GenericConsoleLine::Print(const PrintArgs& args) const
 {
-	ImGui::TextFmt(m_Text);
+	ImGui::TextFmt(m_Text.view());
 }
 
-ChatConsoleLine::ChatConsoleLine(time_point_t timestamp, std::string playerName, std::string message,
+ChatConsoleLine::ChatConsoleLine(time_point_t timestamp, ConsoleLineText playerName, ConsoleLineText message,
 	bool isDead, bool isTeam, bool isSelf, TeamShareResult teamShareResult, SteamID id) :
 	ConsoleLineBase(timestamp), m_PlayerName(std::move(playerName)), m_Message(std::move(message)),
 	m_IsDead(isDead), m_IsTeam(isTeam), m_IsSelf(isSelf), m_TeamShareResult(teamShareResult), m_PlayerSteamID(id)
 {
-	m_PlayerName.shrink_to_fit();
-	m_Message.shrink_to_fit();
 }
 
 // this is a bad fix, but we can't really access PlayerExtraData (+ the fact that they will be destroyed when the player leave will screw over a lot of stuff)
@@ -204,11 +203,12 @@ void ChatConsoleLine::Print(const PrintArgs& args) const
 			ImGui::SetClipboardText(fullText.c_str());
 		}
 
-		tf2_bot_detector::DrawPlayerContextCopyMenu(m_PlayerName.c_str(), m_PlayerSteamID);
+		const std::string playerName = m_PlayerName.str();
+		tf2_bot_detector::DrawPlayerContextCopyMenu(playerName.c_str(), m_PlayerSteamID);
 		tf2_bot_detector::DrawPlayerContextGoToMenu(args.m_Settings, m_PlayerSteamID);
 
 		if (m_PlayerSteamID.IsValid()) {
-			args.m_MainWindow.DrawPlayerContextMarkMenu(m_PlayerSteamID, m_PlayerName, m_PendingMarkReason);
+			args.m_MainWindow.DrawPlayerContextMarkMenu(m_PlayerSteamID, playerName, m_PendingMarkReason);
 		}
 		else {
 			ImGui::TextFmt(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "Marking Unavailable");
@@ -230,9 +230,7 @@ LobbyHeaderLine::LobbyHeaderLine(time_point_t timestamp, unsigned memberCount, u
 
 std::shared_ptr<IConsoleLine> LobbyHeaderLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(CTFLobbyShared: ID:([0-9a-f]*)\s+(\d+) member\(s\), (\d+) pending)regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<3> result; StaticRegex::FullMatch<ConsoleLinePatterns::LobbyHeader>(args.m_Text, result))
 	{
 		unsigned memberCount, pendingCount;
 		if (!mh::from_chars(std::string_view(&*result[2].first, result[2].length()), memberCount))
@@ -259,9 +257,7 @@ LobbyMemberLine::LobbyMemberLine(time_point_t timestamp, const LobbyMember& lobb
 
 std::shared_ptr<IConsoleLine> LobbyMemberLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(\s+(?:(?:Member)|(Pending))\[(\d+)\] (\[.*\])\s+team = (\w+)\s+type = (\w+))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<5> result; StaticRegex::FullMatch<ConsoleLinePatterns::LobbyMember>(args.m_Text, result))
 	{
 		LobbyMember member{};
 		member.m_Pending = result[1].matched;
@@ -316,55 +312,228 @@ IConsoleLine::IConsoleLine(time_point_t timestamp) :
 {
 }
 
+namespace
+{
+	using parse_clock_t = std::chrono::steady_clock;
+}
+
+struct IConsoleLine::DispatchTable
+{
+	struct Candidate
+	{
+		const ConsoleLineParseHint* m_Hint = nullptr;
+		ConsoleLineTypeData* m_Data = nullptr;
+	};
+
+	// Prefix hints, keyed by the first character of the hint
+	std::array<std::vector<Candidate>, 256> m_Prefix;
+	// TrimmedPrefix hints, keyed by the first character of the hint
+	std::array<std::vector<Candidate>, 256> m_TrimmedPrefix;
+	std::vector<Candidate> m_Contains;
+	std::vector<ConsoleLineTypeData*> m_Unhinted;
+
+	// Which ConsoleLineTypes have been registered, TryParseConsoleLine tells candidates apart by it
+	std::bitset<CONSOLE_LINE_TYPE_COUNT> m_RegisteredTypes;
+
+	// Static initialization order isn't defined across (or even within, for templates)
+	// translation units. Keep every list sorted by ConsoleLineType so the order candidates
+	// are tried in is the same in every build.
+	static void Insert(std::vector<Candidate>& list, const Candidate& candidate)
+	{
+		list.insert(std::upper_bound(list.begin(), list.end(), candidate,
+			[](const Candidate& lhs, const Candidate& rhs) { return lhs.m_Data->m_Type < rhs.m_Data->m_Type; }),
+			candidate);
+	}
+	static void Insert(std::vector<ConsoleLineTypeData*>& list, ConsoleLineTypeData* data)
+	{
+		list.insert(std::upper_bound(list.begin(), list.end(), data,
+			[](const ConsoleLineTypeData* lhs, const ConsoleLineTypeData* rhs) { return lhs->m_Type < rhs->m_Type; }),
+			data);
+	}
+
+	void Add(ConsoleLineTypeData& data)
+	{
+		if (!data.m_AutoParse)
+			return;
+
+		assert(size_t(data.m_Type) < CONSOLE_LINE_TYPE_COUNT);
+		if (m_RegisteredTypes.test(size_t(data.m_Type)))
+		{
+			LogError("{} uses the same ConsoleLineType ({}) as another line type, it will never be parsed",
+				data.m_TypeInfo->name(), int(data.m_Type));
+			assert(!"Duplicate ConsoleLineType");
+			return;
+		}
+
+		m_RegisteredTypes.set(size_t(data.m_Type));
+
+		if (data.m_ParseHints.empty())
+		{
+			Insert(m_Unhinted, &data);
+			return;
+		}
+
+		for (const ConsoleLineParseHint& hint : data.m_ParseHints)
+		{
+			assert(!hint.m_Text.empty());
+			const Candidate candidate{ &hint, &data };
+
+			switch (hint.m_Type)
+			{
+			case ConsoleLineParseHint::Type::Prefix:
+				Insert(m_Prefix[uint8_t(hint.m_Text.front())], candidate);
+				break;
+			case ConsoleLineParseHint::Type::TrimmedPrefix:
+				Insert(m_TrimmedPrefix[uint8_t(hint.m_Text.front())], candidate);
+				break;
+			case ConsoleLineParseHint::Type::Contains:
+				Insert(m_Contains, candidate);
+				break;
+
+			default:
+				LogError("Unknown ConsoleLineParseHint::Type {} for {}", int(hint.m_Type), data.m_TypeInfo->name());
+				Insert(m_Unhinted, &data);
+				break;
+			}
+		}
+	}
+};
+
 auto IConsoleLine::GetTypeData() -> std::list<ConsoleLineTypeData>&
 {
 	static std::list<ConsoleLineTypeData> s_List;
 	return s_List;
 }
 
-std::shared_ptr<IConsoleLine> IConsoleLine::ParseConsoleLine(const std::string_view& text, time_point_t timestamp, IWorldState& world)
+auto IConsoleLine::GetDispatchTable() -> DispatchTable&
 {
-	auto& list = GetTypeData();
+	static DispatchTable s_Table;
+	return s_Table;
+}
 
-	if ((s_TotalParseCount % 1024) == 0)
-	{
-		// Periodically re-sort the line types for best performance
-		list.sort([](ConsoleLineTypeData& lhs, ConsoleLineTypeData& rhs)
-			{
-				if (rhs.m_AutoParse != lhs.m_AutoParse)
-					return rhs.m_AutoParse < lhs.m_AutoParse;
+std::shared_ptr<IConsoleLine> IConsoleLine::ParseConsoleLine(const std::string_view& text, time_point_t timestamp, IWorldState& world,
+	const ConsoleTextSlab* textSlab)
+{
+	return ParseConsoleLine(text, timestamp, world, textSlab, nullptr);
+}
 
-				// Intentionally reversed, we want descending order
-				return rhs.m_AutoParseSuccessCount < lhs.m_AutoParseSuccessCount;
-			});
+std::shared_ptr<IConsoleLine> IConsoleLine::ParseConsoleLineStateless(const std::string_view& text,
+	time_point_t timestamp, IWorldState& world, bool& needsWorldState, const ConsoleTextSlab* textSlab)
+{
+	needsWorldState = false;
+	return ParseConsoleLine(text, timestamp, world, textSlab, &needsWorldState);
+}
+
+std::shared_ptr<IConsoleLine> IConsoleLine::ParseConsoleLine(const std::string_view& text, time_point_t timestamp,
+	IWorldState& world, const ConsoleTextSlab* textSlab, bool* needsWorldState)
+{
+	if (text.empty())
+		return nullptr;
+
+	const bool timingEnabled = ConsoleLineParseProfiler::IsTimingEnabled();
+	const auto parseStartTime = timingEnabled ? parse_clock_t::now() : parse_clock_t::time_point{};
+
+	auto parsed = TryParseConsoleLine(ConsoleLineTryParseArgs{ text, timestamp, world, textSlab }, needsWorldState, timingEnabled);
+
+	// Lines handed back to the main thread haven't been parsed yet, they'll be counted when they are
+	if (!needsWorldState || !*needsWorldState)
+	{
+		ConsoleLineParseProfiler::RecordLine(text, !!parsed,
+			timingEnabled ? parse_clock_t::now() - parseStartTime : parse_clock_t::duration{});
 	}
 
-	s_TotalParseCount++;
+	return parsed;
+}
+
+std::shared_ptr<IConsoleLine> IConsoleLine::TryParseConsoleLine(const ConsoleLineTryParseArgs& args,
+	bool* needsWorldState, bool timingEnabled)
+{
+	const std::string_view& text = args.m_Text;
+	const DispatchTable& table = GetDispatchTable();
+
+	// A line type may have more than one hint that passes for the same line, only try it once.
+	// Every line type has its own ConsoleLineType (checked in DispatchTable::Add), so this can
+	// hold every candidate there is.
+	std::bitset<CONSOLE_LINE_TYPE_COUNT> attempted;
 
-	const ConsoleLineTryParseArgs args{ text, timestamp, world };
-	for (auto& data : list)
+	const auto tryParse = [&](ConsoleLineTypeData& data) -> std::shared_ptr<IConsoleLine>
 	{
-		if (!data.m_AutoParse)
-			continue;
+		if (attempted.test(size_t(data.m_Type)))
+			return nullptr;
 
-		auto parsed = data.m_TryParseFunc(args);
-		if (!parsed)
-			continue;
+		attempted.set(size_t(data.m_Type));
 
-		data.m_AutoParseSuccessCount++;
+		if (needsWorldState && data.m_UsesWorldState)
+		{
+			*needsWorldState = true;
+			return nullptr;
+		}
+
+		if (!timingEnabled)
+		{
+			auto parsed = data.m_TryParseFunc(args);
+			ConsoleLineParseProfiler::RecordAttempt(*data.m_Counters, !!parsed, 0ns);
+			return parsed;
+		}
+
+		const auto startTime = parse_clock_t::now();
+		auto parsed = data.m_TryParseFunc(args);
+		ConsoleLineParseProfiler::RecordAttempt(*data.m_Counters, !!parsed, parse_clock_t::now() - startTime);
 		return parsed;
+	};
+
+	// Stop at the first successful parse, or once we know this has to wait for the main thread
+	const auto isDone = [&](const std::shared_ptr<IConsoleLine>& parsed)
+	{
+		return parsed || (needsWorldState && *needsWorldState);
+	};
+
+	for (const auto& candidate : table.m_Prefix[uint8_t(text.front())])
+	{
+		if (text.starts_with(candidate.m_Hint->m_Text))
+		{
+			if (auto parsed = tryParse(*candidate.m_Data); isDone(parsed))
+				return parsed;
+		}
 	}
 
-	//if (auto chatLine = ChatConsoleLine::TryParse(text, timestamp))
-	//	return chatLine;
+	if (const auto trimmedStart = text.find_first_not_of(" \t\r\n\v\f"); trimmedStart != text.npos)
+	{
+		const auto trimmed = text.substr(trimmedStart);
+		for (const auto& candidate : table.m_TrimmedPrefix[uint8_t(trimmed.front())])
+		{
+			if (trimmed.starts_with(candidate.m_Hint->m_Text))
+			{
+				if (auto parsed = tryParse(*candidate.m_Data); isDone(parsed))
+					return parsed;
+			}
+		}
+	}
+
+	for (const auto& candidate : table.m_Contains)
+	{
+		if (text.find(candidate.m_Hint->m_Text) != text.npos)
+		{
+			if (auto parsed = tryParse(*candidate.m_Data); isDone(parsed))
+				return parsed;
+		}
+	}
+
+	for (ConsoleLineTypeData* data : table.m_Unhinted)
+	{
+		if (auto parsed = tryParse(*data); isDone(parsed))
+			return parsed;
+	}
 
 	return nullptr;
-	//return std::make_shared<GenericConsoleLine>(timestamp, std::string(text));
 }
 
 void IConsoleLine::AddTypeData(ConsoleLineTypeData data)
 {
-	GetTypeData().push_back(std::move(data));
+	auto& list = GetTypeData();
+	data.m_Counters = &ConsoleLineParseProfiler::RegisterType(*data.m_TypeInfo);
+	list.push_back(std::move(data));
+	GetDispatchTable().Add(list.back());
 }
 
 ServerStatusPlayerLine::ServerStatusPlayerLine(time_point_t timestamp, PlayerStatus playerStatus) :
@@ -374,9 +543,7 @@ ServerStatusPlayerLine::ServerStatusPlayerLine(time_point_t timestamp, PlayerSta
 
 std::shared_ptr<IConsoleLine> ServerStatusPlayerLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(#\s+(\d+)\s+"((?:.|[\r\n])+)"\s+(\[.*\])\s+(?:(\d+):)?(\d+):(\d+)\s+(\d+)\s+(\d+)\s+(\w+)(?:\s+(\S+))?)regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<10> result; StaticRegex::FullMatch<ConsoleLinePatterns::ServerStatusPlayer>(args.m_Text, result))
 	{
 		PlayerStatus status{};
 
@@ -465,9 +632,7 @@ KillNotificationLine::KillNotificationLine(time_point_t timestamp, std::string a
 
 std::shared_ptr<IConsoleLine> KillNotificationLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex((.*) killed (.*) with (.*)\.( \(crit\))?)regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<4> result; StaticRegex::FullMatch<ConsoleLinePatterns::KillNotification>(args.m_Text, result))
 	{
 		auto attacker = args.m_World.FindSteamIDForName(result[1].str());
 		auto victim = args.m_World.FindSteamIDForName(result[2].str());
@@ -591,8 +756,7 @@ CvarlistConvarLine::CvarlistConvarLine(time_point_t timestamp, std::string name,
 
 std::shared_ptr<IConsoleLine> CvarlistConvarLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex((\S+)\s+:\s+([-\d.]+)\s+:\s+(.+)?\s+:[\t ]+(.+)?)regex", std::regex::optimize);
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<4> result; StaticRegex::FullMatch<ConsoleLinePatterns::CvarlistConvar>(args.m_Text, result))
 	{
 		float value;
 		from_chars_throw(result[2], value);
@@ -615,9 +779,7 @@ ServerStatusShortPlayerLine::ServerStatusShortPlayerLine(time_point_t timestamp,
 
 std::shared_ptr<IConsoleLine> ServerStatusShortPlayerLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(#(\d+) - (.+))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<2> result; StaticRegex::FullMatch<ConsoleLinePatterns::ServerStatusShortPlayer>(args.m_Text, result))
 	{
 		PlayerStatusShort status{};
 
@@ -644,9 +806,7 @@ VoiceReceiveLine::VoiceReceiveLine(time_point_t timestamp, uint8_t channel,
 
 std::shared_ptr<IConsoleLine> VoiceReceiveLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(Voice - chan (\d+), ent (\d+), bufsize: (\d+))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<3> result; StaticRegex::FullMatch<ConsoleLinePatterns::VoiceReceive>(args.m_Text, result))
 	{
 		uint8_t channel;
 		from_chars_throw(result[1], channel);
@@ -676,9 +836,7 @@ ServerStatusPlayerCountLine::ServerStatusPlayerCountLine(time_point_t timestamp,
 
 std::shared_ptr<IConsoleLine> ServerStatusPlayerCountLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(players : (\d+) humans, (\d+) bots \((\d+) max\))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<3> result; StaticRegex::FullMatch<ConsoleLinePatterns::ServerStatusPlayerCount>(args.m_Text, result))
 	{
 		uint8_t playerCount, botCount, maxPlayers;
 		from_chars_throw(result[1], playerCount);
@@ -702,9 +860,7 @@ EdictUsageLine::EdictUsageLine(time_point_t timestamp, uint16_t usedEdicts, uint
 
 std::shared_ptr<IConsoleLine> EdictUsageLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(edicts  : (\d+) used of (\d+) max)regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<2> result; StaticRegex::FullMatch<ConsoleLinePatterns::EdictUsage>(args.m_Text, result))
 	{
 		uint16_t usedEdicts, totalEdicts;
 		from_chars_throw(result[1], usedEdicts);
@@ -727,9 +883,7 @@ PingLine::PingLine(time_point_t timestamp, uint16_t ping, std::string playerName
 
 std::shared_ptr<IConsoleLine> PingLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex( *(\d+) ms : (.{1,32}))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<2> result; StaticRegex::FullMatch<ConsoleLinePatterns::Ping>(args.m_Text, result))
 	{
 		uint16_t ping;
 		from_chars_throw(result[1], ping);
@@ -751,9 +905,7 @@ SVCUserMessageLine::SVCUserMessageLine(time_point_t timestamp, std::string addre
 
 std::shared_ptr<IConsoleLine> SVCUserMessageLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(Msg from ((?:\d+\.\d+\.\d+\.\d+:\d+)|loopback): svc_UserMessage: type (\d+), bytes (\d+))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<3> result; StaticRegex::FullMatch<ConsoleLinePatterns::SVCUserMessage>(args.m_Text, result))
 	{
 		uint16_t type, bytes;
 		from_chars_throw(result[2], type);
@@ -769,12 +921,7 @@ std::shared_ptr<IConsoleLine> SVCUserMessageLine::TryParse(const ConsoleLineTryP
 bool SVCUserMessageLine::IsSpecial(UserMessageType type)
 {
 #ifdef _DEBUG
-	return mh::any_eq(type,
-		UserMessageType::CallVoteFailed,
-		UserMessageType::VoteFailed,
-		UserMessageType::VotePass,
-		UserMessageType::VoteSetup,
-		UserMessageType::VoteStart);
+	return IsVoteUserMessage(type);
 #else
 	return false;
 #endif
@@ -819,8 +966,7 @@ std::shared_ptr<IConsoleLine> ConfigExecLine::TryParse(const ConsoleLineTryParse
 		return std::make_shared<ConfigExecLine>(args.m_Timestamp, std::string(args.m_Text.substr(prefix.size())), true);
 
 	// Failure
-	static const std::regex s_Regex(R"regex('(.*)' not present; not executing\.)regex", std::regex::optimize);
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<1> result; StaticRegex::FullMatch<ConsoleLinePatterns::ConfigExecNotPresent>(args.m_Text, result))
 		return std::make_shared<ConfigExecLine>(args.m_Timestamp, result[1].str(), false);
 
 	return nullptr;
@@ -842,9 +988,7 @@ ServerStatusMapLine::ServerStatusMapLine(time_point_t timestamp, std::string map
 
 std::shared_ptr<IConsoleLine> ServerStatusMapLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(map     : (.*) at: ((?:-|\d)+) x, ((?:-|\d)+) y, ((?:-|\d)+) z)regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<4> result; StaticRegex::FullMatch<ConsoleLinePatterns::ServerStatusMap>(args.m_Text, result))
 	{
 		std::array<float, 3> pos{};
 		from_chars_throw(result[2], pos[0]);
@@ -866,7 +1010,7 @@ void ServerStatusMapLine::Print(const PrintArgs& args) const
 std::shared_ptr<IConsoleLine> TeamsSwitchedLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
 	if (args.m_Text == "Teams have been switched."sv)
-		return std::make_unique<TeamsSwitchedLine>(args.m_Timestamp);
+		return std::make_shared<TeamsSwitchedLine>(args.m_Timestamp);
 
 	return nullptr;
 }
@@ -893,14 +1037,12 @@ ConnectingLine::ConnectingLine(time_point_t timestamp, std::string address, bool
 std::shared_ptr<IConsoleLine> ConnectingLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
 	{
-		static const std::regex s_ConnectingRegex(R"regex(Connecting to( matchmaking server)? (.*?)(\.\.\.)?)regex", std::regex::optimize);
-		if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_ConnectingRegex))
+		if (StaticRegex::Groups<3> result; StaticRegex::FullMatch<ConsoleLinePatterns::Connecting>(args.m_Text, result))
 			return std::make_shared<ConnectingLine>(args.m_Timestamp, result[2].str(), result[1].matched, false);
 	}
 
 	{
-		static const std::regex s_RetryingRegex(R"regex(Retrying (.*)\.\.\.)regex", std::regex::optimize);
-		if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_RetryingRegex))
+		if (StaticRegex::Groups<1> result; StaticRegex::FullMatch<ConsoleLinePatterns::Retrying>(args.m_Text, result))
 			return std::make_shared<ConnectingLine>(args.m_Timestamp, result[1].str(), false, true);
 	}
 
@@ -937,8 +1079,7 @@ PartyHeaderLine::PartyHeaderLine(time_point_t timestamp, TFParty party) :
 
 std::shared_ptr<IConsoleLine> PartyHeaderLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(TFParty:\s+ID:([0-9a-f]+)\s+(\d+) member\(s\)\s+LeaderID: (\[.*\]))regex", std::regex::optimize);
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<3> result; StaticRegex::FullMatch<ConsoleLinePatterns::PartyHeader>(args.m_Text, result))
 	{
 		TFParty party{};
 
@@ -1037,11 +1178,7 @@ InQueueLine::InQueueLine(time_point_t timestamp, TFMatchGroup queueType, time_po
 
 std::shared_ptr<IConsoleLine> InQueueLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(
-		R"regex(    MatchGroup: (\d+)\s+Started matchmaking:\s+(.*)\s+\(\d+ seconds ago, now is (.*)\))regex",
-		std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<3> result; StaticRegex::FullMatch<ConsoleLinePatterns::InQueue>(args.m_Text, result))
 	{
 		TFMatchGroup matchGroup = TFMatchGroup::Invalid;
 		{
@@ -1098,11 +1235,7 @@ ServerJoinLine::ServerJoinLine(time_point_t timestamp, std::string hostName, std
 
 std::shared_ptr<IConsoleLine> ServerJoinLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(
-		R"regex(\n(.*)\nMap: (.*)\nPlayers: (\d+) \/ (\d+)\nBuild: (\d+)\nServer Number: (\d+)\s+)regex",
-		std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<6> result; StaticRegex::FullMatch<ConsoleLinePatterns::ServerJoin>(args.m_Text, result))
 	{
 		uint32_t buildNumber, serverNumber;
 		from_chars_throw(result[5], buildNumber);
@@ -1125,18 +1258,17 @@ void ServerJoinLine::Print(const PrintArgs& args) const
 		m_HostName, m_MapName, m_PlayerCount, m_PlayerMaxCount, m_BuildNumber, m_ServerNumber);
 }
 
-ServerDroppedPlayerLine::ServerDroppedPlayerLine(time_point_t timestamp, std::string playerName, std::string reason) :
+ServerDroppedPlayerLine::ServerDroppedPlayerLine(time_point_t timestamp, ConsoleLineText playerName, ConsoleLineText reason) :
 	BaseClass(timestamp), m_PlayerName(std::move(playerName)), m_Reason(std::move(reason))
 {
 }
 
 std::shared_ptr<IConsoleLine> ServerDroppedPlayerLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(Dropped (.*) from server \((.*)\))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<2> result; StaticRegex::FullMatch<ConsoleLinePatterns::ServerDroppedPlayer>(args.m_Text, result))
 	{
-		return std::make_shared<ServerDroppedPlayerLine>(args.m_Timestamp, result[1].str(), result[2].str());
+		return std::make_shared<ServerDroppedPlayerLine>(args.m_Timestamp,
+			ConsoleLineText(to_string_view(result[1]), args.m_TextSlab), ConsoleLineText(to_string_view(result[2]), args.m_TextSlab));
 	}
 
 	return nullptr;
@@ -1144,7 +1276,7 @@ std::shared_ptr<IConsoleLine> ServerDroppedPlayerLine::TryParse(const ConsoleLin
 
 void ServerDroppedPlayerLine::Print(const PrintArgs& args) const
 {
-	ImGui::TextFmt("Dropped {} from server ({})", m_PlayerName, m_Reason);
+	ImGui::TextFmt("Dropped {} from server ({})", m_PlayerName.view(), m_Reason.view());
 }
 
 ServerStatusPlayerIPLine::ServerStatusPlayerIPLine(time_point_t timestamp, std::string localIP, std::string publicIP) :
@@ -1154,9 +1286,7 @@ ServerStatusPlayerIPLine::ServerStatusPlayerIPLine(time_point_t timestamp, std::
 
 std::shared_ptr<IConsoleLine> ServerStatusPlayerIPLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(udp\/ip  : (.*)  \(public ip: (.*)\))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<2> result; StaticRegex::FullMatch<ConsoleLinePatterns::ServerStatusPlayerIP>(args.m_Text, result))
 		return std::make_shared<ServerStatusPlayerIPLine>(args.m_Timestamp, result[1].str(), result[2].str());
 
 	return nullptr;
@@ -1176,11 +1306,7 @@ DifferingLobbyReceivedLine::DifferingLobbyReceivedLine(time_point_t timestamp, c
 
 std::shared_ptr<IConsoleLine> DifferingLobbyReceivedLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(
-		R"regex(Differing lobby received\. Lobby: (.*)\/Match(\d+)\/Lobby(\d+) CurrentlyAssigned: (.*)\/Match(\d+)\/Lobby(\d+) ConnectedToMatchServer: (\d+) HasLobby: (\d+) AssignedMatchEnded: (\d+))regex",
-		std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<9> result; StaticRegex::FullMatch<ConsoleLinePatterns::DifferingLobbyReceived>(args.m_Text, result))
 	{
 		Lobby newLobby;
 		newLobby.m_LobbyID = SteamID(result[1].str());
@@ -1262,9 +1388,7 @@ MatchmakingBannedTimeLine::MatchmakingBannedTimeLine(time_point_t timestamp, Lad
 
 std::shared_ptr<IConsoleLine> MatchmakingBannedTimeLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex((?:(casual)|(?:ranked))_banned_time: (\d+))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<2> result; StaticRegex::FullMatch<ConsoleLinePatterns::MatchmakingBannedTime>(args.m_Text, result))
 	{
 		const LadderType ladderType = result[1].matched ? LadderType::Casual : LadderType::Competitive;
 
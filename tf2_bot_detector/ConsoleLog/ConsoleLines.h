@@ -26,15 +26,16 @@ namespace tf2_bot_detector
 		using BaseClass = ConsoleLineBase;
 
 	public:
-		GenericConsoleLine(time_point_t timestamp, std::string text);
+		GenericConsoleLine(time_point_t timestamp, ConsoleLineText text);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::Generic; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::Generic;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
 	private:
-		std::string m_Text;
+		ConsoleLineText m_Text;
 	};
 
 	class ChatConsoleLine final : public ConsoleLineBase<ChatConsoleLine, false>
@@ -42,16 +43,17 @@ namespace tf2_bot_detector
 		using BaseClass = ConsoleLineBase;
 
 	public:
-		ChatConsoleLine(time_point_t timestamp, std::string playerName, std::string message, bool isDead,
+		ChatConsoleLine(time_point_t timestamp, ConsoleLineText playerName, ConsoleLineText message, bool isDead,
 			bool isTeam, bool isSelf, TeamShareResult teamShare, SteamID id);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
 		//static std::shared_ptr<ChatConsoleLine> TryParseFlexible(const std::string_view& text, time_point_t timestamp);
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::Chat; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::Chat;
+		ConsoleLineType GetType() const override { return TYPE; }
 		void Print(const PrintArgs& args) const override;
 
-		const std::string& GetPlayerName() const { return m_PlayerName; }
-		const std::string& GetMessage() const { return m_Message; }
+		std::string_view GetPlayerName() const { return m_PlayerName; }
+		std::string_view GetMessage() const { return m_Message; }
 		const SteamID getSteamID() const { return m_PlayerSteamID; }
 		bool IsDead() const { return m_IsDead; }
 		bool IsTeam() const { return m_IsTeam; }
@@ -61,8 +63,8 @@ namespace tf2_bot_detector
 	private:
 		//static std::shared_ptr<ChatConsoleLine> TryParse(const std::string_view& text, time_point_t timestamp, bool flexible);
 
-		std::string m_PlayerName;
-		std::string m_Message;
+		ConsoleLineText m_PlayerName;
+		ConsoleLineText m_Message;
 		SteamID m_PlayerSteamID;
 		TeamShareResult m_TeamShareResult;
 		bool m_IsDead : 1;
@@ -80,8 +82,10 @@ namespace tf2_bot_detector
 	public:
 		using ConsoleLineBase::ConsoleLineBase;
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("Failed to find lobby shared object") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::LobbyStatusFailed; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::LobbyStatusFailed;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 	};
@@ -93,10 +97,12 @@ namespace tf2_bot_detector
 	public:
 		PartyHeaderLine(time_point_t timestamp, TFParty party);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("TFParty:") };
 
 		const TFParty& GetParty() const { return m_Party; }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::PartyHeader; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::PartyHeader;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -111,11 +117,13 @@ namespace tf2_bot_detector
 	public:
 		LobbyHeaderLine(time_point_t timestamp, unsigned memberCount, unsigned pendingCount);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("CTFLobbyShared:") };
 
 		auto GetMemberCount() const { return m_MemberCount; }
 		auto GetPendingCount() const { return m_PendingCount; }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::LobbyHeader; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::LobbyHeader;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -131,10 +139,16 @@ namespace tf2_bot_detector
 	public:
 		LobbyMemberLine(time_point_t timestamp, const LobbyMember& lobbyMember);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] =
+		{
+			ConsoleLineParseHint::TrimmedPrefix("Member["),
+			ConsoleLineParseHint::TrimmedPrefix("Pending["),
+		};
 
 		const LobbyMember& GetLobbyMember() const { return m_LobbyMember; }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::LobbyMember; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::LobbyMember;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -156,8 +170,10 @@ namespace tf2_bot_detector
 	public:
 		LobbyChangedLine(time_point_t timestamp, LobbyChangeType type);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("Lobby ") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::LobbyChanged; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::LobbyChanged;
+		ConsoleLineType GetType() const override { return TYPE; }
 		LobbyChangeType GetChangeType() const { return m_ChangeType; }
 		bool ShouldPrint() const override;
 		void Print(const PrintArgs& args) const override;
@@ -181,8 +197,10 @@ namespace tf2_bot_detector
 		DifferingLobbyReceivedLine(time_point_t timestamp, const Lobby& newLobby, const Lobby& currentLobby,
 			bool connectedToMatchServer, bool hasLobby, bool assignedMatchEnded);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("Differing lobby received.") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::DifferingLobbyReceived; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::DifferingLobbyReceived;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -207,10 +225,12 @@ namespace tf2_bot_detector
 	public:
 		ServerStatusPlayerLine(time_point_t timestamp, PlayerStatus playerStatus);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("#") };
 
 		const PlayerStatus& GetPlayerStatus() const { return m_PlayerStatus; }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::PlayerStatus; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::PlayerStatus;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -225,8 +245,10 @@ namespace tf2_bot_detector
 	public:
 		ServerStatusPlayerIPLine(time_point_t timestamp, std::string localIP, std::string publicIP);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("udp/ip  : ") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::PlayerStatusIP; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::PlayerStatusIP;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -245,10 +267,12 @@ namespace tf2_bot_detector
 	public:
 		ServerStatusShortPlayerLine(time_point_t timestamp, PlayerStatusShort playerStatus);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("#") };
 
 		const PlayerStatusShort& GetPlayerStatus() const { return m_PlayerStatus; }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::PlayerStatusShort; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::PlayerStatusShort;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -264,12 +288,14 @@ namespace tf2_bot_detector
 		ServerStatusPlayerCountLine(time_point_t timestamp, uint8_t playerCount,
 			uint8_t botCount, uint8_t maxPlayers);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("players : ") };
 
 		uint8_t GetPlayerCount() const { return m_PlayerCount; }
 		uint8_t GetBotCount() const { return m_BotCount; }
 		uint8_t GetMaxPlayerCount() const { return m_MaxPlayers; }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::PlayerStatusCount; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::PlayerStatusCount;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -286,11 +312,13 @@ namespace tf2_bot_detector
 	public:
 		ServerStatusMapLine(time_point_t timestamp, std::string mapName, const std::array<float, 3>& position);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("map     : ") };
 
 		const std::string& GetMapName() const { return m_MapName; }
 		const std::array<float, 3>& GetPosition() const { return m_Position; }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::PlayerStatusMapPosition; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::PlayerStatusMapPosition;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -306,11 +334,13 @@ namespace tf2_bot_detector
 	public:
 		EdictUsageLine(time_point_t timestamp, uint16_t usedEdicts, uint16_t totalEdicts);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("edicts  : ") };
 
 		uint16_t GetUsedEdicts() const { return m_UsedEdicts; }
 		uint16_t GetTotalEdicts() const { return m_TotalEdicts; }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::EdictUsage; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::EdictUsage;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -326,8 +356,10 @@ namespace tf2_bot_detector
 	public:
 		using ConsoleLineBase::ConsoleLineBase;
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("Client reached server_spawn.") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::ClientReachedServerSpawn; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::ClientReachedServerSpawn;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 	};
@@ -342,6 +374,8 @@ namespace tf2_bot_detector
 		KillNotificationLine(time_point_t timestamp, std::string attackerName, SteamID attacker,
 			std::string victimName, SteamID victim, std::string weaponName, bool wasCrit);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Contains(" killed ") };
+		static constexpr bool PARSE_USES_WORLD_STATE = true;
 
 		const std::string& GetVictimName() const { return m_VictimName; }
 		const SteamID GetVictim() const { return m_Victim; }
@@ -350,7 +384,8 @@ namespace tf2_bot_detector
 		const std::string& GetWeaponName() const { return m_WeaponName; }
 		bool WasCrit() const { return m_WasCrit; }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::KillNotification; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::KillNotification;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return true; }
 		void Print(const PrintArgs& args) const override;
 
@@ -370,13 +405,15 @@ namespace tf2_bot_detector
 	public:
 		CvarlistConvarLine(time_point_t timestamp, std::string name, float value, std::string flagsList, std::string helpText);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Contains(" : ") };
 
 		const std::string& GetConvarName() const { return m_Name; }
 		float GetConvarValue() const { return m_Value; }
 		const std::string& GetFlagsListString() const { return m_FlagsList; }
 		const std::string& GetHelpText() const { return m_HelpText; }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::CvarlistConvar; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::CvarlistConvar;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -394,10 +431,14 @@ namespace tf2_bot_detector
 	public:
 		VoiceReceiveLine(time_point_t timestamp, uint8_t channel, uint8_t entindex, uint16_t bufSize);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("Voice - chan ") };
 
+		uint8_t GetChannel() const { return m_Channel; }
 		uint8_t GetEntIndex() const { return m_Entindex; }
+		uint16_t GetBufSize() const { return m_BufSize; }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::VoiceReceive; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::VoiceReceive;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -414,8 +455,10 @@ namespace tf2_bot_detector
 	public:
 		PingLine(time_point_t timestamp, uint16_t ping, std::string playerName);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Contains(" ms : ") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::Ping; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::Ping;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -434,8 +477,10 @@ namespace tf2_bot_detector
 	public:
 		SVCUserMessageLine(time_point_t timestamp, std::string address, UserMessageType type, uint16_t bytes);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("Msg from ") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::SVC_UserMessage; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::SVC_UserMessage;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override;
 		void Print(const PrintArgs& args) const override;
 
@@ -458,8 +503,14 @@ namespace tf2_bot_detector
 	public:
 		ConfigExecLine(time_point_t timestamp, std::string configFileName, bool success);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] =
+		{
+			ConsoleLineParseHint::Prefix("execing "),
+			ConsoleLineParseHint::Prefix("'"),
+		};
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::ConfigExec; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::ConfigExec;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -478,8 +529,10 @@ namespace tf2_bot_detector
 	public:
 		TeamsSwitchedLine(time_point_t timestamp) : BaseClass(timestamp) {}
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("Teams have been switched.") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::TeamsSwitched; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::TeamsSwitched;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override;
 		void Print(const PrintArgs& args) const override;
 
@@ -498,8 +551,14 @@ namespace tf2_bot_detector
 	public:
 		ConnectingLine(time_point_t timestamp, std::string address, bool isMatchmaking, bool isRetrying);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] =
+		{
+			ConsoleLineParseHint::Prefix("Connecting to"),
+			ConsoleLineParseHint::Prefix("Retrying "),
+		};
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::Connecting; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::Connecting;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -518,8 +577,10 @@ namespace tf2_bot_detector
 	public:
 		HostNewGameLine(time_point_t timestamp) : BaseClass(timestamp) {}
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("---- Host_NewGame ----") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::HostNewGame; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::HostNewGame;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 	};
@@ -531,8 +592,10 @@ namespace tf2_bot_detector
 	public:
 		GameQuitLine(time_point_t timestamp) : BaseClass(timestamp) {}
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("CTFGCClientSystem::ShutdownGC") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::GameQuit; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::GameQuit;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 	};
@@ -544,8 +607,10 @@ namespace tf2_bot_detector
 	public:
 		QueueStateChangeLine(time_point_t timestamp, TFMatchGroup queueType, TFQueueStateChange stateChange);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("[PartyClient] ") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::QueueStateChange; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::QueueStateChange;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -564,8 +629,10 @@ namespace tf2_bot_detector
 	public:
 		InQueueLine(time_point_t timestamp, TFMatchGroup queueType, time_point_t queueStartTime);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("    MatchGroup: ") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::InQueue; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::InQueue;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -585,8 +652,10 @@ namespace tf2_bot_detector
 		ServerJoinLine(time_point_t timestamp, std::string hostName, std::string mapName,
 			uint8_t playerCount, uint8_t playerMaxCount, uint32_t buildNumber, uint32_t serverNumber);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("\n") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::ServerJoin; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::ServerJoin;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -611,19 +680,21 @@ namespace tf2_bot_detector
 		using BaseClass = ConsoleLineBase;
 
 	public:
-		ServerDroppedPlayerLine(time_point_t timestamp, std::string playerName, std::string reason);
+		ServerDroppedPlayerLine(time_point_t timestamp, ConsoleLineText playerName, ConsoleLineText reason);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("Dropped ") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::ServerDroppedPlayer; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::ServerDroppedPlayer;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
-		const std::string& GetPlayerName() const { return m_PlayerName; }
-		const std::string& GetReason() const { return m_Reason; }
+		std::string_view GetPlayerName() const { return m_PlayerName; }
+		std::string_view GetReason() const { return m_Reason; }
 
 	private:
-		std::string m_PlayerName;
-		std::string m_Reason;
+		ConsoleLineText m_PlayerName;
+		ConsoleLineText m_Reason;
 	};
 
 	class MatchmakingBannedTimeLine final : public ConsoleLineBase<MatchmakingBannedTimeLine>
@@ -639,8 +710,14 @@ namespace tf2_bot_detector
 
 		MatchmakingBannedTimeLine(time_point_t timestamp, LadderType ladderType, uint64_t bannedTime);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] =
+		{
+			ConsoleLineParseHint::Prefix("casual_banned_time: "),
+			ConsoleLineParseHint::Prefix("ranked_banned_time: "),
+		};
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::MatchmakingBannedTime; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::MatchmakingBannedTime;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -0,0 +1,152 @@
+#include "ConsoleLogBulkParser.h"
+#include "ConsoleLogTimestamps.h"
+#include "IConsoleLine.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <thread>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	// Enough segments per thread that a thread that gets stuck with a slow one (a huge status
+	// dump, say) doesn't hold everyone else up at the end
+	constexpr size_t SEGMENTS_PER_THREAD = 8;
+	constexpr size_t MIN_SEGMENT_SIZE = 64 * 1024;
+
+	struct Segment
+	{
+		size_t m_Begin{};   // Offset of the segment's first timestamp
+		size_t m_End{};     // Offset of the next segment's first timestamp, or the end of the log
+
+		std::vector<PreparsedConsoleLine> m_Lines;
+		size_t m_ParsedLineCount = 0;
+		size_t m_DeferredLineCount = 0;
+	};
+
+	std::vector<Segment> SplitSegments(const std::string_view& log, size_t targetCount)
+	{
+		std::vector<Segment> segments;
+
+		// Anything before the first timestamp doesn't belong to a line we can timestamp, which
+		// is the same thing ConsoleLogParser does with it
+		auto first = FindConsoleLogTimestamp(log);
+		if (!first)
+			return segments;
+
+		const size_t targetSize = std::max((log.size() - first->m_Begin) / targetCount, MIN_SEGMENT_SIZE);
+
+		size_t begin = first->m_Begin;
+		while (begin < log.size())
+		{
+			size_t end = log.size();
+			if (auto next = FindConsoleLogTimestamp(log, std::min(begin + targetSize, log.size())))
+				end = next->m_Begin;
+
+			segments.push_back({ begin, end });
+			begin = end;
+		}
+
+		return segments;
+	}
+
+	void ParseSegment(const std::string_view& log, Segment& segment, IWorldState& world)
+	{
+		const auto segmentText = log.substr(0, segment.m_End);
+
+		ConsoleLogTimestampDecoder timestampDecoder;
+		auto match = FindConsoleLogTimestamp(segmentText, segment.m_Begin);
+		while (match)
+		{
+			const auto next = FindConsoleLogTimestamp(segmentText, match->m_End);
+
+			auto lineText = segmentText.substr(match->m_End, (next ? next->m_Begin : segmentText.size()) - match->m_End);
+			if (!next && segment.m_End == log.size() && lineText.ends_with('\n'))
+				lineText.remove_suffix(1); // The very last line doesn't have the next timestamp's '\n' after it
+
+			PreparsedConsoleLine& line = segment.m_Lines.emplace_back();
+			line.m_Timestamp = timestampDecoder.ToTimePoint(*match);
+			line.m_Text = lineText;
+
+			try
+			{
+				line.m_Parsed = IConsoleLine::ParseConsoleLineStateless(lineText, line.m_Timestamp, world, line.m_NeedsWorldState);
+			}
+			catch (...)
+			{
+				LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to parse console line {}", std::quoted(lineText));
+			}
+
+			if (line.m_Parsed)
+				segment.m_ParsedLineCount++;
+			else if (line.m_NeedsWorldState)
+				segment.m_DeferredLineCount++;
+
+			match = next;
+		}
+	}
+}
+
+std::vector<PreparsedConsoleLine> tf2_bot_detector::ParseConsoleLogParallel(const std::string_view& log,
+	IWorldState& world, unsigned threadCount, ConsoleLogBulkParseStats* stats)
+{
+	const auto startTime = std::chrono::steady_clock::now();
+
+	if (threadCount == 0)
+		threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+	std::vector<Segment> segments = SplitSegments(log, threadCount * SEGMENTS_PER_THREAD);
+	threadCount = unsigned(std::clamp<size_t>(segments.size(), 1, threadCount));
+
+	// Segments are handed out one at a time as threads finish their previous one, so the
+	// work balances itself out no matter how uneven the segments turn out to be.
+	std::atomic<size_t> nextSegment = 0;
+	const auto ThreadFunc = [&]
+	{
+		for (size_t i = nextSegment++; i < segments.size(); i = nextSegment++)
+			ParseSegment(log, segments[i], world);
+	};
+
+	{
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount - 1);
+		for (unsigned i = 1; i < threadCount; i++)
+			threads.emplace_back(ThreadFunc);
+
+		ThreadFunc();
+
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	// Segments are in log order, and so are the lines within them
+	size_t lineCount = 0;
+	for (const auto& segment : segments)
+		lineCount += segment.m_Lines.size();
+
+	std::vector<PreparsedConsoleLine> lines;
+	lines.reserve(lineCount);
+	for (auto& segment : segments)
+		std::move(segment.m_Lines.begin(), segment.m_Lines.end(), std::back_inserter(lines));
+
+	if (stats)
+	{
+		stats->m_ThreadCount = threadCount;
+		stats->m_SegmentCount = segments.size();
+		stats->m_LineCount = lines.size();
+		stats->m_ParsedLineCount = 0;
+		stats->m_DeferredLineCount = 0;
+		for (const auto& segment : segments)
+		{
+			stats->m_ParsedLineCount += segment.m_ParsedLineCount;
+			stats->m_DeferredLineCount += segment.m_DeferredLineCount;
+		}
+
+		stats->m_ParseTime = std::chrono::duration_cast<duration_t>(std::chrono::steady_clock::now() - startTime);
+	}
+
+	return lines;
+}
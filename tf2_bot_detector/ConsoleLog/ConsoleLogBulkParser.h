@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	class IConsoleLine;
+	class IWorldState;
+
+	// A line of an archived console log that was parsed ahead of time, see ParseConsoleLogParallel().
+	struct PreparsedConsoleLine
+	{
+		time_point_t m_Timestamp{};
+		std::string_view m_Text;
+		std::shared_ptr<IConsoleLine> m_Parsed;
+
+		// m_Parsed is empty because this line has to be parsed in order, against the real world state
+		bool m_NeedsWorldState = false;
+	};
+
+	struct ConsoleLogBulkParseStats
+	{
+		unsigned m_ThreadCount = 0;
+		size_t m_SegmentCount = 0;
+		size_t m_LineCount = 0;
+		size_t m_ParsedLineCount = 0;
+		size_t m_DeferredLineCount = 0;    // Lines that needed the world state
+		duration_t m_ParseTime{};
+	};
+
+	// Splits a complete console log (for example, one of the console output logs we save in
+	// the logs folder) into independent segments at timestamp boundaries, parses the segments on
+	// threadCount worker threads (0 = one per core), and returns every line in the order it
+	// appears in the log. Line types that depend on the world state are left for the caller to
+	// parse in order, see ConsoleLogParser::FeedPreparsed(). world is never touched.
+	//
+	// The returned lines point into log, which must outlive them.
+	std::vector<PreparsedConsoleLine> ParseConsoleLogParallel(const std::string_view& log, IWorldState& world,
+		unsigned threadCount = 0, ConsoleLogBulkParseStats* stats = nullptr);
+}
@@ -0,0 +1,209 @@
+#include "ConsoleLogCheckpoint.h"
+#include "ConsoleLogTimestamps.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/stat.h>
+#endif
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	constexpr size_t SCAN_BLOCK_SIZE = 64 * 1024;
+
+	// Longer than a timestamp, so one that begins right before the end of a block is still
+	// seen in full
+	constexpr size_t SCAN_BLOCK_OVERLAP = 32;
+
+	bool ReadAt(FILE* file, uint64_t offset, size_t size, std::string& buf)
+	{
+		buf.clear();
+		if (!SeekFile(file, offset))
+			return false;
+
+		buf.resize(size);
+		buf.resize(fread(buf.data(), sizeof(char), size, file));
+		return !ferror(file);
+	}
+
+	// FNV-1a
+	uint64_t HashBytes(const std::string_view& bytes)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : bytes)
+		{
+			hash ^= uint8_t(c);
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	int64_t ToSeconds(time_point_t time)
+	{
+		return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+	}
+}
+
+bool tf2_bot_detector::SeekFile(FILE* file, uint64_t offset)
+{
+#ifdef _WIN32
+	return _fseeki64(file, int64_t(offset), SEEK_SET) == 0;
+#else
+	return fseeko(file, off_t(offset), SEEK_SET) == 0;
+#endif
+}
+
+std::optional<uint64_t> tf2_bot_detector::TellFile(FILE* file)
+{
+#ifdef _WIN32
+	const int64_t pos = _ftelli64(file);
+#else
+	const int64_t pos = ftello(file);
+#endif
+
+	if (pos < 0)
+		return std::nullopt;
+
+	return uint64_t(pos);
+}
+
+std::optional<uint64_t> tf2_bot_detector::GetOpenFileSize(FILE* file)
+{
+#ifdef _WIN32
+	const int64_t size = _filelengthi64(_fileno(file));
+	if (size < 0)
+		return std::nullopt;
+
+	return uint64_t(size);
+#else
+	struct stat info{};
+	if (fstat(fileno(file), &info) != 0)
+		return std::nullopt;
+
+	return uint64_t(info.st_size);
+#endif
+}
+
+void tf2_bot_detector::to_json(nlohmann::json& j, const ConsoleLogCheckpoint& d)
+{
+	j = nlohmann::json
+	{
+		{ "head_hash", d.m_Head.m_Hash },
+		{ "head_size", d.m_Head.m_Size },
+		{ "offset", d.m_Offset },
+		{ "timestamp", ToSeconds(d.m_Timestamp) },
+	};
+}
+
+void tf2_bot_detector::from_json(const nlohmann::json& j, ConsoleLogCheckpoint& d)
+{
+	d.m_Head.m_Hash = j.at("head_hash");
+	d.m_Head.m_Size = j.at("head_size");
+	d.m_Offset = j.at("offset");
+	d.m_Timestamp = time_point_t(std::chrono::seconds(j.at("timestamp").get<int64_t>()));
+}
+
+std::optional<ConsoleLogFileHead> tf2_bot_detector::ReadConsoleLogHead(FILE* file, uint64_t maxSize)
+{
+	std::string buf;
+	if (!ReadAt(file, 0, size_t(std::min<uint64_t>(maxSize, ConsoleLogFileHead::MAX_SIZE)), buf))
+		return std::nullopt;
+
+	ConsoleLogFileHead head;
+	head.m_Hash = HashBytes(buf);
+	head.m_Size = buf.size();
+	return head;
+}
+
+bool tf2_bot_detector::IsConsoleLogCheckpointValid(FILE* file, uint64_t fileSize, const ConsoleLogCheckpoint& checkpoint)
+{
+	if (checkpoint.m_Head.m_Size == 0 || checkpoint.m_Offset >= fileSize)
+		return false;
+
+	if (const auto head = ReadConsoleLogHead(file, checkpoint.m_Head.m_Size); !head || *head != checkpoint.m_Head)
+		return false;
+
+	std::string buf;
+	if (!ReadAt(file, checkpoint.m_Offset, SCAN_BLOCK_OVERLAP, buf))
+		return false;
+
+	const auto timestamp = FindConsoleLogTimestamp(buf);
+	return timestamp && timestamp->m_Begin == 0 &&
+		ToSeconds(timestamp->ToTimePoint()) == ToSeconds(checkpoint.m_Timestamp);
+}
+
+uint64_t tf2_bot_detector::FindConsoleLogWindowStart(FILE* file, uint64_t fileSize, duration_t window, uint64_t maxScanBytes)
+{
+	ConsoleLogTimestampDecoder decoder;
+	std::optional<time_point_t> cutoff;
+	uint64_t windowStart = fileSize;   // Oldest line found so far that is within the window
+	std::string block;
+
+	uint64_t blockEnd = fileSize;
+	while (blockEnd > 0)
+	{
+		if ((fileSize - blockEnd) >= maxScanBytes)
+			return windowStart < fileSize ? windowStart : blockEnd;
+
+		const uint64_t blockBegin = blockEnd - std::min<uint64_t>(blockEnd, SCAN_BLOCK_SIZE);
+		const size_t blockSize = size_t(blockEnd - blockBegin);
+		if (!ReadAt(file, blockBegin, blockSize + SCAN_BLOCK_OVERLAP, block))
+			return windowStart < fileSize ? windowStart : 0;
+
+		// Only timestamps that begin before blockEnd belong to this block, the rest were
+		// already looked at as part of the one after it
+		const auto nextInBlock = [&](size_t offset)
+		{
+			auto timestamp = FindConsoleLogTimestamp(block, offset);
+			if (timestamp && timestamp->m_Begin >= blockSize)
+				timestamp.reset();
+
+			return timestamp;
+		};
+
+		const auto first = nextInBlock(0);
+		if (!first)
+		{
+			blockEnd = blockBegin;
+			continue;
+		}
+
+		if (!cutoff)
+		{
+			// This is the newest line in the file, the window is relative to it
+			auto last = *first;
+			while (auto next = nextInBlock(last.m_End))
+				last = *next;
+
+			cutoff = decoder.ToTimePoint(last) - window;
+		}
+
+		if (decoder.ToTimePoint(*first) >= *cutoff)
+		{
+			windowStart = blockBegin + first->m_Begin;
+			blockEnd = blockBegin;
+			continue;
+		}
+
+		// The window starts somewhere in this block
+		for (auto timestamp = nextInBlock(first->m_End); timestamp; timestamp = nextInBlock(timestamp->m_End))
+		{
+			if (decoder.ToTimePoint(*timestamp) >= *cutoff)
+				return blockBegin + timestamp->m_Begin;
+		}
+
+		return windowStart;
+	}
+
+	// The whole file is within the window
+	return 0;
+}
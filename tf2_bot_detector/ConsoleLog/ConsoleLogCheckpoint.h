@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+
+namespace tf2_bot_detector
+{
+	// Identifies one instance of console.log. tf2 starts the file over when it launches (unless
+	// it is told to append), and the first bytes it writes begin with the launch time, so a hash
+	// of them tells the current file apart from any earlier one at the same path.
+	struct ConsoleLogFileHead
+	{
+		static constexpr size_t MAX_SIZE = 4096;
+
+		uint64_t m_Hash = 0;
+		uint64_t m_Size = 0;   // Bytes that went into m_Hash, less than MAX_SIZE if the file was still shorter
+
+		bool operator==(const ConsoleLogFileHead&) const = default;
+	};
+
+	// How far into console.log we got, so that if we start up while tf2 still has the file
+	// open (and it can't be truncated), we can pick up where we left off.
+	struct ConsoleLogCheckpoint
+	{
+		ConsoleLogFileHead m_Head;
+		uint64_t m_Offset = 0;       // Start of the first line that wasn't handed to the world yet (its timestamp's '\n')
+		time_point_t m_Timestamp{};  // Timestamp of the line at m_Offset
+	};
+
+	void to_json(nlohmann::json& j, const ConsoleLogCheckpoint& d);
+	void from_json(const nlohmann::json& j, ConsoleLogCheckpoint& d);
+
+	// fseek/ftell with 64 bit offsets. long is only 32 bits on Windows, so the standard ones
+	// can't get past 2 GiB there, and console.log can easily be bigger than that.
+	bool SeekFile(FILE* file, uint64_t offset);
+	std::optional<uint64_t> TellFile(FILE* file);  // nullopt if the position couldn't be determined
+
+	// Size of an open file, straight from its handle. Cheap enough to call every poll, and
+	// unlike directory change notifications, it is up to date even while another process
+	// is writing to the file through the cache.
+	std::optional<uint64_t> GetOpenFileSize(FILE* file);
+
+	// All of these leave the file position wherever they finished reading.
+
+	// Hashes up to maxSize bytes from the start of the file.
+	std::optional<ConsoleLogFileHead> ReadConsoleLogHead(FILE* file, uint64_t maxSize = ConsoleLogFileHead::MAX_SIZE);
+
+	// True if checkpoint was taken from this file: the head matches (or is a prefix of what
+	// is there now, if the file was still short), and the line at the checkpoint's offset
+	// has the timestamp we recorded for it.
+	bool IsConsoleLogCheckpointValid(FILE* file, uint64_t fileSize, const ConsoleLogCheckpoint& checkpoint);
+
+	// Scans backwards from the end of the file, and returns the offset of the first line that
+	// was written no more than window before the last one. Lines are only ever appended, so
+	// this reads roughly window's worth of the log regardless of how big the file is. Gives up
+	// after maxScanBytes, returning the oldest line it did find within the window (or where it
+	// stopped, if it didn't find any timestamps at all).
+	uint64_t FindConsoleLogWindowStart(FILE* file, uint64_t fileSize, duration_t window, uint64_t maxScanBytes);
+}
@@ -1,23 +1,99 @@
 #include "ConsoleLogParser.h"
-#include "Config/ChatWrappers.h"
+#include "ConsoleLogBulkParser.h"
+#include "Config/ChatWrapperMatcher.h"
 #include "ConsoleLog/ConsoleLineListener.h"
+#include "ConsoleLog/ConsoleLogTimestamps.h"
 #include "ConsoleLines.h"
 #include "Log.h"
-#include "Util/RegexUtils.h"
 #include "Config/Settings.h"
+#include "Filesystem.h"
+#include "Util/SPSCRing.h"
 #include "WorldState.h"
 #include "Platform/Platform.h"
 
 #include <mh/text/format.hpp>
 #include <mh/text/formatters/error_code.hpp>
 #include <mh/future.hpp>
+#include <nlohmann/json.hpp>
 
-#include <regex>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdio>
+#include <iomanip>
+#include <mutex>
+#include <thread>
 
 using namespace std::chrono_literals;
 using namespace std::string_literals;
 using namespace tf2_bot_detector;
 
+namespace
+{
+	constexpr size_t MIN_READ_SIZE = 4096;
+	constexpr size_t MAX_READ_SIZE = 1024 * 1024;
+
+	// How often the ingest thread polls console.log's size (see ConsoleLogPoller), and checks
+	// for room in the queue when it is full
+	constexpr duration_t INGEST_POLL_INTERVAL = 10ms;
+
+	// Each entry is everything parsed out of one read, so this also bounds how much of
+	// console.log can be held in memory waiting for the main thread
+	constexpr size_t INGEST_QUEUE_CAPACITY = 32;
+
+	// Reading the clock isn't free either
+	constexpr size_t BUDGET_CHECK_INTERVAL = 32;
+
+	// If console.log can't be truncated when we open it, we start this far (in log time)
+	// before its last line, or from the checkpoint if that is more recent. Plenty to pick the
+	// lobby and the server's player list back up.
+	constexpr duration_t RESUME_WINDOW = 5min;
+	constexpr uint64_t RESUME_MAX_SCAN_BYTES = 64 * 1024 * 1024;
+
+	constexpr duration_t CHECKPOINT_SAVE_INTERVAL = 10s;
+}
+
+struct ConsoleLogParser::PendingLine : PreparsedConsoleLine
+{
+	// Set if this is a wrapped chat message, which may go on for several lines. The chat line
+	// itself needs the world state, so it is built on the main thread.
+	std::unique_ptr<ChatWrapperMatch> m_ChatMatch;
+};
+
+struct ConsoleLogParser::LineBatch
+{
+	ConsoleTextSlab m_Slab;   // The text of m_Lines points into this
+	std::vector<PendingLine> m_Lines;
+	std::optional<ConsoleLogCheckpoint> m_Checkpoint;   // Where to resume from once m_Lines were dispatched
+	bool m_CaughtUp = false;   // Nothing more had been written to console.log after m_Lines
+};
+
+struct ConsoleLogParser::IngestThread
+{
+	SPSCRing<LineBatch> m_Queue{ INGEST_QUEUE_CAPACITY };
+
+	std::mutex m_Mutex;
+	std::condition_variable m_WakeCV;
+
+	// Guarded by m_Mutex
+	bool m_StopRequested = false;
+	std::shared_ptr<const ChatWrapperMatcher> m_ChatMatcher;  // From the main thread
+	bool m_SaveConsoleLogs = false;                           // From the main thread
+	std::optional<ConsoleLogCheckpoint> m_Checkpoint;         // From the main thread
+	ConsoleLogReadStats m_ReadStats;                          // From the ingest thread
+	float m_ParseProgress = 0;                                // From the ingest thread
+
+	// Main thread only
+	std::optional<ConsoleLogCheckpoint> m_DispatchedCheckpoint;
+	LineBatch m_CurrentBatch;
+	size_t m_CurrentBatchPos = 0;
+	size_t m_PeakQueueDepth = 0;
+	uint64_t m_BudgetExhaustedUpdates = 0;
+
+	std::thread m_Thread;
+};
+
 void ConsoleLogParser::TrySnapshot(bool& snapshotUpdated)
 {
 	if ((!snapshotUpdated || !m_CurrentTimestamp.IsSnapshotValid()) && m_CurrentTimestamp.IsRecordedValid())
@@ -29,11 +105,269 @@ void ConsoleLogParser::TrySnapshot(bool& snapshotUpdated)
 }
 
 ConsoleLogParser::ConsoleLogParser(IWorldState& world, const Settings& settings, std::filesystem::path conLogFile) :
-	m_Settings(&settings), m_WorldState(&world), m_FileName(std::move(conLogFile))
+	m_Settings(&settings), m_WorldState(&world), m_FileName(std::move(conLogFile)),
+	m_FileLineBuf(std::make_shared<std::string>()), m_ReadSize(MIN_READ_SIZE),
+	m_ReadRateWindowStart(std::chrono::steady_clock::now()),
+	m_CheckpointFileName(IFilesystem::Get().ResolvePath("temp/console_log_checkpoint.json", PathUsage::WriteLocal)),
+	m_Ingest(std::make_unique<IngestThread>())
+{
+	m_IngestReadStats.m_QueueCapacity = m_Ingest->m_Queue.capacity();
+	m_ReadStats = m_IngestReadStats;
+
+	m_Ingest->m_ChatMatcher = m_Settings->m_Unsaved.m_ChatMsgWrappersMatcher;
+	m_Ingest->m_SaveConsoleLogs = m_Settings->m_SaveConsoleLogs;
+	m_Ingest->m_Thread = std::thread(&ConsoleLogParser::IngestThreadFunc, this);
+}
+
+ConsoleLogParser::ConsoleLogParser(IWorldState& world, const Settings& settings) :
+	m_Settings(&settings), m_WorldState(&world), m_FileLineBuf(std::make_shared<std::string>()), m_ReadSize(MIN_READ_SIZE),
+	m_ReadRateWindowStart(std::chrono::steady_clock::now())
+{
+}
+
+ConsoleLogParser::~ConsoleLogParser()
+{
+	if (m_Ingest)
+	{
+		{
+			std::lock_guard lock(m_Ingest->m_Mutex);
+			m_Ingest->m_StopRequested = true;
+		}
+
+		m_Ingest->m_WakeCV.notify_all();
+		m_Ingest->m_Thread.join();
+
+		// Everything up to here made it to the world, so that's where the next run picks up
+		if (m_Ingest->m_DispatchedCheckpoint)
+		{
+			try
+			{
+				SaveCheckpoint(*m_Ingest->m_DispatchedCheckpoint);
+			}
+			catch (...)
+			{
+				LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to save console log checkpoint");
+			}
+		}
+	}
+}
+
+void ConsoleLogParser::Update(duration_t budget)
+{
+	if (!m_Ingest)
+		return; // We are only parsing what is passed to Feed()
+
+	IngestThread& ingest = *m_Ingest;
+	{
+		std::lock_guard lock(ingest.m_Mutex);
+		ingest.m_ChatMatcher = m_Settings->m_Unsaved.m_ChatMsgWrappersMatcher;
+		ingest.m_SaveConsoleLogs = m_Settings->m_SaveConsoleLogs;
+		ingest.m_Checkpoint = ingest.m_DispatchedCheckpoint;
+
+		m_ReadStats = ingest.m_ReadStats;
+		m_ParseProgress = ingest.m_ParseProgress;
+	}
+
+	bool snapshotUpdated = false;
+	bool linesProcessed = false;
+	bool consoleLinesUpdated = false;
+
+	const auto startTime = std::chrono::steady_clock::now();
+	for (size_t dispatchedCount = 1; ; dispatchedCount++)
+	{
+		bool queueEmpty = false;
+		while (ingest.m_CurrentBatchPos >= ingest.m_CurrentBatch.m_Lines.size())
+		{
+			if (ingest.m_CurrentBatch.m_Checkpoint)
+				ingest.m_DispatchedCheckpoint = ingest.m_CurrentBatch.m_Checkpoint;
+
+			// Only here, not when the budget runs out or a batch ends, see ServerStatusBlockAssembler::Flush()
+			if (ingest.m_CurrentBatch.m_CaughtUp)
+				m_WorldState->GetConsoleLineListenerBroadcaster().OnConsoleLogCaughtUp(*m_WorldState);
+
+			ingest.m_CurrentBatch = {};
+			ingest.m_CurrentBatchPos = 0;
+
+			ingest.m_PeakQueueDepth = std::max(ingest.m_PeakQueueDepth, ingest.m_Queue.size());
+			if (!ingest.m_Queue.TryPop(ingest.m_CurrentBatch))
+			{
+				queueEmpty = true;
+				break;
+			}
+
+			ingest.m_WakeCV.notify_one(); // In case the ingest thread is waiting for room
+		}
+
+		if (queueEmpty)
+			break;
+
+		PendingLine& line = ingest.m_CurrentBatch.m_Lines[ingest.m_CurrentBatchPos++];
+		DispatchLine(line, line.m_ChatMatch.get(), &ingest.m_CurrentBatch.m_Slab, snapshotUpdated, consoleLinesUpdated);
+		line.m_Parsed.reset();
+		linesProcessed = true;
+
+		if ((dispatchedCount % BUDGET_CHECK_INTERVAL) == 0 && (std::chrono::steady_clock::now() - startTime) >= budget)
+		{
+			if (ingest.m_CurrentBatchPos < ingest.m_CurrentBatch.m_Lines.size() || !ingest.m_Queue.empty())
+				ingest.m_BudgetExhaustedUpdates++;
+
+			break;
+		}
+	}
+
+	m_ReadStats.m_QueueDepth = ingest.m_Queue.size();
+	m_ReadStats.m_PeakQueueDepth = ingest.m_PeakQueueDepth;
+	m_ReadStats.m_PendingLines = ingest.m_CurrentBatch.m_Lines.size() - ingest.m_CurrentBatchPos;
+	m_ReadStats.m_BudgetExhaustedUpdates = ingest.m_BudgetExhaustedUpdates;
+
+	TrySnapshot(snapshotUpdated);
+
+	if (linesProcessed)
+		m_WorldState->GetConsoleLineListenerBroadcaster().OnConsoleLogChunkParsed(*m_WorldState, consoleLinesUpdated);
+}
+
+void ConsoleLogParser::Feed(const std::string_view& text)
+{
+	assert(!m_Ingest);
+
+	GetWritableFileLineBuf().append(text);
+	UpdateReadStats(text.size());
+
+	size_t parseEnd = m_FileLineBufBegin;
+	{
+		LineBatch batch;
+		ParseChunk(parseEnd, batch, m_Settings->m_Unsaved.m_ChatMsgWrappersMatcher.get());
+
+		bool snapshotUpdated = false;
+		bool consoleLinesUpdated = false;
+		for (PendingLine& line : batch.m_Lines)
+			DispatchLine(line, line.m_ChatMatch.get(), &m_FileLineBuf, snapshotUpdated, consoleLinesUpdated);
+
+		TrySnapshot(snapshotUpdated);
+
+		if (!batch.m_Lines.empty())
+		{
+			auto& broadcaster = m_WorldState->GetConsoleLineListenerBroadcaster();
+			broadcaster.OnConsoleLogChunkParsed(*m_WorldState, consoleLinesUpdated);
+			broadcaster.OnConsoleLogCaughtUp(*m_WorldState);
+		}
+	}
+
+	// Only once the batch is gone, so the buffer can be compacted in place
+	ConsumeFileLineBuf(parseEnd);
+	m_ReadStats = m_IngestReadStats;
+}
+
+void ConsoleLogParser::FeedPreparsed(std::span<PreparsedConsoleLine> lines)
+{
+	assert(!m_Ingest);
+
+	bool snapshotUpdated = false;
+	bool consoleLinesUpdated = false;
+
+	for (PreparsedConsoleLine& line : lines)
+		DispatchLine(line, nullptr, nullptr, snapshotUpdated, consoleLinesUpdated);
+
+	if (!lines.empty())
+	{
+		auto& broadcaster = m_WorldState->GetConsoleLineListenerBroadcaster();
+		broadcaster.OnConsoleLogChunkParsed(*m_WorldState, consoleLinesUpdated);
+		broadcaster.OnConsoleLogCaughtUp(*m_WorldState);
+	}
+}
+
+void ConsoleLogParser::DispatchLine(PreparsedConsoleLine& line, const ChatWrapperMatch* chatMatch,
+	const ConsoleTextSlab* slab, bool& snapshotUpdated, bool& consoleLinesUpdated)
+{
+	m_CurrentTimestamp.SetRecorded(line.m_Timestamp);
+	TrySnapshot(snapshotUpdated);
+
+	if (chatMatch)
+	{
+		TeamShareResult teamShareResult = TeamShareResult::Neither;
+		SteamID id;
+		bool isSelf = false;
+		if (auto player = m_WorldState->FindSteamIDForName(chatMatch->m_Name))
+		{
+			teamShareResult = m_WorldState->GetTeamShareResult(*player);
+			isSelf = (player == m_Settings->GetLocalSteamID());
+			id = *player;
+		}
+
+		const auto category = chatMatch->m_Category;
+		line.m_Parsed = std::make_shared<ChatConsoleLine>(m_WorldState->GetCurrentTime(),
+			ConsoleLineText(chatMatch->m_Name, slab, true), ConsoleLineText(chatMatch->m_Message, slab, true),
+			IsDead(category), IsTeam(category), isSelf, teamShareResult, id);
+	}
+	else if (line.m_NeedsWorldState)
+	{
+		line.m_Parsed = IConsoleLine::ParseConsoleLine(line.m_Text, m_CurrentTimestamp.GetSnapshot(), *m_WorldState, slab);
+		if (line.m_Parsed && line.m_Parsed->GetType() == ConsoleLineType::Chat)
+			LogError("Line was parsed as a chat message via old code path, this should never happen!");
+	}
+
+	auto& broadcaster = m_WorldState->GetConsoleLineListenerBroadcaster();
+	if (line.m_Parsed)
+	{
+		broadcaster.OnConsoleLineParsed(*m_WorldState, *line.m_Parsed);
+		consoleLinesUpdated = true;
+	}
+	else
+	{
+		broadcaster.OnConsoleLineUnparsed(*m_WorldState, line.m_Text);
+	}
+}
+
+void ConsoleLogParser::CustomDeleters::operator()(FILE* f) const
 {
+	fclose(f);
+}
+
+void ConsoleLogParser::IngestThreadFunc()
+{
+	IngestThread& ingest = *m_Ingest;
+
+	while (true)
+	{
+		std::shared_ptr<const ChatWrapperMatcher> chatMatcher;
+		bool saveConsoleLogs;
+		std::optional<ConsoleLogCheckpoint> checkpoint;
+		{
+			std::lock_guard lock(ingest.m_Mutex);
+			if (ingest.m_StopRequested)
+				break;
+
+			chatMatcher = ingest.m_ChatMatcher;
+			saveConsoleLogs = ingest.m_SaveConsoleLogs;
+			checkpoint = ingest.m_Checkpoint;
+		}
+
+		try
+		{
+			IngestUpdate(chatMatcher.get(), saveConsoleLogs);
+
+			if (const auto now = clock_t::now(); checkpoint && checkpoint->m_Offset != m_SavedCheckpoint.m_Offset &&
+				(now - m_LastCheckpointSaveTime) >= CHECKPOINT_SAVE_INTERVAL)
+			{
+				m_LastCheckpointSaveTime = now;
+				SaveCheckpoint(*checkpoint);
+			}
+		}
+		catch (...)
+		{
+			LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to read {}", m_FileName);
+		}
+
+		std::unique_lock lock(ingest.m_Mutex);
+		ingest.m_ReadStats = m_IngestReadStats;
+		ingest.m_ParseProgress = m_IngestParseProgress;
+
+		if (!m_ReadPending)
+			ingest.m_WakeCV.wait_for(lock, INGEST_POLL_INTERVAL, [&] { return ingest.m_StopRequested; });
+	}
 }
 
-void ConsoleLogParser::Update()
+void ConsoleLogParser::IngestUpdate(const ChatWrapperMatcher* chatMatcher, bool saveConsoleLogs)
 {
 	const auto now = clock_t::now();
 	if (!m_File && (now - m_LastFileLoadAttempt) > 1s)
@@ -41,6 +375,7 @@ void ConsoleLogParser::Update()
 		m_LastFileLoadAttempt = now;
 
 		// Try to truncate
+		bool truncated = false;
 		{
 			std::error_code ec;
 			const auto filesize = std::filesystem::file_size(m_FileName, ec);
@@ -49,7 +384,10 @@ void ConsoleLogParser::Update()
 			else if (std::filesystem::resize_file(m_FileName, 0, ec); ec)
 				Log("Unable to truncate {}, current size is {}", m_FileName, filesize);
 			else
+			{
 				Log("Truncated console log file");
+				truncated = true;
+			}
 		}
 
 		std::error_code ec;
@@ -64,223 +402,444 @@ void ConsoleLogParser::Update()
 		}
 
 		if (!m_File)
+		{
 			DebugLog("Failed to open {}: {}", m_FileName, ec);
+		}
 		else
+		{
 			Log("Successfully opened {}", m_FileName);
+			m_ReadPending = true;
+			m_Poller.Reset();
+
+			// Don't make startup time depend on how long tf2 has been running
+			if (!truncated)
+				SeekToResumePoint();
+		}
 	}
 
-	bool snapshotUpdated = false;
+	// Only touch the file if its size changed, or we didn't get through everything last time
+	const auto wakeReason = m_File ?
+		m_Poller.Poll(now, GetOpenFileSize(m_File.get()), m_ReadPending) : ConsoleLogPoller::WakeReason::None;
 
-	bool linesProcessed = false;
-	bool consoleLinesUpdated = false;
-	if (m_File)
+	if (wakeReason == ConsoleLogPoller::WakeReason::None)
+	{
+		m_IngestReadStats.m_IdleUpdates++;
+		return;
+	}
+
+	m_IngestReadStats.m_Wakeups++;
+	if (wakeReason == ConsoleLogPoller::WakeReason::SizeChanged)
+		m_IngestReadStats.m_SizeWakeups++;
+	else if (wakeReason == ConsoleLogPoller::WakeReason::Periodic)
+		m_IngestReadStats.m_PeriodicWakeups++;
+
+	std::error_code ec;
+	const auto length = std::filesystem::file_size(m_FileName, ec);
+	const auto lastWriteTime = ec ? std::filesystem::file_time_type{} : std::filesystem::last_write_time(m_FileName, ec);
+
+	// If we can't tell where we are, we don't know that it was truncated
+	if (const auto pos = TellFile(m_File.get()); !ec && pos && length < *pos)
+	{
+		Log("{} was truncated, reading from the beginning", m_FileName);
+		std::rewind(m_File.get());
+		ConsumeFileLineBuf(m_FileLineBuf->size());
+		m_FileLineBufBeginOffset = 0;
+		m_LineTimestamp.reset();
+		m_FileHead.reset();
+	}
+
+	const auto totalBytesRead = m_IngestReadStats.m_TotalBytesRead;
+
+	// No time limit, the queue to the main thread is what keeps us from getting too far ahead
+	m_ReadPending = false;
+	bool anyPushed = false;
+	while (ReadFileChunk(saveConsoleLogs) > 0)
+	{
+		LineBatch batch;
+		size_t parseEnd = m_FileLineBufBegin;
+		ParseChunk(parseEnd, batch, chatMatcher);
+
+		if (!batch.m_Lines.empty())
+			batch.m_Slab = m_FileLineBuf;
+
+		if (m_LineTimestamp && m_FileOffsetsExact)
+		{
+			auto& checkpoint = batch.m_Checkpoint.emplace();
+			checkpoint.m_Offset = m_LineOffset;
+			checkpoint.m_Timestamp = *m_LineTimestamp;
+		}
+
+		ConsumeFileLineBuf(parseEnd);
+
+		if (batch.m_Lines.empty())
+			continue;
+
+		if (!PushBatch(std::move(batch)))
+		{
+			m_ReadPending = true;
+			return; // Shutting down
+		}
+
+		anyPushed = true;
+	}
+
+	// Batches end wherever a read happened to stop, so let the main thread know where the
+	// output that was actually written in one go ends
+	if (anyPushed)
 	{
-		Parse(linesProcessed, snapshotUpdated, consoleLinesUpdated);
+		LineBatch caughtUp;
+		caughtUp.m_CaughtUp = true;
+		if (!PushBatch(std::move(caughtUp)))
+		{
+			m_ReadPending = true;
+			return; // Shutting down
+		}
+	}
 
+	if (!ec)
+	{
 		// Parse progress
+		if (const auto pos = TellFile(m_File.get()))
+			m_IngestParseProgress = length > 0 ? std::min(float(double(*pos) / length), 1.0f) : 1.0f;
+
+		// How long ago the newest data we just parsed was written
+		if (m_IngestReadStats.m_TotalBytesRead != totalBytesRead)
 		{
-			const auto pos = ftell(m_File.get());
-			const auto length = std::filesystem::file_size(m_FileName);
-			m_ParseProgress = float(double(pos) / length);
+			const auto latency = std::max(duration_t{}, std::chrono::duration_cast<duration_t>(
+				std::filesystem::file_time_type::clock::now() - lastWriteTime));
+
+			m_IngestReadStats.m_LastWriteToParseLatency = latency;
+			m_IngestReadStats.m_MaxWriteToParseLatency = std::max(m_IngestReadStats.m_MaxWriteToParseLatency, latency);
+			m_IngestReadStats.m_AvgWriteToParseLatency = m_IngestReadStats.m_LatencySamples++ > 0 ?
+				(m_IngestReadStats.m_AvgWriteToParseLatency * 7 + latency) / 8 : latency;
 		}
 	}
+}
 
-	TrySnapshot(snapshotUpdated);
+void ConsoleLogParser::SeekToResumePoint()
+{
+	std::error_code ec;
+	const uint64_t fileSize = std::filesystem::file_size(m_FileName, ec);
+	if (ec)
+	{
+		LogWarning("Failed to get size of {}, reading it from the beginning: {}", m_FileName, ec);
+		return;
+	}
 
-	if (linesProcessed)
-		m_WorldState->GetConsoleLineListenerBroadcaster().OnConsoleLogChunkParsed(*m_WorldState, consoleLinesUpdated);
+	uint64_t offset = FindConsoleLogWindowStart(m_File.get(), fileSize, RESUME_WINDOW, RESUME_MAX_SCAN_BYTES);
+	bool fromCheckpoint = false;
+
+	if (const auto checkpoint = LoadCheckpoint())
+	{
+		if (!IsConsoleLogCheckpointValid(m_File.get(), fileSize, *checkpoint))
+		{
+			DebugLog("Console log checkpoint doesn't belong to {}, ignoring it", m_FileName);
+		}
+		else if (checkpoint->m_Offset > offset)
+		{
+			offset = checkpoint->m_Offset;
+			fromCheckpoint = true;
+		}
+	}
+
+	if (!SeekFile(m_File.get(), offset))
+	{
+		LogWarning("Failed to seek to {} in {}, reading it from the beginning", offset, m_FileName);
+		std::rewind(m_File.get());
+		offset = 0;
+	}
+	else if (offset > 0)
+	{
+		Log("Skipped the first {} of {} bytes of {}, resuming from {}", offset, fileSize, m_FileName,
+			fromCheckpoint ? "the last checkpoint" : "the last few minutes");
+	}
+
+	m_FileLineBufBeginOffset = offset;
+	m_LineTimestamp.reset();
+	m_IngestReadStats.m_SkippedBytes = offset;
 }
 
-void ConsoleLogParser::CustomDeleters::operator()(FILE* f) const
+std::optional<ConsoleLogCheckpoint> ConsoleLogParser::LoadCheckpoint() const try
 {
-	fclose(f);
+	if (!std::filesystem::exists(m_CheckpointFileName))
+		return std::nullopt;
+
+	return nlohmann::json::parse(IFilesystem::Get().ReadFile(m_CheckpointFileName)).get<ConsoleLogCheckpoint>();
+}
+catch (...)
+{
+	LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to load {}", m_CheckpointFileName);
+	return std::nullopt;
 }
 
-void ConsoleLogParser::Parse(bool& linesProcessed, bool& snapshotUpdated, bool& consoleLinesUpdated)
+void ConsoleLogParser::SaveCheckpoint(ConsoleLogCheckpoint checkpoint)
 {
-	char buf[4096];
-	size_t readCount;
-	using clock = std::chrono::steady_clock;
-	const auto startTime = clock::now();
-	do
-	{
-		readCount = fread(buf, sizeof(buf[0]), std::size(buf), m_File.get());
-		if (readCount > 0)
+	if (!m_File || !m_FileOffsetsExact)
+		return;
+
+	// console.log may have still been shorter than the head the last time we looked
+	if (!m_FileHead || m_FileHead->m_Size < ConsoleLogFileHead::MAX_SIZE)
+	{
+		const auto pos = TellFile(m_File.get());
+		if (!pos)
+			return;
+
+		m_FileHead = ReadConsoleLogHead(m_File.get());
+		if (!SeekFile(m_File.get(), *pos))
 		{
-			m_FileLineBuf.append(buf, readCount);
-			if (m_Settings->m_SaveConsoleLogs) {
-				ILogManager::GetInstance().LogConsoleOutput(std::string_view(buf, readCount));
-			}
+			LogError("Failed to seek back to {} in {} after reading its head", *pos, m_FileName);
+			return;
+		}
+	}
+
+	if (!m_FileHead || m_FileHead->m_Size == 0)
+		return;
 
-			auto parseEnd = m_FileLineBuf.cbegin();
-			ParseChunk(parseEnd, linesProcessed, snapshotUpdated, consoleLinesUpdated);
+	checkpoint.m_Head = *m_FileHead;
+	IFilesystem::Get().WriteFile(m_CheckpointFileName, nlohmann::json(checkpoint).dump(1, '\t'), PathUsage::WriteLocal);
+	m_SavedCheckpoint = checkpoint;
+}
+
+bool ConsoleLogParser::PushBatch(LineBatch&& batch)
+{
+	IngestThread& ingest = *m_Ingest;
+	if (ingest.m_Queue.TryPush(std::move(batch)))
+		return true;
 
-			m_FileLineBuf.erase(m_FileLineBuf.begin(), parseEnd);
+	// The main thread is behind. Wait for it rather than buffering without limit, anything
+	// that hasn't been read yet is safe in console.log.
+	m_IngestReadStats.m_IngestStalls++;
+	const auto stallStart = std::chrono::steady_clock::now();
+
+	std::unique_lock lock(ingest.m_Mutex);
+	while (!ingest.m_StopRequested)
+	{
+		if (ingest.m_Queue.TryPush(std::move(batch)))
+		{
+			m_IngestReadStats.m_IngestStallTime += std::chrono::duration_cast<duration_t>(
+				std::chrono::steady_clock::now() - stallStart);
+			return true;
 		}
 
-		if (auto elapsed = clock::now() - startTime; elapsed >= 50ms)
-			break;
+		// Publish while we wait, so the stall shows up in the stats now rather than afterwards
+		ingest.m_ReadStats = m_IngestReadStats;
+		ingest.m_WakeCV.wait_for(lock, INGEST_POLL_INTERVAL);
+	}
+
+	return false;
+}
+
+size_t ConsoleLogParser::ReadFileChunk(bool saveConsoleLogs)
+{
+	// Read straight into the end of the buffer rather than through a temporary
+	std::string& buf = GetWritableFileLineBuf();
+	const size_t oldSize = buf.size();
+	buf.resize(oldSize + m_ReadSize);
+	const auto startPos = m_FileOffsetsExact ? TellFile(m_File.get()) : std::nullopt;
+	const size_t readCount = fread(buf.data() + oldSize, sizeof(char), m_ReadSize, m_File.get());
+	buf.resize(oldSize + readCount);
+
+	// Only conclude anything if we know where the read started and ended
+	if (const auto endPos = startPos && readCount > 0 ? TellFile(m_File.get()) : std::nullopt;
+		endPos && (*endPos - *startPos) != readCount)
+	{
+		Log("Line endings in {} are being translated, console log checkpoints are disabled", m_FileName);
+		m_FileOffsetsExact = false;
+	}
 
-	} while (readCount > 0);
+	if (readCount > 0 && saveConsoleLogs)
+		ILogManager::GetInstance().LogConsoleOutput(std::string_view(buf).substr(oldSize));
+
+	// If a read filled the whole request, there is probably a backlog (map change, game was
+	// paused, we just started up). Keep doubling the read size until we catch up.
+	if (readCount == m_ReadSize)
+		m_ReadSize = std::min(m_ReadSize * 2, MAX_READ_SIZE);
+	else
+		m_ReadSize = MIN_READ_SIZE;
+
+	m_IngestReadStats.m_ReadSize = m_ReadSize;
+	UpdateReadStats(readCount);
+
+	return readCount;
 }
 
-bool ConsoleLogParser::ParseChatMessage(const std::string_view& lineStr, striter& parseEnd, std::shared_ptr<IConsoleLine>& parsed)
+void ConsoleLogParser::UpdateReadStats(size_t readCount)
 {
-	for (int i = 0; i < (int)ChatCategory::COUNT; i++)
+	m_IngestReadStats.m_TotalBytesRead += readCount;
+	m_IngestReadStats.m_BufferSize = m_FileLineBuf->size();
+	m_IngestReadStats.m_PeakBufferSize = std::max(m_IngestReadStats.m_PeakBufferSize, m_FileLineBuf->size());
+	m_IngestReadStats.m_ReplacedBuffers = m_ReplacedFileLineBufs;
+
+	m_ReadRateWindowBytes += readCount;
+
+	const auto now = std::chrono::steady_clock::now();
+	if (const auto elapsed = now - m_ReadRateWindowStart; elapsed >= 1s)
 	{
-		const auto category = ChatCategory(i);
+		m_IngestReadStats.m_BytesPerSecond = float(m_ReadRateWindowBytes / to_seconds(elapsed));
+		m_ReadRateWindowStart = now;
+		m_ReadRateWindowBytes = 0;
+	}
+}
 
-		auto& type = m_Settings->m_Unsaved.m_ChatMsgWrappers.value().m_Types[i];
-		if (lineStr.starts_with(type.m_Full.m_Start.m_Narrow))
-		{
-			auto searchBuf = std::string_view(m_FileLineBuf).substr(
-				&*lineStr.begin() - m_FileLineBuf.data() + type.m_Full.m_Start.m_Narrow.size());
+void ConsoleLogParser::ConsumeFileLineBuf(size_t parseEnd)
+{
+	m_FileLineBufBeginOffset += parseEnd - m_FileLineBufBegin;
+	m_FileLineBufBegin = parseEnd;
 
-			if (auto found = searchBuf.find(type.m_Full.m_End.m_Narrow); found != lineStr.npos)
-			{
-				if (found > 512)
-				{
-					LogError("Searched more than 512 characters ({}) for the end of the chat msg string, something is terribly wrong!", found);
-				}
+	// Lines that are still alive point into the parsed part, leave it alone.
+	// GetWritableFileLineBuf() takes care of it next time we need to write.
+	if (m_FileLineBuf.use_count() > 1)
+		return;
+
+	// The last reference may have just been dropped on the main thread, make sure we see
+	// everything it did before it let go
+	std::atomic_thread_fence(std::memory_order_acquire);
 
-				searchBuf = searchBuf.substr(0, found);
+	if (m_FileLineBufBegin == m_FileLineBuf->size())
+	{
+		m_FileLineBuf->clear();
+		m_FileLineBufBegin = 0;
+	}
+	else if (m_FileLineBufBegin >= (m_FileLineBuf->size() / 2))
+	{
+		// The unparsed tail is no bigger than what we are throwing away, so the cost of
+		// moving it is paid for by the bytes that were parsed to get here.
+		m_FileLineBuf->erase(0, m_FileLineBufBegin);
+		m_FileLineBufBegin = 0;
+	}
+}
 
-				auto nameBegin = searchBuf.find(type.m_Name.m_Start.m_Narrow);
-				auto nameEnd = searchBuf.find(type.m_Name.m_End.m_Narrow);
-				auto msgBegin = searchBuf.find(type.m_Message.m_Start.m_Narrow);
-				auto msgEnd = searchBuf.find(type.m_Message.m_End.m_Narrow);
+std::string& ConsoleLogParser::GetWritableFileLineBuf()
+{
+	// Nobody else can pick up a new reference to the buffer, so if we have the only one,
+	// it stays that way.
+	if (m_FileLineBuf.use_count() > 1)
+	{
+		const auto unparsed = std::string_view(*m_FileLineBuf).substr(m_FileLineBufBegin);
 
-				if (nameBegin != searchBuf.npos && nameEnd != searchBuf.npos && msgBegin != searchBuf.npos && msgEnd != searchBuf.npos)
-				{
-					const auto name = searchBuf.substr(
-						nameBegin + type.m_Name.m_Start.m_Narrow.size(),
-						nameEnd - nameBegin - type.m_Name.m_Start.m_Narrow.size());
-
-					const auto msg = searchBuf.substr(
-						msgBegin + type.m_Message.m_Start.m_Narrow.size(),
-						msgEnd - msgBegin - type.m_Message.m_Start.m_Narrow.size());
-
-					TeamShareResult teamShareResult = TeamShareResult::Neither;
-					SteamID id;
-					bool isSelf = false;
-					if (auto player = m_WorldState->FindSteamIDForName(name))
-					{
-						teamShareResult = m_WorldState->GetTeamShareResult(*player);
-						isSelf = (player == m_Settings->GetLocalSteamID());
-						id = *player;
-					}
-
-					parsed = std::make_unique<ChatConsoleLine>(m_WorldState->GetCurrentTime(),
-						std::string(name), std::string(msg), IsDead(category), IsTeam(category), isSelf, teamShareResult, id);
-				}
-				else
-				{
-					if (nameBegin == searchBuf.npos)
-						LogError("Failed to find name begin sequence in chat message of type {}", mh::enum_fmt(category));
-					if (nameEnd == searchBuf.npos)
-						LogError("Failed to find name end sequence in chat message of type {}", mh::enum_fmt(category));
-					if (msgBegin == searchBuf.npos)
-						LogError("Failed to find message begin sequence in chat message of type {}", mh::enum_fmt(category));
-					if (msgEnd == searchBuf.npos)
-						LogError("Failed to find message end sequence in chat message of type {}", mh::enum_fmt(category));
-				}
+		auto newBuf = std::make_shared<std::string>();
+		newBuf->reserve(unparsed.size() + m_ReadSize);
+		newBuf->assign(unparsed);
 
-				parseEnd += type.m_Full.m_Start.m_Narrow.size() + found + type.m_Full.m_End.m_Narrow.size();
-				return true;
-			}
-			else
-			{
-				LogError("Failed to locate chat message wrapper end");
-				return false; // Not enough characters in m_FileLineBuf. Try again later.
-			}
-		}
+		m_FileLineBuf = std::move(newBuf);
+		m_FileLineBufBegin = 0;
+		m_ReplacedFileLineBufs++;
+	}
+	else
+	{
+		// See ConsumeFileLineBuf()
+		std::atomic_thread_fence(std::memory_order_acquire);
 	}
 
-	return true;
+	return *m_FileLineBuf;
 }
 
-void ConsoleLogParser::ParseChunk(striter& parseEnd, bool& linesProcessed, bool& snapshotUpdated, bool& consoleLinesUpdated)
+bool ConsoleLogParser::MatchChatMessage(const ChatWrapperMatcher* chatMatcher, const std::string_view& lineStr,
+	size_t& parseEnd, PendingLine& line)
 {
-	static const std::regex s_TimestampRegex(R"regex(\n(\d\d)\/(\d\d)\/(\d\d\d\d) - (\d\d):(\d\d):(\d\d):[ \n])regex", std::regex::optimize);
+	// Not generated yet, or a replay that wasn't given the wrappers the log was captured with
+	if (!chatMatcher)
+		return true;
+
+	const auto searchBuf = std::string_view(*m_FileLineBuf).substr(lineStr.data() - m_FileLineBuf->data());
 
-	std::smatch match;
-	while (std::regex_search(parseEnd, m_FileLineBuf.cend(), match, s_TimestampRegex))
+	ChatWrapperMatch match;
+	switch (chatMatcher->Match(searchBuf, match))
 	{
-		auto regexBegin = parseEnd;
+	case ChatWrapperMatchResult::NotChat:
+		return true;
 
-		ParseLineResult result = ParseLineResult::Unparsed;
-		bool skipTimestampParse = false;
-		if (m_CurrentTimestamp.IsRecordedValid())
-		{
-			// If we have a valid snapshot, that means that there was a previously parsed
-			// timestamp. The contents of that line is the current timestamp match's prefix
-			// (the previous timestamp match was erased from the string)
+	case ChatWrapperMatchResult::Incomplete:
+		LogError("Failed to locate chat message wrapper end");
+		return false; // Not enough characters in m_FileLineBuf. Try again later.
 
-			TrySnapshot(snapshotUpdated);
-			linesProcessed = true;
+	case ChatWrapperMatchResult::Match:
+		break;
+	}
 
-			std::shared_ptr<IConsoleLine> parsed;
+	if (match.m_BodyLength > 512)
+	{
+		LogError("Searched more than 512 characters ({}) for the end of the chat msg string, something is terribly wrong!", match.m_BodyLength);
+	}
 
-			const auto prefix = match.prefix();
-			//const auto suffix = match.suffix();
-			const std::string_view lineStr(&*prefix.first, prefix.length());
+	const auto category = match.m_Category;
+	if (!match.HasNameAndMessage())
+	{
+		if (match.m_NameBegin == match.npos)
+			LogError("Failed to find name begin sequence in chat message of type {}", mh::enum_fmt(category));
+		if (match.m_NameEnd == match.npos)
+			LogError("Failed to find name end sequence in chat message of type {}", mh::enum_fmt(category));
+		if (match.m_MessageBegin == match.npos)
+			LogError("Failed to find message begin sequence in chat message of type {}", mh::enum_fmt(category));
+		if (match.m_MessageEnd == match.npos)
+			LogError("Failed to find message end sequence in chat message of type {}", mh::enum_fmt(category));
+	}
 
-			if (ParseChatMessage(lineStr, regexBegin, parsed))
-			{
-				if (parsed)
-					result = ParseLineResult::Modified;
-			}
-			else
+	parseEnd += match.m_Length;
+	if (match.HasNameAndMessage())
+		line.m_ChatMatch = std::make_unique<ChatWrapperMatch>(match);
+
+	return true;
+}
+
+void ConsoleLogParser::ParseChunk(size_t& parseEnd, LineBatch& batch, const ChatWrapperMatcher* chatMatcher)
+{
+	const std::string_view fileLineBuf(*m_FileLineBuf);
+
+	while (auto match = FindConsoleLogTimestamp(fileLineBuf, parseEnd))
+	{
+		auto nextParseBegin = parseEnd;
+
+		bool isChat = false;
+		if (m_LineTimestamp)
+		{
+			// The text between the previous timestamp and this one is the previous timestamp's line
+			const auto lineStr = fileLineBuf.substr(parseEnd, match->m_Begin - parseEnd);
+
+			PendingLine& line = batch.m_Lines.emplace_back();
+			line.m_Timestamp = *m_LineTimestamp;
+			line.m_Text = lineStr;
+
+			if (!MatchChatMessage(chatMatcher, lineStr, nextParseBegin, line))
 			{
+				batch.m_Lines.pop_back();
 				return; // Try again later (not enough chars in buffer)
 			}
 
-			if (!parsed && result == ParseLineResult::Unparsed)
+			if (line.m_ChatMatch)
 			{
-				parsed = IConsoleLine::ParseConsoleLine(lineStr, m_CurrentTimestamp.GetSnapshot(), *m_WorldState);
-				if (parsed && parsed->GetType() == ConsoleLineType::Chat)
-					LogError("Line was parsed as a chat message via old code path, this should never happen!");
-
-				result = ParseLineResult::Success;
+				isChat = true;
 			}
-
-			if (parsed)
+			else
 			{
-				if (result == ParseLineResult::Success || result == ParseLineResult::Modified)
+				try
 				{
-					m_WorldState->GetConsoleLineListenerBroadcaster().OnConsoleLineParsed(*m_WorldState, *parsed);
-					consoleLinesUpdated = true;
+					line.m_Parsed = IConsoleLine::ParseConsoleLineStateless(lineStr, line.m_Timestamp, *m_WorldState,
+						line.m_NeedsWorldState, &m_FileLineBuf);
 				}
-			}
-			else
-			{
-				m_WorldState->GetConsoleLineListenerBroadcaster().OnConsoleLineUnparsed(*m_WorldState, lineStr);
+				catch (...)
+				{
+					LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to parse console line {}", std::quoted(lineStr));
+				}
+
+				if (line.m_Parsed && line.m_Parsed->GetType() == ConsoleLineType::Chat)
+					LogError("Line was parsed as a chat message via old code path, this should never happen!");
 			}
 		}
 
-		if (result != ParseLineResult::Modified)
+		if (!isChat)
 		{
-			std::tm time{};
-			time.tm_isdst = -1;
-			from_chars_throw(match[1], time.tm_mon);
-			time.tm_mon -= 1;
-
-			from_chars_throw(match[2], time.tm_mday);
-			from_chars_throw(match[3], time.tm_year);
-			time.tm_year -= 1900;
-
-			from_chars_throw(match[4], time.tm_hour);
-			from_chars_throw(match[5], time.tm_min);
-			from_chars_throw(match[6], time.tm_sec);
-
-			m_CurrentTimestamp.SetRecorded(clock_t::from_time_t(std::mktime(&time)));
-			regexBegin = match[0].second;
+			m_LineTimestamp = m_TimestampDecoder.ToTimePoint(*match);
+			m_LineOffset = m_FileLineBufBeginOffset + (match->m_Begin - m_FileLineBufBegin);
+			nextParseBegin = match->m_End;
 		}
 		else
 		{
-			m_CurrentTimestamp.InvalidateRecorded();
+			// The chat message swallowed whatever timestamps were inside of it. Skip ahead to
+			// the next one after it.
+			m_LineTimestamp.reset();
 		}
 
-		parseEnd = regexBegin;
+		parseEnd = nextParseBegin;
 	}
 }
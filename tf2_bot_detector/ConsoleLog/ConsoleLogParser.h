@@ -1,48 +1,138 @@
 #pragma once
 
 #include "CompensatedTS.h"
+#include "ConsoleLog/ConsoleLineText.h"
+#include "ConsoleLog/ConsoleLogCheckpoint.h"
+#include "ConsoleLog/ConsoleLogPoller.h"
+#include "ConsoleLog/ConsoleLogTimestamps.h"
 
 #include <filesystem>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 #include <unordered_set>
 
 namespace tf2_bot_detector
 {
+	struct ChatWrapperMatch;
+	class ChatWrapperMatcher;
 	class IConsoleLine;
 	class IConsoleLineListener;
+	struct PreparsedConsoleLine;
 	class Settings;
 	class IWorldState;
 
+	struct ConsoleLogReadStats
+	{
+		uint64_t m_TotalBytesRead = 0;
+		float m_BytesPerSecond = 0;
+		size_t m_BufferSize = 0;       // Bytes currently held, including already parsed bytes awaiting compaction
+		size_t m_PeakBufferSize = 0;
+		size_t m_ReadSize = 0;         // Current size of each fread() call
+		size_t m_ReplacedBuffers = 0;  // Times parsed lines were still using the buffer when we needed to write to it
+
+		uint64_t m_Wakeups = 0;          // Polls that actually read from the file
+		uint64_t m_IdleUpdates = 0;      // Polls skipped because nothing changed
+		uint64_t m_SizeWakeups = 0;      // Wakeups because the file's size changed
+		uint64_t m_PeriodicWakeups = 0;  // Wakeups only because nothing else had for a while
+
+		// Time from the last write to console.log until we finished parsing it
+		duration_t m_LastWriteToParseLatency{};
+		duration_t m_AvgWriteToParseLatency{};
+		duration_t m_MaxWriteToParseLatency{};
+		uint64_t m_LatencySamples = 0;
+
+		// Handoff from the ingest thread to the main thread. Lines are never dropped, if the
+		// queue is full the ingest thread waits for the main thread to catch up instead.
+		size_t m_QueueDepth = 0;          // Chunks of parsed lines waiting for the main thread
+		size_t m_PeakQueueDepth = 0;
+		size_t m_QueueCapacity = 0;
+		size_t m_PendingLines = 0;        // Lines in the chunk the main thread is working through
+		uint64_t m_IngestStalls = 0;      // Times the ingest thread found the queue full
+		duration_t m_IngestStallTime{};
+		uint64_t m_BudgetExhaustedUpdates = 0;  // Updates that ran out of time with lines still queued
+
+		// Bytes at the start of console.log that were never read, because it couldn't be
+		// truncated and we resumed from a checkpoint or the last few minutes instead
+		uint64_t m_SkippedBytes = 0;
+	};
+
 	class ConsoleLogParser final
 	{
 	public:
+		// Reads and parses console.log on a thread of its own. Update() hands the parsed
+		// lines to the world's listeners on the main thread.
 		ConsoleLogParser(IWorldState& world, const Settings& settings, std::filesystem::path conLogFile);
 
-		void Update();
+		// Doesn't read console.log, only parses the text that is handed to Feed().
+		ConsoleLogParser(IWorldState& world, const Settings& settings);
+		~ConsoleLogParser();
+
+		static constexpr duration_t DEFAULT_UPDATE_BUDGET = std::chrono::milliseconds(8);
+
+		// Dispatches lines until there are none left or budget runs out, whatever is left
+		// over waits for the next call.
+		void Update(duration_t budget = DEFAULT_UPDATE_BUDGET);
+
+		// Parses text as if it had just been appended to console.log. text should end where
+		// the game stopped writing, it is treated as the end of the input so far.
+		void Feed(const std::string_view& text);
+
+		// Hands lines that were already parsed by ParseConsoleLogParallel() to the world's
+		// listeners, in order. Lines that depend on the world state are parsed here. Like
+		// Feed(), the end of lines is treated as the end of the input so far.
+		void FeedPreparsed(std::span<PreparsedConsoleLine> lines);
 
 		float GetParseProgress() const { return m_ParseProgress; }
 
 		const CompensatedTS& GetCurrentTimestamp() const { return m_CurrentTimestamp; }
+		const ConsoleLogReadStats& GetReadStats() const { return m_ReadStats; }
 
 	private:
 		const Settings* m_Settings = nullptr;
 		IWorldState* m_WorldState = nullptr;
 
+		struct PendingLine;
+		struct LineBatch;
+		struct IngestThread;
+
+		// Main thread. Everything below these is owned by whoever is parsing: the ingest
+		// thread if we are reading console.log, or the caller of Feed() otherwise.
 		void TrySnapshot(bool& snapshotUpdated);
+		void DispatchLine(PreparsedConsoleLine& line, const ChatWrapperMatch* chatMatch,
+			const ConsoleTextSlab* slab, bool& snapshotUpdated, bool& consoleLinesUpdated);
 		CompensatedTS m_CurrentTimestamp;
+		ConsoleLogReadStats m_ReadStats;
+		float m_ParseProgress = 0;
 
-		enum class ParseLineResult
-		{
-			Unparsed,
-			Defer,
-			Success,
-			Modified,
-		};
+		void IngestThreadFunc();
+		void IngestUpdate(const ChatWrapperMatcher* chatMatcher, bool saveConsoleLogs);
+		bool PushBatch(LineBatch&& batch);
+		std::optional<time_point_t> m_LineTimestamp;   // Timestamp of the line that starts at m_FileLineBufBegin
+		uint64_t m_LineOffset = 0;                     // Offset in console.log of m_LineTimestamp
+		ConsoleLogTimestampDecoder m_TimestampDecoder;
+
+		void ParseChunk(size_t& parseEnd, LineBatch& batch, const ChatWrapperMatcher* chatMatcher);
+		bool MatchChatMessage(const ChatWrapperMatcher* chatMatcher, const std::string_view& lineStr,
+			size_t& parseEnd, PendingLine& line);
+
+		void SeekToResumePoint();
+		std::optional<ConsoleLogCheckpoint> LoadCheckpoint() const;
+		void SaveCheckpoint(ConsoleLogCheckpoint checkpoint);
+		std::filesystem::path m_CheckpointFileName;
+		std::optional<ConsoleLogFileHead> m_FileHead;
+		ConsoleLogCheckpoint m_SavedCheckpoint;
+		time_point_t m_LastCheckpointSaveTime{};
 
-		using striter = std::string::const_iterator;
-		void Parse(bool& linesProcessed, bool& snapshotUpdated, bool& consoleLinesUpdated);
-		void ParseChunk(striter& parseEnd, bool& linesProcessed, bool& snapshotUpdated, bool& consoleLinesUpdated);
-		bool ParseChatMessage(const std::string_view& lineStr, striter& parseEnd, std::shared_ptr<IConsoleLine>& parsed);
+		// Offsets in console.log only line up with offsets in m_FileLineBuf if the C runtime
+		// didn't have to translate line endings
+		bool m_FileOffsetsExact = true;
+
+		size_t ReadFileChunk(bool saveConsoleLogs);
+		void UpdateReadStats(size_t readCount);
+		void ConsumeFileLineBuf(size_t parseEnd);
 
 		struct CustomDeleters
 		{
@@ -51,7 +141,29 @@ namespace tf2_bot_detector
 		std::filesystem::path m_FileName;
 		std::unique_ptr<FILE, CustomDeleters> m_File;
 		time_point_t m_LastFileLoadAttempt{};
-		std::string m_FileLineBuf;
-		float m_ParseProgress = 0;
+		ConsoleLogPoller m_Poller;
+		bool m_ReadPending = false;
+		float m_IngestParseProgress = 0;
+
+		// Console log text that has been read but not parsed yet lives in
+		// [m_FileLineBufBegin, m_FileLineBuf->size()). Parsed text is only erased from the front
+		// once it makes up at least half the buffer, so every byte is moved at most once on average.
+		//
+		// Parsed lines point straight into the buffer instead of copying their text out of it, so
+		// it is only modified in place while nothing else references it. Otherwise, the unparsed
+		// tail moves to a new buffer and the old one goes away with the last line using it.
+		ConsoleTextSlab m_FileLineBuf;
+		size_t m_FileLineBufBegin = 0;
+		uint64_t m_FileLineBufBeginOffset = 0;   // Offset in console.log of m_FileLineBufBegin
+		size_t m_ReplacedFileLineBufs = 0;
+		std::string& GetWritableFileLineBuf();
+		size_t m_ReadSize;
+
+		ConsoleLogReadStats m_IngestReadStats;
+		std::chrono::steady_clock::time_point m_ReadRateWindowStart{};
+		size_t m_ReadRateWindowBytes = 0;
+
+		// Last, so the thread is gone before anything it uses
+		std::unique_ptr<IngestThread> m_Ingest;
 	};
 }
@@ -0,0 +1,27 @@
+#include "ConsoleLogPoller.h"
+
+using namespace tf2_bot_detector;
+
+auto ConsoleLogPoller::Poll(time_point_t now, std::optional<uint64_t> fileSize, bool readPending) -> WakeReason
+{
+	WakeReason reason = WakeReason::None;
+	if (fileSize && fileSize != m_LastSize)
+		reason = WakeReason::SizeChanged;
+	else if (readPending)
+		reason = WakeReason::ReadPending;
+	else if ((now - m_LastWakeTime) >= PERIODIC_READ_INTERVAL)
+		reason = WakeReason::Periodic;
+
+	if (fileSize)
+		m_LastSize = fileSize;
+
+	if (reason != WakeReason::None)
+		m_LastWakeTime = now;
+
+	return reason;
+}
+
+void ConsoleLogPoller::Reset()
+{
+	m_LastSize.reset();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <cstdint>
+#include <optional>
+
+namespace tf2_bot_detector
+{
+	// Decides when the ingest thread actually reads console.log. This is a poll. tf2 keeps
+	// console.log open and writes to it through the cache, and directory change notifications
+	// aren't raised for those writes until the file is flushed or closed, so they can't tell
+	// us when there is something new to read. The size of our own handle can, and it is cheap
+	// enough to check on every poll.
+	class ConsoleLogPoller final
+	{
+	public:
+		enum class WakeReason
+		{
+			None,          // Nothing seems to have changed
+			SizeChanged,   // console.log grew, or shrank if it was truncated
+			ReadPending,   // The last read didn't get through everything
+			Periodic,      // Nothing else woke us up for PERIODIC_READ_INTERVAL
+		};
+
+		// Safety net for when the size can't be determined, or changed and changed back
+		static constexpr duration_t PERIODIC_READ_INTERVAL = std::chrono::seconds(1);
+
+		// fileSize is the current size of the open console.log, nullopt if it couldn't be determined
+		WakeReason Poll(time_point_t now, std::optional<uint64_t> fileSize, bool readPending);
+
+		// Forget the last size we saw, the next poll with a known size wakes up
+		void Reset();
+
+	private:
+		std::optional<uint64_t> m_LastSize;
+		time_point_t m_LastWakeTime{};
+	};
+}
@@ -0,0 +1,505 @@
+#include "ConsoleLogReplay.h"
+#include "Actions/Actions.h"
+#include "Actions/RCONActionManager.h"
+#include "Config/ChatWrapperMatcher.h"
+#include "Config/ChatWrappers.h"
+#include "Config/PlayerListJSON.h"
+#include "Config/Settings.h"
+#include "ConsoleLog/ConsoleLineListener.h"
+#include "ConsoleLineCoalescer.h"
+#include "ConsoleLineParseStats.h"
+#include "ConsoleLogBulkParser.h"
+#include "ConsoleLogParser.h"
+#include "ConsoleLogTimestamps.h"
+#include "GlobalDispatcher.h"
+#include "IPlayer.h"
+#include "Log.h"
+#include "ModeratorLogic.h"
+#include "Platform/Platform.h"
+#include "WorldState.h"
+
+#include <mh/text/format.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	using replay_clock_t = std::chrono::steady_clock;
+
+	constexpr size_t READ_SIZE = 1024 * 1024;
+
+	// Gaps in the recording longer than this (game closed, alt-tabbed to the menu for an hour)
+	// are skipped over instead of being waited out when replaying in realtime.
+	constexpr duration_t MAX_REALTIME_GAP = 10s;
+
+	// Records the commands that would have been sent to the game. Actions are queued and
+	// throttled the same way RCONActionManager does it, but against the virtual clock.
+	class ReplayActionManager final : public IRCONActionManager
+	{
+	public:
+		void Update() override;
+		bool QueueAction(std::unique_ptr<IAction>&& action) override;
+
+		// There's no game to ask for status/lobby updates
+		void AddPeriodicActionGenerator(std::unique_ptr<IPeriodicActionGenerator>&& action) override {}
+
+		struct SentCommand
+		{
+			time_point_t m_Time{};
+			std::string m_Command;
+		};
+		std::vector<SentCommand> m_SentCommands;
+		size_t m_QueuedCounts[(int)ActionType::COUNT]{};
+		size_t m_RejectedCount = 0;
+
+	private:
+		static constexpr duration_t UPDATE_INTERVAL = std::chrono::milliseconds(250);
+
+		time_point_t m_LastUpdateTime{};
+		std::vector<std::unique_ptr<IAction>> m_Actions;
+		std::map<ActionType, time_point_t> m_LastTriggerTime;
+	};
+
+	bool ReplayActionManager::QueueAction(std::unique_ptr<IAction>&& action)
+	{
+		const ActionType curActionType = action->GetType();
+		if (const auto maxQueuedCount = action->GetMaxQueuedCount();
+			maxQueuedCount <= m_Actions.size())
+		{
+			const auto count = std::count_if(m_Actions.begin(), m_Actions.end(),
+				[&](const auto& queued) { return queued->GetType() == curActionType; });
+
+			if (size_t(count) >= maxQueuedCount)
+			{
+				m_RejectedCount++;
+				return false;
+			}
+		}
+
+		m_QueuedCounts[(int)curActionType]++;
+		m_Actions.push_back(std::move(action));
+		return true;
+	}
+
+	void ReplayActionManager::Update()
+	{
+		const auto curTime = GetVirtualTime();
+		if (curTime < (m_LastUpdateTime + UPDATE_INTERVAL))
+			return;
+
+		struct Writer final : ICommandWriter
+		{
+			void Write(std::string cmd, std::string args) override
+			{
+				if (!args.empty())
+				{
+					cmd += ' ';
+					cmd += args;
+				}
+
+				m_Manager->m_SentCommands.push_back({ m_Time, std::move(cmd) });
+			}
+
+			ReplayActionManager* m_Manager = nullptr;
+			time_point_t m_Time{};
+
+		} writer;
+
+		writer.m_Manager = this;
+		writer.m_Time = curTime;
+
+		bool actionTypes[(int)ActionType::COUNT]{};
+		for (auto it = m_Actions.begin(); it != m_Actions.end(); )
+		{
+			const IAction* action = it->get();
+			const ActionType type = action->GetType();
+			const auto minInterval = action->GetMinInterval();
+
+			if (minInterval.count() > 0 && (actionTypes[(int)type] || (curTime - m_LastTriggerTime[type]) < minInterval))
+			{
+				++it;
+				continue;
+			}
+
+			actionTypes[(int)type] = true;
+			action->WriteCommands(writer);
+			m_LastTriggerTime[type] = curTime;
+			it = m_Actions.erase(it);
+		}
+
+		m_LastUpdateTime = curTime;
+	}
+
+	class ReplayLineCounter final : public AutoConsoleLineListener
+	{
+	public:
+		using AutoConsoleLineListener::AutoConsoleLineListener;
+
+		void OnConsoleLineParsed(IWorldState& world, IConsoleLine& line) override { m_ParsedLines++; }
+		void OnConsoleLineUnparsed(IWorldState& world, const std::string_view& text) override { m_UnparsedLines++; }
+
+		uint64_t m_ParsedLines = 0;
+		uint64_t m_UnparsedLines = 0;
+	};
+
+	struct ReplayStage
+	{
+		const char* m_Name;
+		replay_clock_t::duration m_Time{};
+
+		template<typename TFunc>
+		void Run(TFunc&& func)
+		{
+			const auto startTime = replay_clock_t::now();
+			func();
+			m_Time += replay_clock_t::now() - startTime;
+		}
+	};
+
+	struct VirtualTimeScope
+	{
+		~VirtualTimeScope() { SetVirtualTimeOverride(std::nullopt); }
+	};
+
+	class ConsoleLogReplay final : public IConsoleLogReplay
+	{
+	public:
+		explicit ConsoleLogReplay(const ConsoleLogReplaySettings& replaySettings);
+
+		void Run(std::istream& log) override;
+		void LogResults() const override;
+
+		IWorldState& GetWorld() const override { return *m_World; }
+		IModeratorLogic& GetModeratorLogic() const override { return *m_ModLogic; }
+
+	private:
+		void AdvanceTo(time_point_t tick);
+		void RunTick();
+		void RunBulk(std::istream& log);
+		void RunStreaming(std::istream& log);
+
+		ConsoleLogReplaySettings m_ReplaySettings;
+		Settings m_Settings{ Settings::DefaultsOnly{} };
+		std::shared_ptr<IWorldState> m_World;
+		ReplayActionManager m_ActionManager;
+		std::unique_ptr<IModeratorLogic> m_ModLogic;
+		ConsoleLogParser m_Parser;
+		ReplayLineCounter m_LineCounter;
+
+		ReplayStage m_ReadStage{ "read" };
+		ReplayStage m_ParseStage{ "parse" };
+		ReplayStage m_DispatchStage{ "dispatch" };
+		ReplayStage m_WorldStage{ "world" };
+		ReplayStage m_ModLogicStage{ "moderator" };
+		ReplayStage m_ActionsStage{ "actions" };
+
+		replay_clock_t::time_point m_WallStartTime{};
+		replay_clock_t::duration m_WallDuration{};
+		size_t m_StartRAMUsage = 0;
+
+		uint64_t m_TotalBytes = 0;
+		std::optional<time_point_t> m_FirstTick;
+		std::optional<time_point_t> m_CurrentTick;
+		duration_t m_RecordedDuration{};  // Time covered by the log, not counting skipped gaps
+		uint64_t m_TickCount = 0;
+	};
+
+	std::shared_ptr<const ChatWrapperMatcher> LoadChatWrappers(const std::filesystem::path& fileName)
+	{
+		nlohmann::json json;
+		{
+			std::ifstream file(fileName, std::ios::binary);
+			if (!file.good())
+				throw std::runtime_error(mh::format("Failed to open {}", fileName));
+
+			file >> json;
+		}
+
+		return std::make_shared<ChatWrapperMatcher>(json.at("wrappers").get<ChatWrappers>());
+	}
+
+	// Everything else is set up from the settings, so they have to be right before anything is created
+	const Settings& ConfigureReplaySettings(Settings& settings, const ConsoleLogReplaySettings& replaySettings)
+	{
+		settings.m_AllowInternetUsage = false;
+		settings.m_Unsaved.m_ReadOnlyConfigs = true;
+		settings.m_Unsaved.m_CoalesceConsoleLines = replaySettings.m_CoalesceLines;
+		if (replaySettings.m_LocalSteamID.IsValid())
+			settings.m_LocalSteamIDOverride = replaySettings.m_LocalSteamID;
+
+		if (!replaySettings.m_ChatWrappersFileName.empty())
+			settings.m_Unsaved.m_ChatMsgWrappersMatcher = LoadChatWrappers(replaySettings.m_ChatWrappersFileName);
+		else
+			LogWarning("No chat wrappers given for the replay, wrapped chat messages will not be parsed");
+
+		return settings;
+	}
+
+	ConsoleLogReplay::ConsoleLogReplay(const ConsoleLogReplaySettings& replaySettings) :
+		m_ReplaySettings(replaySettings),
+		m_World(IWorldState::Create(ConfigureReplaySettings(m_Settings, replaySettings))),
+		m_ModLogic(IModeratorLogic::Create(*m_World, m_Settings, m_ActionManager)),
+		m_Parser(*m_World, m_Settings),
+		m_LineCounter(*m_World)
+	{
+	}
+
+	void ConsoleLogReplay::AdvanceTo(time_point_t tick)
+	{
+		if (m_CurrentTick)
+			m_RecordedDuration += std::clamp<duration_t>(tick - *m_CurrentTick, {}, MAX_REALTIME_GAP);
+		else
+			m_FirstTick = tick;
+
+		if (m_ReplaySettings.m_Realtime)
+			std::this_thread::sleep_until(m_WallStartTime + m_RecordedDuration);
+
+		m_CurrentTick = tick;
+		SetVirtualTimeOverride(tick);
+	}
+
+	// The same things the main window does every frame
+	void ConsoleLogReplay::RunTick()
+	{
+		m_WorldStage.Run([&]
+			{
+				// Only what is ready now. Waiting around for more is the main window's frame
+				// pacing, which would only slow us down here.
+				GetDispatcher().run();
+				m_World->Update();
+			});
+		m_ModLogicStage.Run([&] { m_ModLogic->Update(); });
+		m_ActionsStage.Run([&] { m_ActionManager.Update(); });
+		m_TickCount++;
+	}
+
+	void ConsoleLogReplay::Run(std::istream& log)
+	{
+		Log("Replaying {} ({}{})...", m_ReplaySettings.m_FileName,
+			m_ReplaySettings.m_Realtime ? "realtime" : "as fast as possible", m_ReplaySettings.m_BulkParse ? ", bulk parse" : "");
+
+		VirtualTimeScope virtualTimeScope;
+		m_WallStartTime = replay_clock_t::now();
+		m_StartRAMUsage = Platform::Processes::GetCurrentRAMUsage();
+		ConsoleLineParseProfiler::SetTimingEnabled(m_ReplaySettings.m_TimeParsers);
+		ConsoleLineParseProfiler::Reset();
+
+		// Console log timestamps only have a resolution of one second, so each second of the
+		// recording is treated as a single update of the main loop
+		if (m_ReplaySettings.m_BulkParse)
+			RunBulk(log);
+		else
+			RunStreaming(log);
+
+		m_WallDuration = replay_clock_t::now() - m_WallStartTime;
+	}
+
+	void ConsoleLogReplay::RunBulk(std::istream& log)
+	{
+		std::string text;
+		m_ReadStage.Run([&]
+			{
+				text.assign(std::istreambuf_iterator<char>(log), std::istreambuf_iterator<char>());
+				m_TotalBytes = text.size();
+			});
+
+		std::vector<PreparsedConsoleLine> lines;
+		ConsoleLogBulkParseStats bulkStats;
+		m_ParseStage.Run([&] { lines = ParseConsoleLogParallel(text, *m_World, m_ReplaySettings.m_ThreadCount, &bulkStats); });
+
+		Log("Bulk parsed {} lines ({} parsed, {} left for the main thread) in {} segments on {} threads in {:.3f} seconds",
+			bulkStats.m_LineCount, bulkStats.m_ParsedLineCount, bulkStats.m_DeferredLineCount,
+			bulkStats.m_SegmentCount, bulkStats.m_ThreadCount, to_seconds(bulkStats.m_ParseTime));
+
+		for (size_t begin = 0; begin < lines.size(); )
+		{
+			const auto tick = lines[begin].m_Timestamp;
+
+			size_t end = begin + 1;
+			while (end < lines.size() && lines[end].m_Timestamp == tick)
+				end++;
+
+			AdvanceTo(tick);
+			m_DispatchStage.Run([&] { m_Parser.FeedPreparsed(std::span(lines).subspan(begin, end - begin)); });
+			RunTick();
+
+			begin = end;
+		}
+	}
+
+	void ConsoleLogReplay::RunStreaming(std::istream& log)
+	{
+		std::string buf;
+		size_t fedEnd = 0;    // Everything before this has been handed to the parser
+		size_t scanPos = 0;   // Where to resume looking for timestamps
+		ConsoleLogTimestampDecoder timestampDecoder;
+
+		const auto FeedUntil = [&](size_t end)
+		{
+			m_ParseStage.Run([&] { m_Parser.Feed(std::string_view(buf).substr(fedEnd, end - fedEnd)); });
+			fedEnd = end;
+		};
+
+		while (log)
+		{
+			m_ReadStage.Run([&]
+				{
+					const size_t oldSize = buf.size();
+					buf.resize(oldSize + READ_SIZE);
+					log.read(buf.data() + oldSize, READ_SIZE);
+					buf.resize(oldSize + size_t(log.gcount()));
+					m_TotalBytes += size_t(log.gcount());
+				});
+
+			while (auto match = FindConsoleLogTimestamp(buf, scanPos))
+			{
+				scanPos = match->m_End;
+
+				const auto tick = timestampDecoder.ToTimePoint(*match);
+				if (tick == m_CurrentTick)
+					continue;
+
+				if (m_CurrentTick)
+				{
+					FeedUntil(match->m_Begin);
+					RunTick();
+				}
+
+				AdvanceTo(tick);
+			}
+
+			buf.erase(0, fedEnd);
+			scanPos -= fedEnd;
+			fedEnd = 0;
+		}
+
+		FeedUntil(buf.size());
+		RunTick();
+	}
+
+	void ConsoleLogReplay::LogResults() const
+	{
+		const auto wallSeconds = std::max(to_seconds(m_WallDuration), 1e-9);
+		const auto totalLines = m_LineCounter.m_ParsedLines + m_LineCounter.m_UnparsedLines;
+
+		Log("Replayed {} bytes, {} lines ({} parsed, {} unparsed) covering {} seconds of recording in {:.3f} seconds",
+			m_TotalBytes, totalLines, m_LineCounter.m_ParsedLines, m_LineCounter.m_UnparsedLines,
+			m_FirstTick ? to_seconds<int64_t>(*m_CurrentTick - *m_FirstTick) : 0, wallSeconds);
+		Log("Throughput: {:.0f} lines/s, {:.2f} MiB/s, {} updates", totalLines / wallSeconds,
+			m_TotalBytes / (1024.0 * 1024.0) / wallSeconds, m_TickCount);
+		{
+			const ConsoleLineCoalescerStats& coalescerStats = m_World->GetConsoleLineCoalescerStats();
+			Log("Coalescing {}: {} lines folded into {} summaries", m_ReplaySettings.m_CoalesceLines ? "on" : "off",
+				coalescerStats.m_LinesCoalesced, coalescerStats.m_SummariesEmitted);
+		}
+
+		for (const ReplayStage* stage : { &m_ReadStage, &m_ParseStage, &m_DispatchStage, &m_WorldStage, &m_ModLogicStage, &m_ActionsStage })
+		{
+			if (stage == &m_DispatchStage && !m_ReplaySettings.m_BulkParse)
+				continue; // Happens as part of parsing
+
+			const auto stageSeconds = to_seconds(stage->m_Time);
+			Log("    {:>10}: {:.3f} seconds ({:.1f}%)", stage->m_Name, stageSeconds, 100 * stageSeconds / wallSeconds);
+		}
+
+		{
+			const size_t endRAMUsage = Platform::Processes::GetCurrentRAMUsage();
+			Log("RAM usage: {:.1f} MiB ({:+.1f} MiB during replay)", endRAMUsage / (1024.0 * 1024.0),
+				(double(endRAMUsage) - double(m_StartRAMUsage)) / (1024.0 * 1024.0));
+		}
+
+		{
+			const ConsoleLineParseStats parseStats = ConsoleLineParseProfiler::GetStats();
+			if (m_ReplaySettings.m_TimeParsers)
+			{
+				Log("Parsers ({} lines, {} unparsed, {:.3f} seconds parsing):", parseStats.m_Lines, parseStats.m_UnparsedLines,
+					to_seconds(parseStats.m_ParseTime));
+			}
+			else
+			{
+				Log("Parsers ({} lines, {} unparsed, not timed):", parseStats.m_Lines, parseStats.m_UnparsedLines);
+			}
+
+			for (const ConsoleLineTypeParseStats& type : parseStats.m_Types)
+			{
+				if (type.m_Attempts == 0)
+					continue;
+
+				if (m_ReplaySettings.m_TimeParsers)
+				{
+					Log("    {:>32}: {:>9} attempts, {:>9} hits, {:>8.3f} ms total, {:>6} ns avg, {:>6} ns p99", type.m_TypeName,
+						type.m_Attempts, type.m_Hits, to_seconds(type.m_TotalTime) * 1000, type.GetAverageTime().count(),
+						type.m_P99Time.count());
+				}
+				else
+				{
+					Log("    {:>32}: {:>9} attempts, {:>9} hits", type.m_TypeName, type.m_Attempts, type.m_Hits);
+				}
+			}
+
+			if (!m_ReplaySettings.m_ParseStatsFileName.empty())
+			{
+				const nlohmann::json json = parseStats;
+				std::ofstream file(m_ReplaySettings.m_ParseStatsFileName, std::ios::trunc | std::ios::binary);
+				file << json.dump(1, '\t', true, nlohmann::detail::error_handler_t::replace) << '\n';
+				Log("Wrote parse stats to {}", m_ReplaySettings.m_ParseStatsFileName);
+			}
+		}
+
+		Log("Marked players:");
+		for (const IPlayer& player : m_World->GetPlayers())
+		{
+			if (auto marks = m_ModLogic->GetPlayerAttributes(player.GetSteamID()))
+				Log("    {}: {}", player, marks);
+		}
+
+		Log("Queued actions ({} rejected as duplicates):", m_ActionManager.m_RejectedCount);
+		for (int i = 0; i < (int)ActionType::COUNT; i++)
+		{
+			if (m_ActionManager.m_QueuedCounts[i] > 0)
+				Log("    {}: {}", mh::enum_fmt(ActionType(i)), m_ActionManager.m_QueuedCounts[i]);
+		}
+
+		Log("Commands that would have been sent ({}):", m_ActionManager.m_SentCommands.size());
+		for (const auto& cmd : m_ActionManager.m_SentCommands)
+			Log("    +{}s: {}", to_seconds<int64_t>(cmd.m_Time - m_FirstTick.value_or(cmd.m_Time)), cmd.m_Command);
+	}
+}
+
+std::unique_ptr<IConsoleLogReplay> IConsoleLogReplay::Create(const ConsoleLogReplaySettings& replaySettings)
+{
+	return std::make_unique<ConsoleLogReplay>(replaySettings);
+}
+
+int tf2_bot_detector::RunConsoleLogReplay(const ConsoleLogReplaySettings& replaySettings) try
+{
+	std::ifstream file(replaySettings.m_FileName, std::ios::binary);
+	if (!file.good())
+	{
+		LogError("Failed to open {} for replay", replaySettings.m_FileName);
+		return 1;
+	}
+
+	const auto replay = IConsoleLogReplay::Create(replaySettings);
+	replay->Run(file);
+	replay->LogResults();
+	return 0;
+}
+catch (...)
+{
+	LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to replay {}", replaySettings.m_FileName);
+	return 1;
+}
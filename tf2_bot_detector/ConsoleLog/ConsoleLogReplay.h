@@ -0,0 +1,63 @@
+#pragma once
+
+#include "SteamID.h"
+
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+
+namespace tf2_bot_detector
+{
+	class IModeratorLogic;
+	class IWorldState;
+
+	struct ConsoleLogReplaySettings
+	{
+		std::filesystem::path m_FileName;
+		bool m_Realtime = false;   // Play back at the recorded pace instead of as fast as possible
+		SteamID m_LocalSteamID;    // If valid, overrides the auto detected local SteamID
+
+		// The chat wrappers tf2 was using when the log was captured, in the same format they are
+		// saved in next to the generated localization files (__tf2bd_chat_msg_wrappers.json).
+		// Without them, wrapped chat messages can't be parsed.
+		std::filesystem::path m_ChatWrappersFileName;
+
+		// Parse the whole log up front on m_ThreadCount threads (0 = one per core), see ParseConsoleLogParallel().
+		// Chat wrappers aren't applied when bulk parsing.
+		bool m_BulkParse = false;
+		unsigned m_ThreadCount = 0;
+
+		// If set, the per line type parse stats are written here as JSON, see ConsoleLineParseProfiler
+		std::filesystem::path m_ParseStatsFileName;
+
+		// Time each parse attempt, see ConsoleLineParseProfiler::SetTimingEnabled(). Slows parsing down a little.
+		bool m_TimeParsers = false;
+
+		// Fold voice/split packet/user message lines into summaries, see Settings::m_CoalesceConsoleLines
+		bool m_CoalesceLines = false;
+	};
+
+	// Streams a captured console.log through ConsoleLogParser, WorldState and ModeratorLogic
+	// without a running game. Commands are recorded instead of being sent over RCON. Only the
+	// defaults are used for settings, settings.json is never read or written, and the
+	// playerlist is only ever read.
+	class IConsoleLogReplay
+	{
+	public:
+		virtual ~IConsoleLogReplay() = default;
+
+		static std::unique_ptr<IConsoleLogReplay> Create(const ConsoleLogReplaySettings& replaySettings);
+
+		// Replays everything in log. Only call this once.
+		virtual void Run(std::istream& log) = 0;
+
+		// Throughput, time spent in each stage, parse stats, and the marks/actions that came out of it
+		virtual void LogResults() const = 0;
+
+		virtual IWorldState& GetWorld() const = 0;
+		virtual IModeratorLogic& GetModeratorLogic() const = 0;
+	};
+
+	// Replays replaySettings.m_FileName and logs the results. Returns the process exit code.
+	int RunConsoleLogReplay(const ConsoleLogReplaySettings& replaySettings);
+}
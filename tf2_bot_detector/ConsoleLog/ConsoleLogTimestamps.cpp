@@ -0,0 +1,203 @@
+#include "ConsoleLogTimestamps.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	// \nMM/DD/YYYY - HH:MM:SS:[ \n]
+	constexpr size_t TIMESTAMP_LENGTH = 24;
+
+	constexpr int SECONDS_PER_DAY = 24 * 60 * 60;
+
+	// Half of the window around a DST change where we don't trust the cached offsets. Generous,
+	// since mktime() is free to resolve skipped/repeated local times however it likes.
+	constexpr int DST_TRANSITION_MARGIN = 2 * 60 * 60;
+
+	inline bool IsDigit(char c)
+	{
+		return c >= '0' && c <= '9';
+	}
+
+	inline bool ParseDigits(const char* str, size_t count, int& out)
+	{
+		int value = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (!IsDigit(str[i]))
+				return false;
+
+			value = (value * 10) + (str[i] - '0');
+		}
+
+		out = value;
+		return true;
+	}
+
+	bool TryParseTimestamp(const char* str, ConsoleLogTimestamp& ts)
+	{
+		// str[0] is known to be '\n'
+		return
+			ParseDigits(str + 1, 2, ts.m_Month) &&
+			str[3] == '/' &&
+			ParseDigits(str + 4, 2, ts.m_Day) &&
+			str[6] == '/' &&
+			ParseDigits(str + 7, 4, ts.m_Year) &&
+			str[11] == ' ' && str[12] == '-' && str[13] == ' ' &&
+			ParseDigits(str + 14, 2, ts.m_Hour) &&
+			str[16] == ':' &&
+			ParseDigits(str + 17, 2, ts.m_Minute) &&
+			str[19] == ':' &&
+			ParseDigits(str + 20, 2, ts.m_Second) &&
+			str[22] == ':' &&
+			(str[23] == ' ' || str[23] == '\n');
+	}
+
+	std::time_t ToTimeT(int year, int month, int day, int secondOfDay)
+	{
+		std::tm time{};
+		time.tm_isdst = -1;
+		time.tm_mon = month - 1;
+		time.tm_mday = day;
+		time.tm_year = year - 1900;
+		time.tm_hour = secondOfDay / 3600;
+		time.tm_min = (secondOfDay / 60) % 60;
+		time.tm_sec = secondOfDay % 60;
+
+		return std::mktime(&time);
+	}
+}
+
+std::optional<ConsoleLogTimestamp> tf2_bot_detector::FindConsoleLogTimestamp(
+	const std::string_view& buffer, size_t startOffset)
+{
+	const char* const bufBegin = buffer.data();
+	const char* const bufEnd = bufBegin + buffer.size();
+	const char* cursor = bufBegin + std::min(startOffset, buffer.size());
+
+	ConsoleLogTimestamp ts;
+	while (size_t(bufEnd - cursor) >= TIMESTAMP_LENGTH)
+	{
+		// Only newlines that still have a full timestamp's worth of characters after them
+		// can start a match. If the last one is incomplete, a later read will complete it.
+		const size_t searchLength = size_t(bufEnd - cursor) - (TIMESTAMP_LENGTH - 1);
+		auto newline = static_cast<const char*>(std::memchr(cursor, '\n', searchLength));
+		if (!newline)
+			break;
+
+		if (TryParseTimestamp(newline, ts))
+		{
+			ts.m_Begin = size_t(newline - bufBegin);
+			ts.m_End = ts.m_Begin + TIMESTAMP_LENGTH;
+			return ts;
+		}
+
+		cursor = newline + 1;
+	}
+
+	return std::nullopt;
+}
+
+time_point_t ConsoleLogTimestamp::ToTimePoint() const
+{
+	std::tm time{};
+	time.tm_isdst = -1;
+	time.tm_mon = m_Month - 1;
+	time.tm_mday = m_Day;
+	time.tm_year = m_Year - 1900;
+	time.tm_hour = m_Hour;
+	time.tm_min = m_Minute;
+	time.tm_sec = m_Second;
+
+	return tfbd_clock_t::from_time_t(std::mktime(&time));
+}
+
+time_point_t ConsoleLogTimestampDecoder::ToTimePoint(const ConsoleLogTimestamp& ts)
+{
+	// Leave anything mktime() would have to normalize (leap seconds, 02/30...) to mktime()
+	if (ts.m_Hour >= 24 || ts.m_Minute >= 60 || ts.m_Second >= 60)
+		return FullConversion(ts);
+
+	if ((m_Month == 0 || ts.m_Year != m_Year || ts.m_Month != m_Month || ts.m_Day != m_Day) && !UpdateDay(ts))
+		return FullConversion(ts);
+
+	const int secondOfDay = (ts.m_Hour * 3600) + (ts.m_Minute * 60) + ts.m_Second;
+	if (secondOfDay >= m_TransitionBegin && secondOfDay < m_TransitionEnd)
+		return FullConversion(ts);
+
+	const int64_t offset = secondOfDay < m_TransitionBegin ? m_OffsetBefore : m_OffsetAfter;
+	return time_point_t(std::chrono::seconds(m_DayBegin + secondOfDay - offset));
+}
+
+bool ConsoleLogTimestampDecoder::UpdateDay(const ConsoleLogTimestamp& ts)
+{
+	using namespace std::chrono;
+
+	m_Month = 0;
+
+	const year_month_day date{ year(ts.m_Year), month(unsigned(ts.m_Month)), day(unsigned(ts.m_Day)) };
+	if (!date.ok())
+		return false;
+
+	const int64_t dayBegin = duration_cast<seconds>(sys_days(date).time_since_epoch()).count();
+	const auto GetOffset = [&](int secondOfDay) -> std::optional<int64_t>
+	{
+		m_FullConversions++;
+		const std::time_t time = ToTimeT(ts.m_Year, ts.m_Month, ts.m_Day, secondOfDay);
+		if (time == std::time_t(-1))
+			return std::nullopt;
+
+		return dayBegin + secondOfDay - int64_t(time);
+	};
+
+	const auto offsetBefore = GetOffset(0);
+	const auto offsetAfter = GetOffset(SECONDS_PER_DAY - 1);
+	if (!offsetBefore || !offsetAfter)
+		return false;
+
+	m_TransitionBegin = m_TransitionEnd = SECONDS_PER_DAY;
+	if (*offsetBefore != *offsetAfter)
+	{
+		// DST starts or ends today. Find roughly where, and leave a margin around it for mktime().
+		int before = 0;
+		int after = SECONDS_PER_DAY - 1;
+		while ((after - before) > 1)
+		{
+			const int mid = before + (after - before) / 2;
+			if (GetOffset(mid) == offsetBefore)
+				before = mid;
+			else
+				after = mid;
+		}
+
+		m_TransitionBegin = std::max(after - DST_TRANSITION_MARGIN, 0);
+		m_TransitionEnd = std::min(after + DST_TRANSITION_MARGIN, SECONDS_PER_DAY);
+
+		// Make sure the offsets on both sides of the margin are what we think they are. If
+		// they aren't (more than one change in a day?) just do it the slow way all day.
+		if ((m_TransitionBegin > 0 && GetOffset(m_TransitionBegin - 1) != offsetBefore) ||
+			(m_TransitionEnd < SECONDS_PER_DAY && GetOffset(m_TransitionEnd) != offsetAfter))
+		{
+			m_TransitionBegin = 0;
+			m_TransitionEnd = SECONDS_PER_DAY;
+		}
+	}
+
+	m_Year = ts.m_Year;
+	m_Month = ts.m_Month;
+	m_Day = ts.m_Day;
+	m_DayBegin = dayBegin;
+	m_OffsetBefore = *offsetBefore;
+	m_OffsetAfter = *offsetAfter;
+	return true;
+}
+
+time_point_t ConsoleLogTimestampDecoder::FullConversion(const ConsoleLogTimestamp& ts)
+{
+	m_FullConversions++;
+	return ts.ToTimePoint();
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace tf2_bot_detector
+{
+	// The "\nMM/DD/YYYY - HH:MM:SS:" prefix that tf2 writes in front of every line of console.log.
+	struct ConsoleLogTimestamp
+	{
+		size_t m_Begin{};   // Offset of the leading '\n'
+		size_t m_End{};     // Offset one past the ':' and the trailing ' ' or '\n'
+
+		int m_Month{};
+		int m_Day{};
+		int m_Year{};
+		int m_Hour{};
+		int m_Minute{};
+		int m_Second{};
+
+		// Interprets the timestamp as local time, like tf2 does when writing it. Goes through
+		// std::mktime every time, use a ConsoleLogTimestampDecoder for consecutive lines.
+		time_point_t ToTimePoint() const;
+	};
+
+	// Same results as ConsoleLogTimestamp::ToTimePoint(), but std::mktime (and the CRT's
+	// timezone state) is only consulted when the date changes. Everything in between is
+	// integer arithmetic against the cached start of the local day and its UTC offset.
+	// On the (rare) days with a DST change, timestamps within a couple of hours of the
+	// change still get the full conversion.
+	class ConsoleLogTimestampDecoder final
+	{
+	public:
+		time_point_t ToTimePoint(const ConsoleLogTimestamp& ts);
+
+		uint64_t GetFullConversionCount() const { return m_FullConversions; }
+
+	private:
+		bool UpdateDay(const ConsoleLogTimestamp& ts);
+		time_point_t FullConversion(const ConsoleLogTimestamp& ts);
+
+		int m_Year = 0;
+		int m_Month = 0;              // 0 if nothing is cached
+		int m_Day = 0;
+
+		int64_t m_DayBegin = 0;       // Local midnight, as seconds since the epoch if local time was UTC
+		int64_t m_OffsetBefore = 0;   // Local time - UTC, in seconds, before m_TransitionBegin
+		int64_t m_OffsetAfter = 0;    // Local time - UTC, in seconds, from m_TransitionEnd onwards
+		int m_TransitionBegin = 0;    // Seconds into the day [begin, end) that always use FullConversion()
+		int m_TransitionEnd = 0;
+
+		uint64_t m_FullConversions = 0;
+	};
+
+	// Finds the first timestamp in buffer that begins at or after startOffset. Matches
+	// exactly what \n(\d\d)\/(\d\d)\/(\d\d\d\d) - (\d\d):(\d\d):(\d\d):[ \n] would, but
+	// only looks at the bytes following each '\n' instead of running a regex engine.
+	std::optional<ConsoleLogTimestamp> FindConsoleLogTimestamp(const std::string_view& buffer, size_t startOffset = 0);
+}
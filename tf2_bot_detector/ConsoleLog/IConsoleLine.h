@@ -1,9 +1,12 @@
 #pragma once
 
 #include "Clock.h"
+#include "ConsoleLineParseStats.h"
+#include "ConsoleLineText.h"
 
 #include <list>
 #include <memory>
+#include <span>
 #include <string_view>
 
 namespace tf2_bot_detector
@@ -32,9 +35,12 @@ namespace tf2_bot_detector
 		KillNotification,
 		CvarlistConvar,
 		VoiceReceive,
+		VoiceReceiveSummary,
 		EdictUsage,
 		SplitPacket,
+		SplitPacketSummary,
 		SVC_UserMessage,
+		SVCUserMessageSummary,
 		ConfigExec,
 		TeamsSwitched,
 		Connecting,
@@ -63,6 +69,9 @@ namespace tf2_bot_detector
 		NetChannelTotal,
 	};
 
+	// Must be kept pointing at the last ConsoleLineType
+	inline constexpr size_t CONSOLE_LINE_TYPE_COUNT = size_t(ConsoleLineType::NetChannelTotal) + 1;
+
 	enum class ConsoleLineOrdering
 	{
 		Auto,
@@ -70,11 +79,33 @@ namespace tf2_bot_detector
 		Last,
 	};
 
+	// A cheap literal test that a line must pass before a line type's TryParse is even
+	// attempted. Used by IConsoleLine::ParseConsoleLine to narrow down the candidate parsers.
+	struct ConsoleLineParseHint
+	{
+		enum class Type
+		{
+			Prefix,          // The line starts with m_Text
+			TrimmedPrefix,   // The line starts with m_Text, after any leading whitespace
+			Contains,        // m_Text appears anywhere in the line
+		};
+
+		static constexpr ConsoleLineParseHint Prefix(std::string_view text) { return { Type::Prefix, text }; }
+		static constexpr ConsoleLineParseHint TrimmedPrefix(std::string_view text) { return { Type::TrimmedPrefix, text }; }
+		static constexpr ConsoleLineParseHint Contains(std::string_view text) { return { Type::Contains, text }; }
+
+		Type m_Type;
+		std::string_view m_Text;
+	};
+
 	struct ConsoleLineTryParseArgs
 	{
 		std::string_view m_Text;
 		time_point_t m_Timestamp;
 		IWorldState& m_World;
+
+		// If set, m_Text points into this slab and lines can reference it instead of copying, see ConsoleLineText
+		const ConsoleTextSlab* m_TextSlab = nullptr;
 	};
 
 	class IConsoleLine : public std::enable_shared_from_this<IConsoleLine>
@@ -94,7 +125,15 @@ namespace tf2_bot_detector
 		};
 		virtual void Print(const PrintArgs& args) const = 0;
 
-		static std::shared_ptr<IConsoleLine> ParseConsoleLine(const std::string_view& text, time_point_t timestamp, IWorldState& world);
+		static std::shared_ptr<IConsoleLine> ParseConsoleLine(const std::string_view& text, time_point_t timestamp, IWorldState& world,
+			const ConsoleTextSlab* textSlab = nullptr);
+
+		// Like ParseConsoleLine(), but never touches world, so it is safe to call from any thread.
+		// If a line type that needs the world state would have to be tried, gives up, returns
+		// nullptr and sets needsWorldState. The line then has to go through ParseConsoleLine()
+		// on the main thread, in order with everything else.
+		static std::shared_ptr<IConsoleLine> ParseConsoleLineStateless(const std::string_view& text,
+			time_point_t timestamp, IWorldState& world, bool& needsWorldState, const ConsoleTextSlab* textSlab = nullptr);
 
 		time_point_t GetTimestamp() const { return m_Timestamp; }
 
@@ -105,8 +144,17 @@ namespace tf2_bot_detector
 			TryParseFunc m_TryParseFunc = nullptr;
 			const std::type_info* m_TypeInfo = nullptr;
 
-			size_t m_AutoParseSuccessCount = 0;
+			// Unique per line type. Candidates that pass the same kind of hint are tried in this order.
+			ConsoleLineType m_Type{};
+
+			// If empty, TryParse is attempted for every line
+			std::span<const ConsoleLineParseHint> m_ParseHints;
+
+			ConsoleLineParseProfiler::TypeCounters* m_Counters = nullptr;
 			bool m_AutoParse = true;
+
+			// TryParse looks things up in ConsoleLineTryParseArgs::m_World
+			bool m_UsesWorldState = false;
 		};
 
 		//static const ConsoleLineTypeData* GetTypeData() { return s_TypeData; }
@@ -115,9 +163,15 @@ namespace tf2_bot_detector
 	private:
 		time_point_t m_Timestamp;
 
+		static std::shared_ptr<IConsoleLine> ParseConsoleLine(const std::string_view& text, time_point_t timestamp,
+			IWorldState& world, const ConsoleTextSlab* textSlab, bool* needsWorldState);
+		static std::shared_ptr<IConsoleLine> TryParseConsoleLine(const ConsoleLineTryParseArgs& args,
+			bool* needsWorldState, bool timingEnabled);
+
+		struct DispatchTable;
 		static std::list<ConsoleLineTypeData>& GetTypeData();
+		static DispatchTable& GetDispatchTable();
 		inline static ConsoleLineTypeData* s_TypeData = nullptr;
-		inline static size_t s_TotalParseCount = 0;
 	};
 
 	template<typename TSelf, bool AutoParse = true>
@@ -127,15 +181,36 @@ namespace tf2_bot_detector
 		ConsoleLineBase(time_point_t timestamp) : IConsoleLine(timestamp) {}
 
 	private:
+		static constexpr std::span<const ConsoleLineParseHint> GetParseHints()
+		{
+			if constexpr (requires { TSelf::PARSE_HINTS; })
+				return TSelf::PARSE_HINTS;
+			else
+				return {};
+		}
+
+		static constexpr bool ParseUsesWorldState()
+		{
+			if constexpr (requires { TSelf::PARSE_USES_WORLD_STATE; })
+				return TSelf::PARSE_USES_WORLD_STATE;
+			else
+				return false;
+		}
+
 		struct AutoRegister
 		{
 			AutoRegister()
 			{
+				static_assert(size_t(TSelf::TYPE) < CONSOLE_LINE_TYPE_COUNT, "CONSOLE_LINE_TYPE_COUNT is out of date");
+
 				AddTypeData(ConsoleLineTypeData
 					{
 						.m_TryParseFunc = &TSelf::TryParse,
 						.m_TypeInfo = &typeid(TSelf),
-						.m_AutoParse = AutoParse
+						.m_Type = TSelf::TYPE,
+						.m_ParseHints = GetParseHints(),
+						.m_AutoParse = AutoParse,
+						.m_UsesWorldState = ParseUsesWorldState(),
 					});
 			}
 
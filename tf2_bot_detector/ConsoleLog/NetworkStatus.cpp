@@ -9,9 +9,6 @@ using namespace tf2_bot_detector;
 using namespace std::string_literals;
 using namespace std::string_view_literals;
 
-// net_status
-static std::regex s_DataPerClientOut(R"regex(           per client out (\d+\.\d), in (\d+\.\d) kB\/s)regex", std::regex::optimize);
-
 SplitPacketLine::SplitPacketLine(time_point_t timestamp, SplitPacket packet) :
 	BaseClass(timestamp), m_Packet(std::move(packet))
 {
@@ -19,9 +16,7 @@ SplitPacketLine::SplitPacketLine(time_point_t timestamp, SplitPacket packet) :
 
 std::shared_ptr<IConsoleLine> SplitPacketLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static std::regex s_Regex(R"regex(<-- \[(.{3})\] Split packet +(\d+)\/ +(\d+) seq +(\d+) size +(\d+) mtu +(\d+) from ([0-9.:a-fA-F]+:\d+))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<7> result; StaticRegex::FullMatch<ConsoleLinePatterns::SplitPacket>(args.m_Text, result))
 	{
 		SplitPacket packet;
 
@@ -95,9 +90,7 @@ NetStatusConfigLine::NetStatusConfigLine(time_point_t timestamp,
 
 std::shared_ptr<IConsoleLine> NetStatusConfigLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(- Config: (.*), (.*), (\d+) connections)regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (StaticRegex::Groups<3> result; StaticRegex::FullMatch<ConsoleLinePatterns::NetStatusConfig>(args.m_Text, result))
 	{
 		const std::string_view playerModeStr(&*result[1].first, result[1].length());
 		PlayerMode playerMode;
@@ -140,19 +133,10 @@ void NetStatusConfigLine::Print(const PrintArgs& args) const
 		m_ConnectionCount);
 }
 
-bool NetChannelDualFloatLineBase::TryParse(const std::string_view& text,
-	const std::string_view& pattern, float& f0, float& f1)
+void NetChannelDualFloatLineBase::ParseFloats(const StaticRegex::Groups<2>& match, float& f0, float& f1)
 {
-	const std::regex s_Regex(pattern.data(), pattern.data() + pattern.size());
-
-	if (svmatch result; std::regex_match(text.begin(), text.end(), result, s_Regex))
-	{
-		from_chars_throw(result[1], f0);
-		from_chars_throw(result[2], f1);
-		return true;
-	}
-
-	return false;
+	from_chars_throw(match[1], f0);
+	from_chars_throw(match[2], f1);
 }
 
 void NetChannelDualFloatLineBase::Print(const IConsoleLine::PrintArgs& args, const std::string_view& fmtStr) const
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ConsoleLog/ConsoleLinePatterns.h"
 #include "ConsoleLog/IConsoleLine.h"
 
 #include <string>
@@ -47,10 +48,12 @@ namespace tf2_bot_detector
 		SplitPacketLine(time_point_t timestamp, SplitPacket packet);
 
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("<-- [") };
 
 		const SplitPacket& GetSplitPacket() const { return m_Packet; }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::SplitPacket; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::SplitPacket;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -77,8 +80,10 @@ namespace tf2_bot_detector
 
 		NetStatusConfigLine(time_point_t timestamp, PlayerMode playerMode, ServerMode serverMode, unsigned connectionCount);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("- Config: ") };
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::NetStatusConfig; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::NetStatusConfig;
+		ConsoleLineType GetType() const override { return TYPE; }
 		bool ShouldPrint() const override { return false; }
 		void Print(const PrintArgs& args) const override;
 
@@ -98,7 +103,7 @@ namespace tf2_bot_detector
 		constexpr NetChannelDualFloatLineBase(float f0, float f1) : m_Float0(f0), m_Float1(f1) {}
 
 	protected:
-		static bool TryParse(const std::string_view& text, const std::string_view& pattern, float& f0, float& f1);
+		static void ParseFloats(const StaticRegex::Groups<2>& match, float& f0, float& f1);
 		void Print(const IConsoleLine::PrintArgs& args, const std::string_view& fmtStr) const;
 
 		float GetFloat0() const { return m_Float0; }
@@ -117,8 +122,12 @@ namespace tf2_bot_detector
 	public:
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args)
 		{
-			if (float f0, f1; NetChannelDualFloatLineBase::TryParse(args.m_Text, TSelf::REGEX_PATTERN, f0, f1))
+			if (StaticRegex::Groups<2> result; StaticRegex::FullMatch<typename TSelf::Pattern>(args.m_Text, result))
+			{
+				float f0, f1;
+				NetChannelDualFloatLineBase::ParseFloats(result, f0, f1);
 				return std::make_shared<TSelf>(args.m_Timestamp, f0, f1);
+			}
 
 			return nullptr;
 		}
@@ -149,10 +158,12 @@ namespace tf2_bot_detector
 		float GetLatency() const { return GetFloat0(); }
 		float GetLoss() const { return GetFloat1(); }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::NetChannelLatencyLoss; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::NetChannelLatencyLoss;
+		ConsoleLineType GetType() const override { return TYPE; }
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- latency: {.1f}, loss {.2f}";
-		static constexpr std::string_view REGEX_PATTERN = R"regex(- latency: (\d+\.\d+), loss (\d+\.\d+))regex";
+		using Pattern = ConsoleLinePatterns::NetChannelLatencyLoss;
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("- latency: ") };
 	};
 
 	class NetChannelPacketsLine final : public NetChannelDualFloatLine<NetChannelPacketsLine>
@@ -168,10 +179,12 @@ namespace tf2_bot_detector
 		float GetInPacketsPerSecond() const { return GetFloat0(); }
 		float GetOutPacketsPerSecond() const { return GetFloat1(); }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::NetChannelPackets; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::NetChannelPackets;
+		ConsoleLineType GetType() const override { return TYPE; }
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- packets: in {.1f}/s, out {.1f}/s";
-		static constexpr std::string_view REGEX_PATTERN = R"regex(- packets: in (\d+\.\d+)\/s, out (\d+\.\d+)\/s)regex";
+		using Pattern = ConsoleLinePatterns::NetChannelPackets;
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("- packets: ") };
 	};
 
 	class NetChannelChokeLine final : public NetChannelDualFloatLine<NetChannelChokeLine>
@@ -185,10 +198,12 @@ namespace tf2_bot_detector
 		float GetInPercentChoke() const { return GetFloat0(); }
 		float GetOutPercentChoke() const { return GetFloat1(); }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::NetChannelChoke; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::NetChannelChoke;
+		ConsoleLineType GetType() const override { return TYPE; }
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- choke: in {.2f}, out {.2f}";
-		static constexpr std::string_view REGEX_PATTERN = R"regex(- choke: in (\d+\.\d+), out (\d+\.\d+))regex";
+		using Pattern = ConsoleLinePatterns::NetChannelChoke;
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("- choke: ") };
 	};
 
 	class NetChannelFlowLine final : public NetChannelDualFloatLine<NetChannelFlowLine>
@@ -204,10 +219,12 @@ namespace tf2_bot_detector
 		float GetInKBps() const { return GetFloat0(); }
 		float GetOutKBps() const { return GetFloat1(); }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::NetChannelFlow; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::NetChannelFlow;
+		ConsoleLineType GetType() const override { return TYPE; }
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- flow: in {.1f}, out {.1f} KB/s";
-		static constexpr std::string_view REGEX_PATTERN = R"regex(- flow: in (\d+\.\d+), out (\d+\.\d+) kB\/s)regex";
+		using Pattern = ConsoleLinePatterns::NetChannelFlow;
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("- flow: ") };
 	};
 
 	class NetChannelTotalLine final : public NetChannelDualFloatLine<NetChannelTotalLine>
@@ -223,10 +240,12 @@ namespace tf2_bot_detector
 		float GetInMB() const { return GetFloat0(); }
 		float GetOutMB() const { return GetFloat1(); }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::NetChannelTotal; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::NetChannelTotal;
+		ConsoleLineType GetType() const override { return TYPE; }
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- total: in {.1f}, out {.1f} MB";
-		static constexpr std::string_view REGEX_PATTERN = R"regex(- total: in (\d+\.\d+), out (\d+\.\d+) MB)regex";
+		using Pattern = ConsoleLinePatterns::NetChannelTotal;
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("- total: ") };
 	};
 
 	class NetLatencyLine final : public NetChannelDualFloatLine<NetLatencyLine>
@@ -242,10 +261,12 @@ namespace tf2_bot_detector
 		float GetInLatency() const { return GetFloat1(); }
 		float GetOutLatency() const { return GetFloat0(); }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::NetLatency; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::NetLatency;
+		ConsoleLineType GetType() const override { return TYPE; }
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- Latency: avg out {.2f}s, in {.2f}s";
-		static constexpr std::string_view REGEX_PATTERN = R"regex(- Latency: avg out (\d+\.\d+)s, in (\d+\.\d+)s)regex";
+		using Pattern = ConsoleLinePatterns::NetLatency;
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("- Latency: ") };
 	};
 
 	class NetLossLine final : public NetChannelDualFloatLine<NetLossLine>
@@ -261,10 +282,12 @@ namespace tf2_bot_detector
 		float GetInLossPercent() const { return GetFloat1(); }
 		float GetOutLossPercent() const { return GetFloat0(); }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::NetLoss; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::NetLoss;
+		ConsoleLineType GetType() const override { return TYPE; }
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- Loss:    avg out {.1f}, in {.1f}";
-		static constexpr std::string_view REGEX_PATTERN = R"regex(- Loss:    avg out (\d+\.\d+), in (\d+\.\d+))regex";
+		using Pattern = ConsoleLinePatterns::NetLoss;
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("- Loss: ") };
 	};
 
 	class NetPacketsTotalLine final : public NetChannelDualFloatLine<NetPacketsTotalLine>
@@ -280,10 +303,12 @@ namespace tf2_bot_detector
 		float GetInPacketsPerSecond() const { return GetFloat1(); }
 		float GetOutPacketsPerSecond() const { return GetFloat0(); }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::NetPacketsTotal; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::NetPacketsTotal;
+		ConsoleLineType GetType() const override { return TYPE; }
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- Packets: net total out  {.1f}/s, in {.1f}/s";
-		static constexpr std::string_view REGEX_PATTERN = R"regex(- Packets: net total out  (\d+\.\d)\/s, in (\d+\.\d)\/s)regex";
+		using Pattern = ConsoleLinePatterns::NetPacketsTotal;
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("- Packets: ") };
 	};
 
 	class NetPacketsPerClientLine final : public NetChannelDualFloatLine<NetPacketsPerClientLine>
@@ -299,10 +324,12 @@ namespace tf2_bot_detector
 		float GetInPacketsPerSecond() const { return GetFloat1(); }
 		float GetOutPacketsPerSecond() const { return GetFloat0(); }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::NetPacketsPerClient; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::NetPacketsPerClient;
+		ConsoleLineType GetType() const override { return TYPE; }
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "           per client out {.1f}/s, in {.1f}/s";
-		static constexpr std::string_view REGEX_PATTERN = R"regex(           per client out (\d+\.\d)\/s, in (\d+\.\d)\/s)regex";
+		using Pattern = ConsoleLinePatterns::NetPacketsPerClient;
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("           per client out ") };
 	};
 
 	class NetDataTotalLine final : public NetChannelDualFloatLine<NetDataTotalLine>
@@ -318,10 +345,12 @@ namespace tf2_bot_detector
 		float GetInKBps() const { return GetFloat1(); }
 		float GetOutKBps() const { return GetFloat0(); }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::NetDataTotal; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::NetDataTotal;
+		ConsoleLineType GetType() const override { return TYPE; }
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- Data:    net total out  {.1f}, in {.1f} kB/s";
-		static constexpr std::string_view REGEX_PATTERN = R"regex(- Data:    net total out  (\d+\.\d), in (\d+\.\d) kB\/s)regex";
+		using Pattern = ConsoleLinePatterns::NetDataTotal;
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("- Data: ") };
 	};
 
 	class NetDataPerClientLine final : public NetChannelDualFloatLine<NetDataPerClientLine>
@@ -337,9 +366,11 @@ namespace tf2_bot_detector
 		float GetInKBps() const { return GetFloat1(); }
 		float GetOutKBps() const { return GetFloat0(); }
 
-		ConsoleLineType GetType() const override { return ConsoleLineType::NetDataPerClient; }
+		static constexpr ConsoleLineType TYPE = ConsoleLineType::NetDataPerClient;
+		ConsoleLineType GetType() const override { return TYPE; }
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "           per client out {.1f}, in {.1f} kB/s";
-		static constexpr std::string_view REGEX_PATTERN = R"regex(           per client out (\d+\.\d), in (\d+\.\d) kB\/s)regex";
+		using Pattern = ConsoleLinePatterns::NetDataPerClient;
+		static constexpr ConsoleLineParseHint PARSE_HINTS[] = { ConsoleLineParseHint::Prefix("           per client out ") };
 	};
 }
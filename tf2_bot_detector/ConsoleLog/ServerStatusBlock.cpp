@@ -0,0 +1,57 @@
+#include "ServerStatusBlock.h"
+#include "ConsoleLines.h"
+
+using namespace tf2_bot_detector;
+
+std::optional<ServerStatusBlock> ServerStatusBlockAssembler::AddLine(const IConsoleLine& line)
+{
+	std::optional<ServerStatusBlock> retVal;
+
+	switch (line.GetType())
+	{
+	case ConsoleLineType::PlayerStatusIP:
+	case ConsoleLineType::PlayerStatusMapPosition:
+	case ConsoleLineType::PlayerStatusCount:
+	case ConsoleLineType::EdictUsage:
+	{
+		// A header after rows means this is the next status dump already
+		if (m_State == State::Rows)
+			retVal = Flush();
+
+		m_State = State::Header;
+		m_Block.m_HasHeader = true;
+		break;
+	}
+
+	case ConsoleLineType::PlayerStatus:
+	{
+		auto& statusLine = static_cast<const ServerStatusPlayerLine&>(line);
+		m_State = State::Rows;
+		m_Block.m_Timestamp = statusLine.GetTimestamp();
+		m_Block.m_Players.push_back(statusLine.GetPlayerStatus().m_SteamID);
+		break;
+	}
+
+	case ConsoleLineType::PlayerStatusShort:
+		break;
+
+	default:
+		if (m_State != State::Idle)
+			retVal = Flush();
+
+		break;
+	}
+
+	return retVal;
+}
+
+std::optional<ServerStatusBlock> ServerStatusBlockAssembler::Flush()
+{
+	std::optional<ServerStatusBlock> retVal;
+	if (!m_Block.m_Players.empty())
+		retVal = std::move(m_Block);
+
+	m_Block = {};
+	m_State = State::Idle;
+	return retVal;
+}
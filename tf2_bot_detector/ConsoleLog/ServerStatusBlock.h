@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Clock.h"
+#include "SteamID.h"
+
+#include <optional>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	class IConsoleLine;
+
+	// Everything we care about from the output of one `status` command
+	struct ServerStatusBlock
+	{
+		bool m_HasHeader = false;          // False if we never saw the map/player count/edict lines before the rows
+		time_point_t m_Timestamp{};        // Of the last player row
+		std::vector<SteamID> m_Players;    // In the order the rows were printed
+	};
+
+	// Groups the lines printed by `status` back together. They are parsed one at a time like
+	// any other line, but they are only really meaningful as a whole: a status dump is
+	// the complete list of players on the server at that moment.
+	//
+	//   Idle   --- ip/map/player count/edict line --->  Header
+	//   Header --- player row ------------------------>  Rows
+	//   Rows   --- any other parsed line, end of input --> Idle (block complete)
+	//
+	// Lines that don't parse (the "hostname", "tags" and "# userid name..." lines, bots) are
+	// ignored, so they neither start nor end a block.
+	class ServerStatusBlockAssembler final
+	{
+	public:
+		// Must be called for every parsed line, before it is handled. If the line ends the
+		// block that was in progress, that block is returned. The line itself may start the
+		// next one.
+		std::optional<ServerStatusBlock> AddLine(const IConsoleLine& line);
+
+		// `status` output is always written in one go, so running out of console output (the end
+		// of an RCON response, or having parsed everything written to console.log so far) also
+		// ends any block in progress. Not the end of an arbitrary chunk though, reads and
+		// budgeted updates can stop anywhere. Returns it if it had any rows.
+		std::optional<ServerStatusBlock> Flush();
+
+	private:
+		enum class State
+		{
+			Idle,
+			Header,
+			Rows,
+		};
+
+		State m_State = State::Idle;
+		ServerStatusBlock m_Block;
+	};
+}
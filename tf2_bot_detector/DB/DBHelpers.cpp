@@ -204,6 +204,12 @@ ColumnData::ColumnData(const ColumnDefinition& column, const BlobData& blobData)
 	assert(column.m_Type == ColumnType::Blob);
 }
 
+ColumnData::ColumnData(const ColumnDefinition& column, std::nullptr_t) :
+	m_Column(column), m_Data(std::monostate{})
+{
+	assert(!(column.m_Flags & ColumnFlags::NotNull));
+}
+
 BinaryOperation::BinaryOperation(BinaryOperator operation,
 	std::unique_ptr<IOperationExpression> lhs, std::unique_ptr<IOperationExpression> rhs) :
 	m_LHS(std::move(lhs)), m_RHS(std::move(rhs)), m_Operation(operation)
@@ -12,6 +12,7 @@
 #include <SQLiteCpp/SQLiteCpp.h>
 
 #include <cassert>
+#include <cstring>
 
 using namespace tf2_bot_detector;
 using namespace tf2_bot_detector::DB;
@@ -33,8 +34,17 @@ namespace
 		void Store(const AccountInventorySizeInfo& info) override;
 		bool TryGet(AccountInventorySizeInfo& info) const override;
 
+		void Store(const AccountFriendsListInfo& info) override;
+		bool TryGet(AccountFriendsListInfo& info) const override;
+
+		void Store(const PlayerSummaryCacheInfo& info) override;
+		bool TryGet(PlayerSummaryCacheInfo& info) const override;
+
+		void Store(const PlayerBansCacheInfo& info) override;
+		bool TryGet(PlayerBansCacheInfo& info) const override;
+
 	private:
-		static constexpr size_t DB_VERSION = 4;
+		static constexpr size_t DB_VERSION = 5;
 		void Connect();
 
 		std::optional<SQLite::Database> m_Connection;
@@ -86,6 +96,44 @@ namespace
 
 	} static const s_TableInventorySize;
 
+	struct TABLE_FRIENDS_LIST final : BASETABLE_EXPIRABLE
+	{
+		TABLE_FRIENDS_LIST() : BASETABLE_EXPIRABLE("TABLE_FRIENDS_LIST") {}
+
+		// Account IDs, as packed uint32_ts
+		const ColumnDefinition COL_FRIENDS = Column("Friends", ColumnType::Blob, ColumnFlags::NotNull);
+
+	} static const s_TableFriendsList;
+
+	struct TABLE_PLAYER_SUMMARY final : BASETABLE_EXPIRABLE
+	{
+		TABLE_PLAYER_SUMMARY() : BASETABLE_EXPIRABLE("TABLE_PLAYER_SUMMARY") {}
+
+		const ColumnDefinition COL_REAL_NAME = Column("RealName", ColumnType::Text, ColumnFlags::NotNull);
+		const ColumnDefinition COL_NICKNAME = Column("Nickname", ColumnType::Text, ColumnFlags::NotNull);
+		const ColumnDefinition COL_AVATAR_HASH = Column("AvatarHash", ColumnType::Text, ColumnFlags::NotNull);
+		const ColumnDefinition COL_PROFILE_URL = Column("ProfileURL", ColumnType::Text, ColumnFlags::NotNull);
+		const ColumnDefinition COL_STATUS = Column("Status", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_VISIBILITY = Column("Visibility", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_PROFILE_CONFIGURED = Column("ProfileConfigured", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_COMMENT_PERMISSIONS = Column("CommentPermissions", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_CREATION_TIME = Column("CreationTime", ColumnType::Integer);
+		const ColumnDefinition COL_LAST_LOGOFF = Column("LastLogOff", ColumnType::Integer);
+
+	} static const s_TablePlayerSummary;
+
+	struct TABLE_PLAYER_BANS final : BASETABLE_EXPIRABLE
+	{
+		TABLE_PLAYER_BANS() : BASETABLE_EXPIRABLE("TABLE_PLAYER_BANS") {}
+
+		const ColumnDefinition COL_COMMUNITY_BANNED = Column("CommunityBanned", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_ECONOMY_BAN = Column("EconomyBan", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_VAC_BAN_COUNT = Column("VACBanCount", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_GAME_BAN_COUNT = Column("GameBanCount", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_LAST_BAN_TIME = Column("LastBanTime", ColumnType::Integer, ColumnFlags::NotNull);
+
+	} static const s_TablePlayerBans;
+
 	TempDB::TempDB() try
 	{
 		Connect();
@@ -106,6 +154,9 @@ namespace
 		CreateTable(m_Connection.value(), s_TableAccountAges, CreateTableFlags::IfNotExists);
 		CreateTable(m_Connection.value(), s_TableLogsTFCache, CreateTableFlags::IfNotExists);
 		CreateTable(m_Connection.value(), s_TableInventorySize, CreateTableFlags::IfNotExists);
+		CreateTable(m_Connection.value(), s_TableFriendsList, CreateTableFlags::IfNotExists);
+		CreateTable(m_Connection.value(), s_TablePlayerSummary, CreateTableFlags::IfNotExists);
+		CreateTable(m_Connection.value(), s_TablePlayerBans, CreateTableFlags::IfNotExists);
 	}
 	catch (...)
 	{
@@ -292,6 +343,165 @@ SELECT min({col_AccountID}) AS {col_AccountID}, {col_CreationTime} FROM {tbl_Acc
 
 		return false;
 	}
+
+	void TempDB::Store(const AccountFriendsListInfo& info) try
+	{
+		std::vector<uint32_t> friends;
+		friends.reserve(info.m_Friends.size());
+		for (const SteamID& id : info.m_Friends)
+		{
+			if (id.Type == SteamAccountType::Individual)
+				friends.push_back(id.GetAccountID());
+		}
+
+		ReplaceInto(m_Connection.value(), s_TableFriendsList.GetTableName(),
+			{
+				{ s_TableFriendsList.COL_ACCOUNT_ID, info.GetSteamID() },
+				{ s_TableFriendsList.COL_LAST_UPDATE_TIME, info.m_LastCacheUpdateTime },
+				{ s_TableFriendsList.COL_FRIENDS, BlobData{ friends.data(), friends.size() * sizeof(friends[0]) } },
+			});
+	}
+	catch (...)
+	{
+		LogException();
+		throw;
+	}
+
+	bool TempDB::TryGet(AccountFriendsListInfo& info) const
+	{
+		auto query = SelectStatementBuilder(s_TableFriendsList.GetTableName())
+			.Where(s_TableFriendsList.COL_ACCOUNT_ID == info.GetSteamID())
+			.Run(m_Connection.value());
+
+		if (query.executeStep())
+		{
+			info.m_LastCacheUpdateTime = query.getColumn(s_TableFriendsList.COL_LAST_UPDATE_TIME);
+
+			const auto friendsColumn = query.getColumn(s_TableFriendsList.COL_FRIENDS);
+			const auto friendsCount = size_t(friendsColumn.getBytes()) / sizeof(uint32_t);
+			const auto friendsData = static_cast<const std::byte*>(friendsColumn.getBlob());
+
+			info.m_Friends.clear();
+			info.m_Friends.reserve(friendsCount);
+			for (size_t i = 0; i < friendsCount; i++)
+			{
+				uint32_t accountID;
+				std::memcpy(&accountID, friendsData + (i * sizeof(accountID)), sizeof(accountID));
+				info.m_Friends.insert(SteamID(accountID, SteamAccountType::Individual));
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void TempDB::Store(const PlayerSummaryCacheInfo& info) try
+	{
+		const auto OptionalTime = [](const ColumnDefinition& column, const std::optional<time_point_t>& time)
+		{
+			return time ? ColumnData(column, *time) : ColumnData(column, nullptr);
+		};
+
+		ReplaceInto(m_Connection.value(), s_TablePlayerSummary.GetTableName(),
+			{
+				{ s_TablePlayerSummary.COL_ACCOUNT_ID, info.GetSteamID() },
+				{ s_TablePlayerSummary.COL_LAST_UPDATE_TIME, info.m_LastCacheUpdateTime },
+				{ s_TablePlayerSummary.COL_REAL_NAME, info.m_RealName.c_str() },
+				{ s_TablePlayerSummary.COL_NICKNAME, info.m_Nickname.c_str() },
+				{ s_TablePlayerSummary.COL_AVATAR_HASH, info.m_AvatarHash.c_str() },
+				{ s_TablePlayerSummary.COL_PROFILE_URL, info.m_ProfileURL.c_str() },
+				{ s_TablePlayerSummary.COL_STATUS, int64_t(info.m_Status) },
+				{ s_TablePlayerSummary.COL_VISIBILITY, int64_t(info.m_Visibility) },
+				{ s_TablePlayerSummary.COL_PROFILE_CONFIGURED, int64_t(info.m_ProfileConfigured) },
+				{ s_TablePlayerSummary.COL_COMMENT_PERMISSIONS, int64_t(info.m_CommentPermissions) },
+				OptionalTime(s_TablePlayerSummary.COL_CREATION_TIME, info.m_CreationTime),
+				OptionalTime(s_TablePlayerSummary.COL_LAST_LOGOFF, info.m_LastLogOff),
+			});
+	}
+	catch (...)
+	{
+		LogException();
+		throw;
+	}
+
+	bool TempDB::TryGet(PlayerSummaryCacheInfo& info) const
+	{
+		auto query = SelectStatementBuilder(s_TablePlayerSummary.GetTableName())
+			.Where(s_TablePlayerSummary.COL_ACCOUNT_ID == info.GetSteamID())
+			.Run(m_Connection.value());
+
+		if (query.executeStep())
+		{
+			const auto OptionalTime = [&](const ColumnDefinition& column) -> std::optional<time_point_t>
+			{
+				auto value = query.getColumn(column);
+				if (value.isNull())
+					return std::nullopt;
+
+				return time_point_t(value);
+			};
+
+			info.m_LastCacheUpdateTime = query.getColumn(s_TablePlayerSummary.COL_LAST_UPDATE_TIME);
+			info.m_RealName = query.getColumn(s_TablePlayerSummary.COL_REAL_NAME).getString();
+			info.m_Nickname = query.getColumn(s_TablePlayerSummary.COL_NICKNAME).getString();
+			info.m_AvatarHash = query.getColumn(s_TablePlayerSummary.COL_AVATAR_HASH).getString();
+			info.m_ProfileURL = query.getColumn(s_TablePlayerSummary.COL_PROFILE_URL).getString();
+			info.m_Status = SteamAPI::PersonaState(query.getColumn(s_TablePlayerSummary.COL_STATUS).getInt());
+			info.m_Visibility = SteamAPI::CommunityVisibilityState(query.getColumn(s_TablePlayerSummary.COL_VISIBILITY).getInt());
+			info.m_ProfileConfigured = query.getColumn(s_TablePlayerSummary.COL_PROFILE_CONFIGURED).getInt() != 0;
+			info.m_CommentPermissions = query.getColumn(s_TablePlayerSummary.COL_COMMENT_PERMISSIONS).getInt() != 0;
+			info.m_CreationTime = OptionalTime(s_TablePlayerSummary.COL_CREATION_TIME);
+			info.m_LastLogOff = OptionalTime(s_TablePlayerSummary.COL_LAST_LOGOFF);
+			return true;
+		}
+
+		return false;
+	}
+
+	void TempDB::Store(const PlayerBansCacheInfo& info) try
+	{
+		// m_TimeSinceLastBan is relative to when it was fetched (m_LastCacheUpdateTime), so store
+		// when the ban actually happened instead
+		ReplaceInto(m_Connection.value(), s_TablePlayerBans.GetTableName(),
+			{
+				{ s_TablePlayerBans.COL_ACCOUNT_ID, info.GetSteamID() },
+				{ s_TablePlayerBans.COL_LAST_UPDATE_TIME, info.m_LastCacheUpdateTime },
+				{ s_TablePlayerBans.COL_COMMUNITY_BANNED, int64_t(info.m_CommunityBanned) },
+				{ s_TablePlayerBans.COL_ECONOMY_BAN, int64_t(info.m_EconomyBan) },
+				{ s_TablePlayerBans.COL_VAC_BAN_COUNT, info.m_VACBanCount },
+				{ s_TablePlayerBans.COL_GAME_BAN_COUNT, info.m_GameBanCount },
+				{ s_TablePlayerBans.COL_LAST_BAN_TIME, info.m_LastCacheUpdateTime - info.m_TimeSinceLastBan },
+			});
+	}
+	catch (...)
+	{
+		LogException();
+		throw;
+	}
+
+	bool TempDB::TryGet(PlayerBansCacheInfo& info) const
+	{
+		auto query = SelectStatementBuilder(s_TablePlayerBans.GetTableName())
+			.Where(s_TablePlayerBans.COL_ACCOUNT_ID == info.GetSteamID())
+			.Run(m_Connection.value());
+
+		if (query.executeStep())
+		{
+			info.m_LastCacheUpdateTime = query.getColumn(s_TablePlayerBans.COL_LAST_UPDATE_TIME);
+			info.m_CommunityBanned = query.getColumn(s_TablePlayerBans.COL_COMMUNITY_BANNED).getInt() != 0;
+			info.m_EconomyBan = SteamAPI::PlayerEconomyBan(query.getColumn(s_TablePlayerBans.COL_ECONOMY_BAN).getInt());
+			info.m_VACBanCount = query.getColumn(s_TablePlayerBans.COL_VAC_BAN_COUNT).getUInt();
+			info.m_GameBanCount = query.getColumn(s_TablePlayerBans.COL_GAME_BAN_COUNT).getUInt();
+
+			// Relative to when it was fetched, just like it was when it was stored
+			const time_point_t lastBanTime = query.getColumn(s_TablePlayerBans.COL_LAST_BAN_TIME);
+			info.m_TimeSinceLastBan = info.m_LastCacheUpdateTime - lastBanTime;
+			return true;
+		}
+
+		return false;
+	}
 }
 
 std::unique_ptr<ITempDB> tf2_bot_detector::DB::ITempDB::Create()
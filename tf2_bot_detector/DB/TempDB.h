@@ -61,6 +61,30 @@ namespace tf2_bot_detector::DB
 		duration_t GetCacheLiveTime() const override { return day_t(7); }
 	};
 
+	struct PlayerSummaryCacheInfo final : detail::BaseCacheInfo_Expiration, SteamAPI::PlayerSummary
+	{
+		PlayerSummaryCacheInfo() = default;
+		using SteamAPI::PlayerSummary::PlayerSummary;
+		using SteamAPI::PlayerSummary::operator=;
+
+		using ICacheInfo::GetSteamID;
+		const SteamID& GetSteamID() const override { return m_SteamID; }
+
+		duration_t GetCacheLiveTime() const override final { return day_t(1); }
+	};
+
+	struct PlayerBansCacheInfo final : detail::BaseCacheInfo_Expiration, SteamAPI::PlayerBans
+	{
+		PlayerBansCacheInfo() = default;
+		using SteamAPI::PlayerBans::PlayerBans;
+		using SteamAPI::PlayerBans::operator=;
+
+		using ICacheInfo::GetSteamID;
+		const SteamID& GetSteamID() const override { return m_SteamID; }
+
+		duration_t GetCacheLiveTime() const override final { return day_t(1); }
+	};
+
 	struct LogsTFCacheInfo final : detail::BaseCacheInfo_Expiration, LogsTFAPI::PlayerLogsInfo
 	{
 		LogsTFCacheInfo() = default;
@@ -90,6 +114,15 @@ namespace tf2_bot_detector::DB
 		virtual void Store(const AccountInventorySizeInfo& info) = 0;
 		[[nodiscard]] virtual bool TryGet(AccountInventorySizeInfo& info) const = 0;
 
+		virtual void Store(const AccountFriendsListInfo& info) = 0;
+		[[nodiscard]] virtual bool TryGet(AccountFriendsListInfo& info) const = 0;
+
+		virtual void Store(const PlayerSummaryCacheInfo& info) = 0;
+		[[nodiscard]] virtual bool TryGet(PlayerSummaryCacheInfo& info) const = 0;
+
+		virtual void Store(const PlayerBansCacheInfo& info) = 0;
+		[[nodiscard]] virtual bool TryGet(PlayerBansCacheInfo& info) const = 0;
+
 		template<typename TInfo, typename TUpdateFunc>
 		mh::task<> GetOrUpdateAsync(TInfo& info, TUpdateFunc&& updateFunc)
 		{
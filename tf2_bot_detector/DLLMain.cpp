@@ -1,6 +1,7 @@
 #include "DLLMain.h"
 
 #include "Application.h"
+#include "ConsoleLog/ConsoleLogReplay.h"
 #include "Tests/Tests.h"
 #include "UI/MainWindow.h"
 #include "Util/TextUtils.h"
@@ -37,10 +38,30 @@ TF2_BOT_DETECTOR_EXPORT int tf2_bot_detector::RunProgram(int argc, const char**
 		IFilesystem::Get().Init();
 		ILogManager::GetInstance().Init();
 
+		ConsoleLogReplaySettings replaySettings;
+
 		for (int i = 1; i < argc; i++)
 		{
+			if (!strcmp(argv[i], "--replay") && (i + 1) < argc)
+				replaySettings.m_FileName = argv[++i];
+			else if (!strcmp(argv[i], "--replay-realtime"))
+				replaySettings.m_Realtime = true;
+			else if (!strcmp(argv[i], "--replay-steamid") && (i + 1) < argc)
+				replaySettings.m_LocalSteamID = SteamID(argv[++i]);
+			else if (!strcmp(argv[i], "--replay-chat-wrappers") && (i + 1) < argc)
+				replaySettings.m_ChatWrappersFileName = argv[++i];
+			else if (!strcmp(argv[i], "--replay-bulk"))
+				replaySettings.m_BulkParse = true;
+			else if (!strcmp(argv[i], "--replay-threads") && (i + 1) < argc)
+				replaySettings.m_ThreadCount = unsigned(atoi(argv[++i]));
+			else if (!strcmp(argv[i], "--replay-parse-stats") && (i + 1) < argc)
+				replaySettings.m_ParseStatsFileName = argv[++i];
+			else if (!strcmp(argv[i], "--replay-time-parsers"))
+				replaySettings.m_TimeParsers = true;
+			else if (!strcmp(argv[i], "--replay-coalesce"))
+				replaySettings.m_CoalesceLines = true;
 #ifdef _DEBUG
-			if (!strcmp(argv[i], "--static-seed") && (i + 1) < argc)
+			else if (!strcmp(argv[i], "--static-seed") && (i + 1) < argc)
 				tf2_bot_detector::g_StaticRandomSeed = atoi(argv[i + 1]);
 			else if (!strcmp(argv[i], "--allow-open-tf2"))
 				tf2_bot_detector::g_SkipOpenTF2Check = true;
@@ -55,6 +76,9 @@ TF2_BOT_DETECTOR_EXPORT int tf2_bot_detector::RunProgram(int argc, const char**
 #endif
 		}
 
+		if (!replaySettings.m_FileName.empty())
+			return tf2_bot_detector::RunConsoleLogReplay(replaySettings);
+
 #if defined(_DEBUG) && defined(TF2BD_ENABLE_TESTS)
 		// Always run the tests debug builds (but don't quit afterwards)
 		tf2_bot_detector::RunTests();
@@ -2,6 +2,7 @@
 #include "DiscordRichPresence.h"
 #include "Config/DRPInfo.h"
 #include "Config/Settings.h"
+#include "ConsoleLog/ConsoleLineCoalescer.h"
 #include "ConsoleLog/ConsoleLineListener.h"
 #include "ConsoleLog/ConsoleLines.h"
 #include "ConsoleLog/NetworkStatus.h"
@@ -813,8 +814,25 @@ namespace
 }
 
 DiscordState::DiscordState(const Settings& settings, IWorldState& world) :
-	AutoWorldEventListener(world),
-	AutoConsoleLineListener(world),
+	AutoWorldEventListener(world, WorldEvent::LocalPlayerSpawned),
+	AutoConsoleLineListener(world, {
+		// Everything handled in OnConsoleLineParsed()
+		ConsoleLineType::PlayerStatusMapPosition,
+		ConsoleLineType::PartyHeader,
+		ConsoleLineType::MatchmakingBannedTime,
+		ConsoleLineType::LobbyHeader,
+		ConsoleLineType::LobbyStatusFailed,
+		ConsoleLineType::QueueStateChange,
+		ConsoleLineType::InQueue,
+		ConsoleLineType::LobbyChanged,
+		ConsoleLineType::ServerJoin,
+		ConsoleLineType::HostNewGame,
+		ConsoleLineType::PlayerStatusIP,
+		ConsoleLineType::NetStatusConfig,
+		ConsoleLineType::Connecting,
+		ConsoleLineType::SVC_UserMessage,
+		ConsoleLineType::SVCUserMessageSummary,
+	}),
 	m_Settings(settings),
 	m_WorldState(world),
 	m_GameState(settings, m_DRPInfo),
@@ -932,6 +950,13 @@ void DiscordState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& line)
 		m_GameState.OnServerIPUpdate(umsgLine.GetAddress());
 		break;
 	}
+	case ConsoleLineType::SVCUserMessageSummary:
+	{
+		QueueUpdate();
+		auto& summaryLine = static_cast<SVCUserMessageSummaryLine&>(line);
+		m_GameState.OnServerIPUpdate(summaryLine.GetAddress());
+		break;
+	}
 
 	default:
 		break;
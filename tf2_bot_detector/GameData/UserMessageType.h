@@ -91,6 +91,23 @@ namespace tf2_bot_detector
 		HapSetConst = 81,
 		HapMeleeContact = 82,
 	};
+
+	// Anything to do with votes. These have to be seen one at a time, as they happen.
+	constexpr bool IsVoteUserMessage(UserMessageType type)
+	{
+		switch (type)
+		{
+		case UserMessageType::CallVoteFailed:
+		case UserMessageType::VoteStart:
+		case UserMessageType::VotePass:
+		case UserMessageType::VoteFailed:
+		case UserMessageType::VoteSetup:
+			return true;
+
+		default:
+			return false;
+		}
+	}
 }
 
 MH_ENUM_REFLECT_BEGIN(tf2_bot_detector::UserMessageType)
@@ -22,6 +22,8 @@ namespace
 				return "Unknown error.";
 			case ErrorCode::LogicError:
 				return "They were right all along! I *am* a bad programmer (logic error).";
+			case ErrorCode::GaveUpWaiting:
+				return "Gave up waiting for this after asking for it several times.";
 			}
 
 			return mh::format("Unknown error condition {}", condition);
@@ -12,6 +12,7 @@ namespace tf2_bot_detector
 		LazyValueUninitialized,
 		UnknownError, // I SWORE I WOULD NEVER TYPE THESE WORDS
 		LogicError,
+		GaveUpWaiting,
 	};
 
 	std::error_condition make_error_condition(tf2_bot_detector::ErrorCode e);
@@ -112,12 +112,16 @@ namespace
 				time_point_t m_LastTransmission{};
 				duration_t m_TotalTransmissions{};
 			} m_Voice;
+
+			// What the moderation rules saw the last time they were run against this player, so
+			// `status` rows that only changed ping don't make us run them again
+			std::optional<ModerationRuleInputs> m_RulesCheckedInputs;
 		};
 
 		// Steam IDs of players that we think are running the tool.
 		std::unordered_set<SteamID> m_PlayersRunningTool;
 
-		void OnPlayerStatusUpdate(IWorldState& world, const IPlayer& player) override;
+		void OnServerStatusSnapshot(IWorldState& world, const ServerStatusSnapshot& snapshot) override;
 		void OnChatMsg(IWorldState& world, IPlayer& player, const std::string_view& msg) override;
 
 		// FIXME: move to a different file, this really shouldn't be here.
@@ -154,7 +158,7 @@ namespace
 		// Minimum interval between callvote commands (the 150 comes from the default value of sv_vote_creation_timer)
 		static constexpr duration_t MIN_VOTEKICK_INTERVAL = std::chrono::seconds(150);
 		time_point_t m_LastVoteCallTime{}; // Last time we called a votekick on someone
-		duration_t GetTimeSinceLastCallVote() const { return tfbd_clock_t::now() - m_LastVoteCallTime; }
+		duration_t GetTimeSinceLastCallVote() const { return GetVirtualTime() - m_LastVoteCallTime; }
 
 		PlayerListJSON m_PlayerList;
 		ModerationRules m_Rules;
@@ -270,19 +274,42 @@ void ModeratorLogic::OnRuleMatch(const ModerationRule& rule, const IPlayer& play
 	}
 }
 
-void ModeratorLogic::OnPlayerStatusUpdate(IWorldState& world, const IPlayer& player)
+void ModeratorLogic::OnServerStatusSnapshot(IWorldState& world, const ServerStatusSnapshot& snapshot)
 {
-	const auto name = player.GetNameUnsafe();
-	const auto steamID = player.GetSteamID();
+	if (!m_Settings->m_AutoMark)
+		return;
+
+	// Walk the rule lists once per status dump rather than once per player
+	const ConfigFileGroupVersion rulesVersion = m_Rules.GetVersion();
+	std::vector<const ModerationRule*> rules;
+	for (const ModerationRule& rule : m_Rules.GetRules())
+		rules.push_back(&rule);
 
-	if (m_Settings->m_AutoMark)
+	for (const ServerStatusSnapshot::Player& entry : snapshot.m_Players)
 	{
-		for (const ModerationRule& rule : m_Rules.GetRules())
+		IPlayer* player = world.FindPlayer(entry.m_Player->GetSteamID());
+		if (!player)
+			continue;
+
+		// Rules only look at the name and the player summary, so if neither of those (nor the
+		// rules themselves, which finish loading in the background) changed since last time,
+		// neither will the result
+		auto& data = player->GetOrCreateData<PlayerExtraData>();
+		ModerationRuleInputs inputs(rulesVersion, *player);
+		if (data.m_RulesCheckedInputs == inputs &&
+			!(entry.m_Changes & PlayerStatusChange::Connection))
+		{
+			continue;
+		}
+
+		data.m_RulesCheckedInputs = std::move(inputs);
+
+		for (const ModerationRule* rule : rules)
 		{
-			if (!rule.Match(player))
+			if (!rule->Match(*player))
 				continue;
 
-			OnRuleMatch(rule, player, rule.m_Description);
+			OnRuleMatch(*rule, *player, rule->m_Description);
 		}
 	}
 }
@@ -484,7 +511,7 @@ void ModeratorLogic::HandleEnemyCheaters(uint8_t enemyPlayerCount,
 
 void ModeratorLogic::HandleConnectedEnemyCheaters(const std::vector<Cheater>& enemyCheaters)
 {
-	const auto now = tfbd_clock_t::now();
+	const auto now = GetVirtualTime();
 
 	// There are enough people on the other team to votekick the cheater(s)
 	std::string logMsg = mh::format("Telling the other team about {} cheater(s) named ", enemyCheaters.size());
@@ -634,7 +661,7 @@ void ModeratorLogic::HandleConnectingEnemyCheaters(const std::vector<Cheater>& c
 	if (!m_Settings->m_AutoChatWarnings || !m_Settings->m_AutoChatWarningsConnecting)
 		return;  // user has disabled this functionality
 
-	const auto now = tfbd_clock_t::now();
+	const auto now = GetVirtualTime();
 	if (now < m_NextConnectingCheaterWarningTime)
 	{
 		DebugLog("HandleEnemyCheaters(): Discarding connection warnings ("s
@@ -879,8 +906,8 @@ void ModeratorLogic::ProcessPlayerActions()
 	}
 
 	// Don't process actions if we're way out of date
-	[[maybe_unused]] const auto dbgDeltaTime = to_seconds(tfbd_clock_t::now() - now);
-	if ((tfbd_clock_t::now() - now) > 15s)
+	[[maybe_unused]] const auto dbgDeltaTime = to_seconds(GetVirtualTime() - now);
+	if ((GetVirtualTime() - now) > 15s)
 		return;
 
 	const auto myTeam = TryGetMyTeam();
@@ -1129,8 +1156,8 @@ void ModeratorLogic::ReloadConfigFiles()
 }
 
 ModeratorLogic::ModeratorLogic(IWorldState& world, const Settings& settings, IRCONActionManager& actionManager) :
-	AutoConsoleLineListener(world),
-	AutoWorldEventListener(world),
+	AutoConsoleLineListener(world, ConsoleLineTypeMask::None()),
+	AutoWorldEventListener(world, WorldEvent::ServerStatusSnapshot | WorldEvent::ChatMsg | WorldEvent::LocalPlayerInitialized),
 	m_World(&world),
 	m_Settings(&settings),
 	m_ActionManager(&actionManager),
@@ -1166,7 +1193,7 @@ bool ModeratorLogic::InitiateVotekick(const IPlayer& player, KickReason reason,
 
 		Log(std::move(logMsg));
 
-		m_LastVoteCallTime = tfbd_clock_t::now();
+		m_LastVoteCallTime = GetVirtualTime();
 	}
 
 	//m_ActionManager->QueueAction<ChatMessageAction>("[tf2bd] votekicking ", ChatMessageType::PartyChat);
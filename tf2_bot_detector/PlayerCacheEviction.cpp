@@ -0,0 +1,35 @@
+#include "PlayerCacheEviction.h"
+
+#include <algorithm>
+
+using namespace tf2_bot_detector;
+
+std::vector<SteamID> tf2_bot_detector::SelectPlayersToEvict(std::vector<PlayerEvictionCandidate> candidates, size_t limitBytes)
+{
+	std::vector<SteamID> retVal;
+
+	size_t totalBytes = 0;
+	for (const auto& candidate : candidates)
+		totalBytes += candidate.m_ApproxBytes;
+
+	if (totalBytes <= limitBytes)
+		return retVal;
+
+	std::erase_if(candidates, [](const PlayerEvictionCandidate& candidate) { return !candidate.m_Evictable; });
+	std::sort(candidates.begin(), candidates.end(),
+		[](const PlayerEvictionCandidate& a, const PlayerEvictionCandidate& b)
+		{
+			return a.m_LastSeen < b.m_LastSeen;
+		});
+
+	for (const auto& candidate : candidates)
+	{
+		if (totalBytes <= limitBytes)
+			break;
+
+		retVal.push_back(candidate.m_SteamID);
+		totalBytes -= candidate.m_ApproxBytes;
+	}
+
+	return retVal;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Clock.h"
+#include "SteamID.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	struct PlayerEvictionCandidate
+	{
+		SteamID m_SteamID;
+		time_point_t m_LastSeen{};
+		size_t m_ApproxBytes = 0;
+		bool m_Evictable = false;   // Gone, and nothing is still waiting on them
+	};
+
+	// Picks evictable players, least recently seen first, until the ones left fit within
+	// limitBytes. If even evicting all of them isn't enough, they all get evicted anyway.
+	std::vector<SteamID> SelectPlayersToEvict(std::vector<PlayerEvictionCandidate> candidates, size_t limitBytes);
+}
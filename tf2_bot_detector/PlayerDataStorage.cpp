@@ -0,0 +1,38 @@
+#include "PlayerDataStorage.h"
+
+#include <atomic>
+
+using namespace tf2_bot_detector;
+
+static std::atomic<size_t> s_RegisteredSlotCount;
+
+size_t PlayerDataStorage::RegisterSlot()
+{
+	return s_RegisteredSlotCount++;
+}
+
+size_t PlayerDataStorage::GetRegisteredSlotCount()
+{
+	return s_RegisteredSlotCount;
+}
+
+auto PlayerDataStorage::FindOverflowSlot(size_t index) const -> const Slot*
+{
+	assert(index >= INLINE_SLOTS);
+	index -= INLINE_SLOTS;
+	return index < m_OverflowSlots.size() ? m_OverflowSlots[index].get() : nullptr;
+}
+
+auto PlayerDataStorage::GetOrCreateOverflowSlot(size_t index) -> Slot&
+{
+	assert(index >= INLINE_SLOTS);
+	index -= INLINE_SLOTS;
+	if (index >= m_OverflowSlots.size())
+		m_OverflowSlots.resize(index + 1);
+
+	auto& slot = m_OverflowSlots[index];
+	if (!slot)
+		slot = std::make_unique<Slot>();
+
+	return *slot;
+}
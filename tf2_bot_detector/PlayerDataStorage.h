@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	// Data that other systems attach to a player, through IPlayer::GetData()/GetOrCreateData().
+	// Every type gets its own slot index the first time it is used, so looking up a player's
+	// data is an array index instead of a map lookup. Small types are stored inside the slot
+	// itself, larger ones get their own allocation.
+	class PlayerDataStorage final
+	{
+	public:
+		// Enough for everything that uses this today, anything past it still works, just with
+		// an extra allocation
+		static constexpr size_t INLINE_SLOTS = 4;
+		static constexpr size_t INLINE_DATA_SIZE = 160;
+
+		PlayerDataStorage() = default;
+		PlayerDataStorage(const PlayerDataStorage&) = delete;
+		PlayerDataStorage& operator=(const PlayerDataStorage&) = delete;
+
+		template<typename T> T* Find()
+		{
+			return const_cast<T*>(std::as_const(*this).Find<T>());
+		}
+		template<typename T> const T* Find() const
+		{
+			const Slot* slot = FindSlot(GetSlotIndex<T>());
+			return slot ? static_cast<const T*>(slot->m_Data) : nullptr;
+		}
+
+		template<typename T, typename... TArgs> T& GetOrCreate(TArgs&&... args)
+		{
+			Slot& slot = GetOrCreateSlot(GetSlotIndex<T>());
+			if (!slot.m_Data)
+				slot.Emplace<T>(std::forward<TArgs>(args)...);
+
+			return *static_cast<T*>(slot.m_Data);
+		}
+
+		// Replaces whatever was there before
+		template<typename T, typename... TArgs> T& Emplace(TArgs&&... args)
+		{
+			Slot& slot = GetOrCreateSlot(GetSlotIndex<T>());
+			slot.Reset();
+			slot.Emplace<T>(std::forward<TArgs>(args)...);
+			return *static_cast<T*>(slot.m_Data);
+		}
+
+		template<typename T> void Erase()
+		{
+			if (Slot* slot = const_cast<Slot*>(FindSlot(GetSlotIndex<T>())))
+				slot->Reset();
+		}
+
+		// Number of types that have been assigned a slot so far, across all players
+		static size_t GetRegisteredSlotCount();
+
+	private:
+		struct Slot final
+		{
+			Slot() = default;
+			Slot(const Slot&) = delete;
+			Slot& operator=(const Slot&) = delete;
+			~Slot() { Reset(); }
+
+			template<typename T, typename... TArgs> void Emplace(TArgs&&... args)
+			{
+				assert(!m_Data);
+
+				if constexpr (sizeof(T) <= INLINE_DATA_SIZE && alignof(T) <= alignof(std::max_align_t))
+				{
+					m_Data = new (m_InlineData) T(std::forward<TArgs>(args)...);
+					m_Destroy = [](void* data) { static_cast<T*>(data)->~T(); };
+				}
+				else
+				{
+					m_Data = new T(std::forward<TArgs>(args)...);
+					m_Destroy = [](void* data) { delete static_cast<T*>(data); };
+				}
+			}
+
+			void Reset()
+			{
+				if (m_Data)
+					m_Destroy(std::exchange(m_Data, nullptr));
+			}
+
+			void* m_Data = nullptr;
+			void (*m_Destroy)(void* data) = nullptr;
+			alignas(std::max_align_t) std::byte m_InlineData[INLINE_DATA_SIZE];
+		};
+
+		static size_t RegisterSlot();
+
+		template<typename T> static size_t GetSlotIndex()
+		{
+			static_assert(std::is_same_v<T, std::remove_cvref_t<T>>);
+			static const size_t s_Index = RegisterSlot();
+			return s_Index;
+		}
+
+		const Slot* FindSlot(size_t index) const
+		{
+			const Slot* slot = index < INLINE_SLOTS ? &m_InlineSlots[index] : FindOverflowSlot(index);
+			return (slot && slot->m_Data) ? slot : nullptr;
+		}
+		Slot& GetOrCreateSlot(size_t index)
+		{
+			return index < INLINE_SLOTS ? m_InlineSlots[index] : GetOrCreateOverflowSlot(index);
+		}
+
+		const Slot* FindOverflowSlot(size_t index) const;
+		Slot& GetOrCreateOverflowSlot(size_t index);
+
+		std::array<Slot, INLINE_SLOTS> m_InlineSlots;
+		std::vector<std::unique_ptr<Slot>> m_OverflowSlots;
+	};
+}
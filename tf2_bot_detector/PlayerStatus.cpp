@@ -0,0 +1,26 @@
+#include "PlayerStatus.h"
+
+using namespace tf2_bot_detector;
+
+PlayerStatusChange tf2_bot_detector::ClassifyPlayerStatusChange(const PlayerStatus& oldStatus, const PlayerStatus& newStatus)
+{
+	PlayerStatusChange changes = PlayerStatusChange::None;
+
+	if (oldStatus.m_Name != newStatus.m_Name)
+		changes |= PlayerStatusChange::Name;
+
+	if (oldStatus.m_State != newStatus.m_State)
+		changes |= PlayerStatusChange::State;
+
+	if (oldStatus.m_UserID != newStatus.m_UserID ||
+		oldStatus.m_ConnectionTime != newStatus.m_ConnectionTime ||
+		oldStatus.m_Address != newStatus.m_Address)
+	{
+		changes |= PlayerStatusChange::Connection;
+	}
+
+	if (oldStatus.m_Ping != newStatus.m_Ping || oldStatus.m_Loss != newStatus.m_Loss)
+		changes |= PlayerStatusChange::Ping;
+
+	return changes;
+}
@@ -4,6 +4,8 @@
 #include "SteamID.h"
 #include "TFConstants.h"
 
+#include <mh/types/enum_class_bit_ops.hpp>
+
 #include <cstdint>
 #include <string>
 
@@ -26,12 +28,30 @@ namespace tf2_bot_detector
 		SteamID m_SteamID;
 
 		time_point_t m_ConnectionTime{};
-		UserID_t m_UserID;
-		uint16_t m_Ping;
-		uint8_t m_Loss;
+		UserID_t m_UserID{};
+		uint16_t m_Ping{};
+		uint8_t m_Loss{};
 		PlayerStatusState m_State = PlayerStatusState::Invalid;
 	};
 
+	// Which parts of a player's status changed between two `status` rows. Nearly every row
+	// changes ping, so listeners that do real work per player should check for the bits
+	// they actually care about.
+	enum class PlayerStatusChange : uint8_t
+	{
+		None = 0,
+
+		Name = (1 << 0),
+		State = (1 << 1),
+		Connection = (1 << 2),  // Userid, address or connection time, they (re)connected
+		Ping = (1 << 3),        // Ping or loss
+
+		All = Name | State | Connection | Ping,
+	};
+	MH_ENABLE_ENUM_CLASS_BIT_OPS(PlayerStatusChange);
+
+	PlayerStatusChange ClassifyPlayerStatusChange(const PlayerStatus& oldStatus, const PlayerStatus& newStatus);
+
 	struct PlayerStatusShort
 	{
 		std::string m_Name;
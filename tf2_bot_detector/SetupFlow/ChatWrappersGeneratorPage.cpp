@@ -1,4 +1,5 @@
 #include "ChatWrappersGeneratorPage.h"
+#include "Config/ChatWrapperMatcher.h"
 #include "Config/Settings.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Log.h"
@@ -154,6 +155,9 @@ void ChatWrappersGeneratorPage::Commit(const CommitState& cs)
 		cs.m_Settings.m_Unsaved.m_ChatMsgWrappers = m_ChatWrappersLoaded.value();
 	}
 
+	cs.m_Settings.m_Unsaved.m_ChatMsgWrappersMatcher =
+		std::make_shared<ChatWrapperMatcher>(cs.m_Settings.m_Unsaved.m_ChatMsgWrappers.value());
+
 	// Generate a random token that will be used to verify that our
 	// custom chat wrappers are in the search path
 	{
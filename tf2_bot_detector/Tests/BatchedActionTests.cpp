@@ -0,0 +1,233 @@
+#include "BatchedAction.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+TEST_CASE("tf2bd_batched_action_pacer", "[BatchedAction]")
+{
+	BatchedActionPacer pacer(3);
+	const time_point_t start(1h);
+
+	SECTION("First batch goes out immediately, then waits for the interval")
+	{
+		REQUIRE(pacer.CanSend(start, 0));
+		pacer.OnSent(start);
+
+		REQUIRE(!pacer.CanSend(start + 500ms, 1));
+		REQUIRE(pacer.CanSend(start + BatchedActionPacer::INITIAL_INTERVAL, 1));
+	}
+	SECTION("Never more than maxInFlight batches")
+	{
+		REQUIRE(!pacer.CanSend(start, 3));
+	}
+	SECTION("Fast responses ease toward the minimum interval")
+	{
+		duration_t prevInterval = pacer.GetInterval();
+		for (int i = 0; i < 20; i++)
+		{
+			pacer.OnSucceeded(100ms);
+			REQUIRE(pacer.GetInterval() <= prevInterval);
+			prevInterval = pacer.GetInterval();
+		}
+
+		REQUIRE(pacer.GetInterval() == BatchedActionPacer::MIN_INTERVAL);
+	}
+	SECTION("Slow responses hold the interval at what the pipeline can keep up with")
+	{
+		for (int i = 0; i < 20; i++)
+			pacer.OnSucceeded(6s);
+
+		REQUIRE(pacer.GetInterval() == 2s);
+	}
+	SECTION("Failures back off, up to the maximum")
+	{
+		pacer.OnFailed(start, false);
+		REQUIRE(pacer.GetInterval() == BatchedActionPacer::INITIAL_INTERVAL * 2);
+
+		for (int i = 0; i < 20; i++)
+			pacer.OnFailed(start, false);
+
+		REQUIRE(pacer.GetInterval() == BatchedActionPacer::MAX_INTERVAL);
+	}
+	SECTION("Throttling holds off the next batch")
+	{
+		REQUIRE(pacer.CanSend(start, 1));
+
+		pacer.OnFailed(start, true);
+		REQUIRE(!pacer.CanSend(start + BatchedActionPacer::INITIAL_INTERVAL, 1));
+		REQUIRE(pacer.CanSend(start + pacer.GetInterval(), 1));
+	}
+	SECTION("Plain failures don't push back a batch that's already due")
+	{
+		pacer.OnFailed(start, false);
+		REQUIRE(pacer.CanSend(start, 1));
+	}
+	SECTION("Being unavailable retries without backing off")
+	{
+		for (int i = 0; i < 20; i++)
+			pacer.OnUnavailable(start);
+
+		REQUIRE(pacer.GetInterval() == BatchedActionPacer::INITIAL_INTERVAL);
+		REQUIRE(!pacer.CanSend(start, 0));
+		REQUIRE(pacer.CanSend(start + BatchedActionPacer::INITIAL_INTERVAL, 0));
+	}
+	SECTION("Reset goes back to the initial interval, and sends right away")
+	{
+		for (int i = 0; i < 20; i++)
+			pacer.OnFailed(start, true);
+
+		pacer.Reset();
+		REQUIRE(pacer.GetInterval() == BatchedActionPacer::INITIAL_INTERVAL);
+		REQUIRE(pacer.CanSend(start, 0));
+	}
+}
+
+namespace
+{
+	// Items are ints, the response is the items that got their data
+	class TestBatchedAction final : public BatchedAction<int, int, std::vector<int>>
+	{
+	public:
+		struct SentBatch
+		{
+			std::vector<int> m_Items;  // Sorted
+			mh::promise<std::vector<int>> m_Response;
+		};
+
+		size_t m_MaxBatchSize = 3;
+		bool m_Available = true;
+		std::deque<SentBatch> m_Sent;
+		std::vector<int> m_GaveUp;
+
+	protected:
+		size_t GetMaxBatchSize() const override { return m_MaxBatchSize; }
+
+		response_future_type SendRequest(int&, queue_collection_type& collection) override
+		{
+			if (!m_Available)
+				return {};
+
+			SentBatch& batch = m_Sent.emplace_back();
+			batch.m_Items.assign(collection.begin(), collection.end());
+			std::sort(batch.m_Items.begin(), batch.m_Items.end());
+			return batch.m_Response.get_task();
+		}
+
+		void OnDataReady(int&, const response_type& response, queue_collection_type& collection) override
+		{
+			for (int item : response)
+				collection.erase(item);
+		}
+
+		void OnGaveUp(int&, const int& item) override
+		{
+			m_GaveUp.push_back(item);
+		}
+	};
+}
+
+TEST_CASE("tf2bd_batched_action", "[BatchedAction]")
+{
+	using Items = std::vector<int>;
+
+	TestBatchedAction action;
+	for (int i = 1; i <= 7; i++)
+		action.Queue(i);
+
+	const time_point_t start = tfbd_clock_t::now();  // Everything was queued before this
+	const auto At = [&](int hours) { return start + std::chrono::hours(hours); };
+
+	SECTION("Batches are split at GetMaxBatchSize(), oldest first")
+	{
+		action.Update(At(0));
+		action.Update(At(1));
+		action.Update(At(2));
+
+		REQUIRE(action.m_Sent.size() == 3);
+		REQUIRE(action.m_Sent[0].m_Items == Items{ 1, 2, 3 });
+		REQUIRE(action.m_Sent[1].m_Items == Items{ 4, 5, 6 });
+		REQUIRE(action.m_Sent[2].m_Items == Items{ 7 });
+	}
+	SECTION("Never more than MAX_IN_FLIGHT batches")
+	{
+		action.m_MaxBatchSize = 1;
+		for (int i = 0; i < 10; i++)
+			action.Update(At(i));
+
+		REQUIRE(action.m_Sent.size() == TestBatchedAction::MAX_IN_FLIGHT);
+		REQUIRE(action.GetStats().m_InFlightBatches == TestBatchedAction::MAX_IN_FLIGHT);
+
+		action.m_Sent[0].m_Response.set_value(action.m_Sent[0].m_Items);
+		action.Update(At(10));
+		REQUIRE(action.m_Sent.size() == TestBatchedAction::MAX_IN_FLIGHT + 1);
+		REQUIRE(action.GetStats().m_ItemsCompleted == 1);
+	}
+	SECTION("Unanswered items go out again first, and keep their queue time")
+	{
+		action.Update(At(0));
+		action.m_Sent[0].m_Response.set_value(Items{ 1 });
+
+		action.Update(At(1));
+		REQUIRE(action.m_Sent.size() == 2);
+		REQUIRE(action.m_Sent[1].m_Items == Items{ 2, 3, 4 });
+
+		action.m_Sent[1].m_Response.set_value(Items{ 2, 3, 4 });
+		action.Update(At(2));
+
+		// Would be about an hour if the queue time had been reset when 2 and 3 were requeued
+		const BatchedActionStats stats = action.GetStats();
+		REQUIRE(stats.m_ItemsCompleted == 4);
+		REQUIRE(stats.m_MaxTimeToData >= std::chrono::hours(2));
+	}
+	SECTION("Failed batches are requeued")
+	{
+		action.Update(At(0));
+		action.m_Sent[0].m_Response.set_exception(std::make_exception_ptr(std::runtime_error("test failure")));
+
+		action.Update(At(1));
+		REQUIRE(action.GetStats().m_Failed == 1);
+		REQUIRE(action.m_Sent.size() == 2);
+		REQUIRE(action.m_Sent[1].m_Items == Items{ 1, 2, 3 });
+		REQUIRE(action.IsQueued(1));
+	}
+	SECTION("Items that never get an answer are given up on")
+	{
+		action.m_MaxBatchSize = 1;
+		constexpr int MAX_ATTEMPTS = TestBatchedAction::MAX_ATTEMPTS;
+		for (int i = 0; i < MAX_ATTEMPTS; i++)
+		{
+			action.Update(At(i));
+			REQUIRE(action.m_GaveUp.empty());
+			REQUIRE(action.m_Sent.back().m_Items == Items{ 1 });
+			action.m_Sent.back().m_Response.set_value(Items{});
+		}
+
+		action.Update(At(MAX_ATTEMPTS));
+		REQUIRE(action.m_GaveUp == Items{ 1 });
+		REQUIRE(!action.IsQueued(1));
+		REQUIRE(action.GetStats().m_ItemsGivenUp == 1);
+		REQUIRE(action.m_Sent.back().m_Items == Items{ 2 });
+	}
+	SECTION("Having nothing to send with doesn't back off, or count as an attempt")
+	{
+		action.m_Available = false;
+		for (int i = 0; i < 10; i++)
+			action.Update(At(i));
+
+		REQUIRE(action.m_Sent.empty());
+		REQUIRE(action.m_GaveUp.empty());
+		REQUIRE(action.IsQueued(1));
+		REQUIRE(action.GetStats().m_Interval == BatchedActionPacer::INITIAL_INTERVAL);
+
+		action.m_Available = true;
+		action.Update(At(10));
+		REQUIRE(action.m_Sent.size() == 1);
+		REQUIRE(action.m_Sent[0].m_Items == Items{ 1, 2, 3 });
+	}
+}
@@ -0,0 +1,296 @@
+#include "Config/ChatWrapperMatcher.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std::string_view_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	// The original ConsoleLogParser::ParseChatMessage() loop, for comparison
+	ChatWrapperMatchResult ReferenceMatch(const ChatWrappers& wrappers, const std::string_view& text, ChatWrapperMatch& match)
+	{
+		for (int i = 0; i < (int)ChatCategory::COUNT; i++)
+		{
+			auto& type = wrappers.m_Types[i];
+			if (!text.starts_with(type.m_Full.m_Start.m_Narrow))
+				continue;
+
+			auto searchBuf = text.substr(type.m_Full.m_Start.m_Narrow.size());
+			const auto found = searchBuf.find(type.m_Full.m_End.m_Narrow);
+			if (found == searchBuf.npos)
+				return ChatWrapperMatchResult::Incomplete;
+
+			searchBuf = searchBuf.substr(0, found);
+
+			match = {};
+			match.m_Category = ChatCategory(i);
+			match.m_BodyLength = found;
+			match.m_Length = type.m_Full.m_Start.m_Narrow.size() + found + type.m_Full.m_End.m_Narrow.size();
+			match.m_NameBegin = searchBuf.find(type.m_Name.m_Start.m_Narrow);
+			match.m_NameEnd = searchBuf.find(type.m_Name.m_End.m_Narrow);
+			match.m_MessageBegin = searchBuf.find(type.m_Message.m_Start.m_Narrow);
+			match.m_MessageEnd = searchBuf.find(type.m_Message.m_End.m_Narrow);
+
+			if (match.HasNameAndMessage())
+			{
+				match.m_Name = searchBuf.substr(
+					match.m_NameBegin + type.m_Name.m_Start.m_Narrow.size(),
+					match.m_NameEnd - match.m_NameBegin - type.m_Name.m_Start.m_Narrow.size());
+
+				match.m_Message = searchBuf.substr(
+					match.m_MessageBegin + type.m_Message.m_Start.m_Narrow.size(),
+					match.m_MessageEnd - match.m_MessageBegin - type.m_Message.m_Start.m_Narrow.size());
+			}
+
+			return ChatWrapperMatchResult::Match;
+		}
+
+		return ChatWrapperMatchResult::NotChat;
+	}
+
+	constexpr std::string_view INVISIBLE_CHARS[] =
+	{
+		"\xE2\x80\x8B", "\xE2\x80\x8C", "\xE2\x80\x8D", "\xEF\xBB\xBF", "\xE2\x81\xA0",
+	};
+
+	// Readable wrappers that can't be confused with each other
+	ChatWrappers MakeReadableWrappers()
+	{
+		ChatWrappers wrappers;
+		for (size_t i = 0; i < size_t(ChatCategory::COUNT); i++)
+		{
+			auto& type = wrappers.m_Types[i];
+			type.m_Full.m_Start.m_Narrow = "[full" + std::to_string(i) + "]";
+			type.m_Full.m_End.m_Narrow = "[/full" + std::to_string(i) + "]";
+			type.m_Name.m_Start.m_Narrow = "[name" + std::to_string(i) + "]";
+			type.m_Name.m_End.m_Narrow = "[/name" + std::to_string(i) + "]";
+			type.m_Message.m_Start.m_Narrow = "[msg" + std::to_string(i) + "]";
+			type.m_Message.m_End.m_Narrow = "[/msg" + std::to_string(i) + "]";
+		}
+
+		return wrappers;
+	}
+
+	// Same as the real ones: unique sequences of three invisible characters, which overlap
+	// each other all the time
+	ChatWrappers MakeInvisibleWrappers(uint32_t seed)
+	{
+		std::mt19937 random(seed);
+		std::vector<std::string> generated;
+		const auto Generate = [&](ChatWrappers::wrapper_t& wrapper)
+		{
+			do
+			{
+				wrapper.m_Narrow.clear();
+				for (int i = 0; i < 3; i++)
+					wrapper.m_Narrow += INVISIBLE_CHARS[random() % std::size(INVISIBLE_CHARS)];
+
+			} while (std::find(generated.begin(), generated.end(), wrapper.m_Narrow) != generated.end());
+
+			generated.push_back(wrapper.m_Narrow);
+		};
+
+		ChatWrappers wrappers;
+		for (auto& type : wrappers.m_Types)
+		{
+			for (auto* pair : { &type.m_Full, &type.m_Name, &type.m_Message })
+			{
+				Generate(pair->m_Start);
+				Generate(pair->m_End);
+			}
+		}
+
+		return wrappers;
+	}
+
+	std::string WrapChatMessage(const ChatWrappers& wrappers, ChatCategory category,
+		const std::string_view& name, const std::string_view& msg)
+	{
+		const auto& type = wrappers.m_Types[size_t(category)];
+
+		std::string text;
+		text += type.m_Full.m_Start.m_Narrow;
+		text += type.m_Name.m_Start.m_Narrow;
+		text += name;
+		text += type.m_Name.m_End.m_Narrow;
+		text += " :  ";
+		text += type.m_Message.m_Start.m_Narrow;
+		text += msg;
+		text += type.m_Message.m_End.m_Narrow;
+		text += type.m_Full.m_End.m_Narrow;
+		return text;
+	}
+
+	// Chat messages, plus every kind of broken, truncated or adversarial wrapper sequence we
+	// can come up with (the wrappers are all built out of the same handful of invisible
+	// characters, so they overlap each other a lot)
+	std::vector<std::string> GenerateTestLines(const ChatWrappers& wrappers, size_t count, bool chatOnly)
+	{
+		constexpr std::string_view FRAGMENTS[] =
+		{
+			"Pootis", "Engineer", " :  ", "gaben", "\n", "a", "\xE2\x80", "\xE2",
+		};
+
+		std::mt19937 random(1234);
+		const auto RandomIndex = [&](size_t size) { return std::uniform_int_distribution<size_t>(0, size - 1)(random); };
+
+		const auto RandomMarker = [&]() -> const std::string&
+		{
+			const auto& type = wrappers.m_Types[RandomIndex(size_t(ChatCategory::COUNT))];
+			const ChatWrappers::WrapperPair* pairs[] = { &type.m_Full, &type.m_Name, &type.m_Message };
+			const auto* pair = pairs[RandomIndex(std::size(pairs))];
+			return RandomIndex(2) ? pair->m_Start.m_Narrow : pair->m_End.m_Narrow;
+		};
+
+		const auto RandomText = [&]
+		{
+			std::string text;
+			for (size_t i = RandomIndex(6); i > 0; i--)
+			{
+				switch (RandomIndex(3))
+				{
+				case 0: text += FRAGMENTS[RandomIndex(std::size(FRAGMENTS))]; break;
+				case 1: text += INVISIBLE_CHARS[RandomIndex(std::size(INVISIBLE_CHARS))]; break;
+				case 2: text += RandomMarker(); break;
+				}
+			}
+			return text;
+		};
+
+		std::vector<std::string> lines;
+		while (lines.size() < count)
+		{
+			const auto category = ChatCategory(RandomIndex(size_t(ChatCategory::COUNT)));
+			std::string line = WrapChatMessage(wrappers, category, chatOnly ? "Pootis" : RandomText(),
+				chatOnly ? "trading unusuals, add me" : RandomText());
+
+			if (!chatOnly)
+			{
+				switch (RandomIndex(6))
+				{
+				case 0: // Truncated
+					line.resize(RandomIndex(line.size() + 1));
+					break;
+				case 1: // Garbage inserted somewhere
+					line.insert(RandomIndex(line.size() + 1), RandomText());
+					break;
+				case 2: // Not chat at all
+					line = RandomText();
+					break;
+				default:
+					break;
+				}
+
+				line += RandomText();
+			}
+
+			lines.push_back(std::move(line));
+		}
+
+		return lines;
+	}
+
+	void RequireSameMatch(const ChatWrapperMatch& lhs, const ChatWrapperMatch& rhs)
+	{
+		REQUIRE(lhs.m_Category == rhs.m_Category);
+		REQUIRE(lhs.m_Length == rhs.m_Length);
+		REQUIRE(lhs.m_BodyLength == rhs.m_BodyLength);
+		REQUIRE(lhs.m_NameBegin == rhs.m_NameBegin);
+		REQUIRE(lhs.m_NameEnd == rhs.m_NameEnd);
+		REQUIRE(lhs.m_MessageBegin == rhs.m_MessageBegin);
+		REQUIRE(lhs.m_MessageEnd == rhs.m_MessageEnd);
+		REQUIRE(lhs.m_Name.data() == rhs.m_Name.data());
+		REQUIRE(lhs.m_Name.size() == rhs.m_Name.size());
+		REQUIRE(lhs.m_Message.data() == rhs.m_Message.data());
+		REQUIRE(lhs.m_Message.size() == rhs.m_Message.size());
+	}
+}
+
+TEST_CASE("tf2bd_chat_wrapper_matcher", "[ChatWrappers]")
+{
+	SECTION("Basic")
+	{
+		const ChatWrappers wrappers = MakeReadableWrappers();
+		const ChatWrapperMatcher matcher(wrappers);
+
+		for (size_t i = 0; i < size_t(ChatCategory::COUNT); i++)
+		{
+			const auto category = ChatCategory(i);
+			const auto text = WrapChatMessage(wrappers, category, "Pootis", "hello\nworld") + "\n01/02/2021 - 00:00:00: next line";
+
+			ChatWrapperMatch match;
+			REQUIRE(matcher.Match(text, match) == ChatWrapperMatchResult::Match);
+			REQUIRE(match.m_Category == category);
+			REQUIRE(match.m_Name == "Pootis"sv);
+			REQUIRE(match.m_Message == "hello\nworld"sv);
+			REQUIRE(text.substr(match.m_Length) == "\n01/02/2021 - 00:00:00: next line"sv);
+
+			REQUIRE(matcher.Match(std::string_view(text).substr(0, match.m_Length - 1), match) == ChatWrapperMatchResult::Incomplete);
+		}
+
+		ChatWrapperMatch match;
+		REQUIRE(matcher.Match("", match) == ChatWrapperMatchResult::NotChat);
+		REQUIRE(matcher.Match("Pootis killed Engineer with scattergun.", match) == ChatWrapperMatchResult::NotChat);
+	}
+
+	SECTION("Parity")
+	{
+		for (uint32_t seed = 0; seed < 8; seed++)
+		{
+			INFO("Seed: " << seed);
+			const ChatWrappers wrappers = MakeInvisibleWrappers(seed);
+			const ChatWrapperMatcher matcher(wrappers);
+
+			for (const auto& line : GenerateTestLines(wrappers, 5'000, false))
+			{
+				ChatWrapperMatch expected, actual;
+				const auto expectedResult = ReferenceMatch(wrappers, line, expected);
+				REQUIRE(matcher.Match(line, actual) == expectedResult);
+
+				if (expectedResult == ChatWrapperMatchResult::Match)
+					RequireSameMatch(actual, expected);
+			}
+		}
+	}
+}
+
+TEST_CASE("tf2bd_chat_wrapper_matcher_benchmark", "[ChatWrappers][.benchmark]")
+{
+	const ChatWrappers wrappers = MakeInvisibleWrappers(0);
+	const ChatWrapperMatcher matcher(wrappers);
+
+	// A trade server or a spam bot: nearly everything is chat
+	const auto chatLines = GenerateTestLines(wrappers, 10'000, true);
+
+	// A regular game: most lines aren't chat
+	std::vector<std::string> mixedLines;
+	for (size_t i = 0; i < chatLines.size(); i++)
+		mixedLines.push_back((i % 10) ? "Pootis killed Engineer with scattergun." : chatLines[i]);
+
+	const auto Run = [&](const std::vector<std::string>& lines, auto&& func)
+	{
+		size_t total = 0;
+		ChatWrapperMatch match;
+		for (const auto& line : lines)
+		{
+			if (func(line, match) == ChatWrapperMatchResult::Match)
+				total += match.m_Length;
+		}
+
+		return total;
+	};
+
+	const auto Reference = [&](const std::string_view& text, ChatWrapperMatch& match) { return ReferenceMatch(wrappers, text, match); };
+	const auto Matcher = [&](const std::string_view& text, ChatWrapperMatch& match) { return matcher.Match(text, match); };
+
+	BENCHMARK("Chat heavy, reference") { return Run(chatLines, Reference); };
+	BENCHMARK("Chat heavy, ChatWrapperMatcher") { return Run(chatLines, Matcher); };
+	BENCHMARK("Mixed, reference") { return Run(mixedLines, Reference); };
+	BENCHMARK("Mixed, ChatWrapperMatcher") { return Run(mixedLines, Matcher); };
+}
@@ -0,0 +1,212 @@
+#include "ConsoleLog/ConsoleLineCoalescer.h"
+#include "ConsoleLog/ConsoleLines.h"
+#include "ConsoleLog/NetworkStatus.h"
+#include "GameData/UserMessageType.h"
+
+#include <catch2/catch.hpp>
+
+#include <array>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	struct Dispatched
+	{
+		std::vector<std::shared_ptr<IConsoleLine>> m_Lines;
+
+		void operator()(IConsoleLine& line) { m_Lines.push_back(line.shared_from_this()); }
+	};
+
+	std::shared_ptr<IConsoleLine> MakeVoice(time_point_t timestamp, uint8_t entindex, uint16_t bufSize)
+	{
+		return std::make_shared<VoiceReceiveLine>(timestamp, uint8_t(0), entindex, bufSize);
+	}
+
+	std::shared_ptr<IConsoleLine> MakeUserMessage(time_point_t timestamp, UserMessageType type, uint16_t bytes)
+	{
+		return std::make_shared<SVCUserMessageLine>(timestamp, "192.168.0.1:27015", type, bytes);
+	}
+
+	std::shared_ptr<IConsoleLine> MakeOther(time_point_t timestamp)
+	{
+		return std::make_shared<EdictUsageLine>(timestamp, uint16_t(1000), uint16_t(2048));
+	}
+
+	// Feeds lines through the coalescer the same way the WorldState broadcaster does
+	void Feed(ConsoleLineCoalescer& coalescer, Dispatched& dispatched, const std::shared_ptr<IConsoleLine>& line)
+	{
+		if (!coalescer.AddLine(*line, dispatched))
+			dispatched(*line);
+	}
+}
+
+TEST_CASE("tf2bd_console_line_coalescer", "[ConsoleLines]")
+{
+	const time_point_t tick1(1s);
+	const time_point_t tick2(2s);
+
+	ConsoleLineCoalescer coalescer;
+	Dispatched dispatched;
+
+	SECTION("Voice is summed per entity per tick")
+	{
+		Feed(coalescer, dispatched, MakeVoice(tick1, 3, 100));
+		Feed(coalescer, dispatched, MakeVoice(tick1, 5, 50));
+		Feed(coalescer, dispatched, MakeVoice(tick1, 3, 120));
+		REQUIRE(dispatched.m_Lines.empty());
+		REQUIRE(coalescer.HasPending());
+
+		Feed(coalescer, dispatched, MakeVoice(tick2, 3, 10));
+		REQUIRE(dispatched.m_Lines.size() == 1);
+		REQUIRE(dispatched.m_Lines[0]->GetType() == ConsoleLineType::VoiceReceiveSummary);
+		REQUIRE(dispatched.m_Lines[0]->GetTimestamp() == tick1);
+
+		const auto& entities = static_cast<const VoiceReceiveSummaryLine&>(*dispatched.m_Lines[0]).GetEntities();
+		REQUIRE(entities.size() == 2);
+		REQUIRE(entities[0].m_EntIndex == 3);
+		REQUIRE(entities[0].m_Packets == 2);
+		REQUIRE(entities[0].m_Bytes == 220);
+		REQUIRE(entities[1].m_EntIndex == 5);
+		REQUIRE(entities[1].m_Packets == 1);
+		REQUIRE(entities[1].m_Bytes == 50);
+
+		coalescer.Flush(dispatched);
+		REQUIRE(dispatched.m_Lines.size() == 2);
+		REQUIRE(dispatched.m_Lines[1]->GetTimestamp() == tick2);
+		REQUIRE(!coalescer.HasPending());
+
+		REQUIRE(coalescer.GetStats().m_LinesCoalesced == 4);
+		REQUIRE(coalescer.GetStats().m_SummariesEmitted == 2);
+	}
+	SECTION("Summaries come after the lines they summarize, and before anything after those")
+	{
+		Feed(coalescer, dispatched, MakeVoice(tick1, 3, 100));
+		Feed(coalescer, dispatched, MakeOther(tick1));
+		Feed(coalescer, dispatched, MakeVoice(tick1, 3, 100));
+		Feed(coalescer, dispatched, MakeOther(tick2));
+
+		REQUIRE(dispatched.m_Lines.size() == 4);
+		REQUIRE(dispatched.m_Lines[0]->GetType() == ConsoleLineType::VoiceReceiveSummary);
+		REQUIRE(dispatched.m_Lines[1]->GetType() == ConsoleLineType::EdictUsage);
+		REQUIRE(dispatched.m_Lines[2]->GetType() == ConsoleLineType::VoiceReceiveSummary);
+		REQUIRE(dispatched.m_Lines[2]->GetTimestamp() == tick1);
+		REQUIRE(dispatched.m_Lines[3]->GetType() == ConsoleLineType::EdictUsage);
+		REQUIRE(dispatched.m_Lines[3]->GetTimestamp() == tick2);
+	}
+	SECTION("User messages from the old server are summarized before connecting to a new one")
+	{
+		Feed(coalescer, dispatched, MakeUserMessage(tick1, UserMessageType::SayText2, 40));
+		Feed(coalescer, dispatched, MakeUserMessage(tick1, UserMessageType::TextMsg, 20));
+		Feed(coalescer, dispatched, std::make_shared<ConnectingLine>(tick1, "10.0.0.1:27015", false, false));
+		Feed(coalescer, dispatched, MakeUserMessage(tick1, UserMessageType::SayText2, 30));
+
+		REQUIRE(dispatched.m_Lines.size() == 2);
+		REQUIRE(dispatched.m_Lines[0]->GetType() == ConsoleLineType::SVCUserMessageSummary);
+		REQUIRE(static_cast<const SVCUserMessageSummaryLine&>(*dispatched.m_Lines[0]).GetMessages().size() == 2);
+		REQUIRE(dispatched.m_Lines[1]->GetType() == ConsoleLineType::Connecting);
+
+		coalescer.Flush(dispatched);
+		REQUIRE(dispatched.m_Lines.size() == 3);
+		REQUIRE(static_cast<const SVCUserMessageSummaryLine&>(*dispatched.m_Lines[2]).GetMessages()[0].m_Bytes == 30);
+	}
+	SECTION("Vote messages are never coalesced")
+	{
+		Feed(coalescer, dispatched, MakeUserMessage(tick1, UserMessageType::SayText2, 40));
+		Feed(coalescer, dispatched, MakeUserMessage(tick1, UserMessageType::VoteStart, 60));
+		Feed(coalescer, dispatched, MakeUserMessage(tick1, UserMessageType::SayText2, 20));
+
+		REQUIRE(dispatched.m_Lines.size() == 2);
+		REQUIRE(dispatched.m_Lines[0]->GetType() == ConsoleLineType::SVCUserMessageSummary);
+		REQUIRE(dispatched.m_Lines[1]->GetType() == ConsoleLineType::SVC_UserMessage);
+
+		coalescer.Flush(dispatched);
+		REQUIRE(dispatched.m_Lines.size() == 3);
+
+		for (size_t i : { 0, 2 })
+		{
+			auto& summary = static_cast<const SVCUserMessageSummaryLine&>(*dispatched.m_Lines[i]);
+			REQUIRE(summary.GetAddress() == "192.168.0.1:27015");
+			REQUIRE(summary.GetMessages().size() == 1);
+			REQUIRE(summary.GetMessages()[0].m_Type == UserMessageType::SayText2);
+			REQUIRE(summary.GetMessages()[0].m_Count == 1);
+		}
+
+		REQUIRE(IsVoteUserMessage(UserMessageType::VoteStart));
+		REQUIRE(!IsVoteUserMessage(UserMessageType::SayText2));
+	}
+	SECTION("Types can opt out")
+	{
+		ConsoleLineCoalescer voiceOnly({ ConsoleLineType::VoiceReceive });
+		Feed(voiceOnly, dispatched, MakeUserMessage(tick1, UserMessageType::SayText2, 40));
+		Feed(voiceOnly, dispatched, MakeVoice(tick1, 3, 100));
+
+		REQUIRE(dispatched.m_Lines.size() == 1);
+		REQUIRE(dispatched.m_Lines[0]->GetType() == ConsoleLineType::SVC_UserMessage);
+	}
+}
+
+TEST_CASE("tf2bd_console_line_coalescer_benchmark", "[ConsoleLines][.benchmark]")
+{
+	// Roughly what a few people talking at once looks like with net_showmsg svc_UserMessage on:
+	// mostly voice, a steady stream of user messages, and the occasional line anyone cares about
+	std::vector<std::shared_ptr<IConsoleLine>> capture;
+	for (int i = 0; i < 10'000; i++)
+	{
+		const time_point_t timestamp(std::chrono::seconds(i / 500));
+		if ((i % 50) == 0)
+			capture.push_back(MakeOther(timestamp));
+		else if ((i % 5) == 0)
+			capture.push_back(MakeUserMessage(timestamp, UserMessageType(i % 30), uint16_t(i % 200)));
+		else
+			capture.push_back(MakeVoice(timestamp, uint8_t(i % 6), uint16_t(100 + i % 100)));
+	}
+
+	// Stand-ins for WorldState, MainWindow and DiscordState, which all switch on the type
+	struct Listener
+	{
+		void OnConsoleLineParsed(IConsoleLine& line)
+		{
+			switch (line.GetType())
+			{
+			case ConsoleLineType::EdictUsage:
+			case ConsoleLineType::SVC_UserMessage:
+			case ConsoleLineType::SVCUserMessageSummary:
+				m_Handled++;
+				break;
+			default:
+				break;
+			}
+		}
+
+		size_t m_Handled = 0;
+	};
+	std::array<Listener, 3> listeners;
+
+	const auto Dispatch = [&](IConsoleLine& line)
+	{
+		for (Listener& listener : listeners)
+			listener.OnConsoleLineParsed(line);
+	};
+
+	BENCHMARK("Dispatch every line, 10k line voice-heavy capture")
+	{
+		for (const auto& line : capture)
+			Dispatch(*line);
+
+		return listeners[0].m_Handled;
+	};
+	BENCHMARK("Coalesce, then dispatch, 10k line voice-heavy capture")
+	{
+		ConsoleLineCoalescer coalescer;
+		for (const auto& line : capture)
+		{
+			if (!coalescer.AddLine(*line, Dispatch))
+				Dispatch(*line);
+		}
+
+		coalescer.Flush(Dispatch);
+		return listeners[0].m_Handled;
+	};
+}
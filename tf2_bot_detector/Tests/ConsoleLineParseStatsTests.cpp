@@ -0,0 +1,97 @@
+#include "ConsoleLog/ConsoleLineParseStats.h"
+#include "ConsoleLog/ConsoleLines.h"
+#include "Tests/DummyWorldState.h"
+
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::string_view_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	DummyWorldState s_DummyWorldState;
+
+	const ConsoleLineTypeParseStats& FindType(const ConsoleLineParseStats& stats, const std::string_view& name)
+	{
+		auto found = std::find_if(stats.m_Types.begin(), stats.m_Types.end(),
+			[&](const ConsoleLineTypeParseStats& type) { return type.m_TypeName.ends_with(name); });
+
+		REQUIRE(found != stats.m_Types.end());
+		return *found;
+	}
+}
+
+TEST_CASE("tf2bd_conlog_parse_stats", "[ConsoleLog]")
+{
+	const bool timingEnabled = GENERATE(false, true);
+	INFO("Timing enabled: " << timingEnabled);
+
+	const bool wasTimingEnabled = ConsoleLineParseProfiler::IsTimingEnabled();
+	ConsoleLineParseProfiler::SetTimingEnabled(timingEnabled);
+	ConsoleLineParseProfiler::Reset();
+
+	constexpr auto VOICE_LINE = "Voice - chan 1, ent 7, bufsize: 128"sv;
+	constexpr auto UNPARSED_LINE = "This line doesn't look like anything tf2 prints"sv;
+
+	constexpr size_t THREAD_COUNT = 4;
+	constexpr size_t LINES_PER_THREAD = 1'000;
+	{
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < THREAD_COUNT; i++)
+		{
+			threads.emplace_back([&]
+				{
+					for (size_t line = 0; line < LINES_PER_THREAD; line++)
+					{
+						IConsoleLine::ParseConsoleLine(VOICE_LINE, tfbd_clock_t::now(), s_DummyWorldState);
+						IConsoleLine::ParseConsoleLine(UNPARSED_LINE, tfbd_clock_t::now(), s_DummyWorldState);
+					}
+				});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	const ConsoleLineParseStats stats = ConsoleLineParseProfiler::GetStats();
+	REQUIRE(stats.m_Lines == THREAD_COUNT * LINES_PER_THREAD * 2);
+	REQUIRE(stats.m_UnparsedLines == THREAD_COUNT * LINES_PER_THREAD);
+	REQUIRE(stats.m_Bytes == THREAD_COUNT * LINES_PER_THREAD * (VOICE_LINE.size() + UNPARSED_LINE.size()));
+
+	const auto& voice = FindType(stats, "VoiceReceiveLine");
+	REQUIRE(voice.m_Hits == THREAD_COUNT * LINES_PER_THREAD);
+	REQUIRE(voice.m_Attempts >= voice.m_Hits);
+	if (timingEnabled)
+	{
+		REQUIRE(voice.m_TotalTime.count() > 0);
+		REQUIRE(voice.m_P99Time.count() > 0);
+	}
+	else
+	{
+		REQUIRE(voice.m_TotalTime.count() == 0);
+		REQUIRE(stats.m_ParseTime.count() == 0);
+	}
+
+	REQUIRE(!stats.m_UnparsedSamples.empty());
+	for (const auto& sample : stats.m_UnparsedSamples)
+		REQUIRE(sample == UNPARSED_LINE);
+
+	const nlohmann::json json = stats;
+	REQUIRE(json.at("lines") == stats.m_Lines);
+	REQUIRE(json.at("unparsed_samples").size() == stats.m_UnparsedSamples.size());
+	REQUIRE(json.at("types").size() == stats.m_Types.size());
+
+	ConsoleLineParseProfiler::Reset();
+	const ConsoleLineParseStats resetStats = ConsoleLineParseProfiler::GetStats();
+	REQUIRE(resetStats.m_Lines == 0);
+	REQUIRE(resetStats.m_UnparsedSamples.empty());
+	REQUIRE(FindType(resetStats, "VoiceReceiveLine").m_Attempts == 0);
+
+	ConsoleLineParseProfiler::SetTimingEnabled(wasTimingEnabled);
+}
@@ -0,0 +1,352 @@
+#include "ConsoleLog/ConsoleLinePatterns.h"
+
+#include <catch2/catch.hpp>
+
+#include <initializer_list>
+#include <regex>
+#include <string>
+#include <string_view>
+
+using namespace tf2_bot_detector;
+using namespace std::string_view_literals;
+
+namespace
+{
+	template<typename TPattern, size_t TGroupCount>
+	void CheckParity(const char* regexStr, std::initializer_list<std::string_view> lines)
+	{
+		const std::regex regex(regexStr, std::regex::optimize);
+		REQUIRE(regex.mark_count() == TGroupCount);
+
+		size_t matchCount = 0;
+		for (const std::string_view& line : lines)
+		{
+			INFO("Pattern: " << regexStr);
+			INFO("Line: " << std::string(line));
+
+			std::match_results<const char*> expected;
+			const bool expectedMatch = std::regex_match(line.data(), line.data() + line.size(), expected, regex);
+
+			StaticRegex::Groups<TGroupCount> actual;
+			const bool actualMatch = StaticRegex::FullMatch<TPattern>(line, actual);
+
+			REQUIRE(actualMatch == expectedMatch);
+			if (!expectedMatch)
+				continue;
+
+			matchCount++;
+			for (size_t i = 0; i <= TGroupCount; i++)
+			{
+				INFO("Group " << i);
+				REQUIRE(actual[i].matched == expected[i].matched);
+				if (expected[i].matched)
+				{
+					CHECK(actual[i].first == expected[i].first);
+					CHECK(actual[i].second == expected[i].second);
+				}
+			}
+		}
+
+		// Every corpus should exercise the positive path at least once
+		CHECK(matchCount > 0);
+	}
+}
+
+TEST_CASE("tf2bd_conline_pattern_parity", "[ConsoleLog]")
+{
+	using namespace ConsoleLinePatterns;
+
+	CheckParity<LobbyHeader, 3>(R"regex(CTFLobbyShared: ID:([0-9a-f]*)\s+(\d+) member\(s\), (\d+) pending)regex",
+		{
+			"CTFLobbyShared: ID:0002b4cf6ea1c5b5  24 member(s), 0 pending",
+			"CTFLobbyShared: ID:  12 member(s), 3 pending",
+			"CTFLobbyShared: ID:0002B4CF  24 member(s), 0 pending",
+			"CTFLobbyShared: ID:0002b4cf6ea1c5b5 24 member(s), 0 pending ",
+			"CTFLobbyShared: ID:0002b4cf6ea1c5b524 member(s), 0 pending",
+		});
+
+	CheckParity<LobbyMember, 5>(R"regex(\s+(?:(?:Member)|(Pending))\[(\d+)\] (\[.*\])\s+team = (\w+)\s+type = (\w+))regex",
+		{
+			"  Member[0] [U:1:1009448286]  team = TF_GC_TEAM_DEFENDERS  type = MATCH_PLAYER",
+			"  Pending[12] [U:1:1009448286]  team = TF_GC_TEAM_INVADERS  type = MATCH_PLAYER",
+			"\tMember[3] [U:1:1] [U:1:2]  team = TF_GC_TEAM_DEFENDERS  type = MATCH_PLAYER",
+			"Member[0] [U:1:1009448286]  team = TF_GC_TEAM_DEFENDERS  type = MATCH_PLAYER",
+			"  Member[] [U:1:1009448286]  team = TF_GC_TEAM_DEFENDERS  type = MATCH_PLAYER",
+			"  Member[0] [U:1:1009448286]  team = TF_GC_TEAM_DEFENDERS  type = ",
+		});
+
+	CheckParity<ServerStatusPlayer, 10>(R"regex(#\s+(\d+)\s+"((?:.|[\r\n])+)"\s+(\[.*\])\s+(?:(\d+):)?(\d+):(\d+)\s+(\d+)\s+(\d+)\s+(\w+)(?:\s+(\S+))?)regex",
+		{
+			R"(#    348 "Pootis" [U:1:1118537734] 00:51  157    0 active)",
+			R"(#    348 "Pootis" [U:1:1118537734] 1:00:51  157    0 active 169.254.1.1:27005)",
+			R"(#      2 "name with "quotes" in it"   [U:1:12345] 12:34   48    0 spawning)",
+			"#      3 \"multi\nline\"   [U:1:12345] 12:34   48    0 active",
+			R"(#    348 "" [U:1:1118537734] 00:51  157    0 active)",
+			R"(#    348 "Pootis" [U:1:1118537734] 00:51  157    0)",
+			R"(#348 "Pootis" [U:1:1118537734] 00:51  157    0 active)",
+		});
+
+	CheckParity<ServerStatusShortPlayer, 2>(R"regex(#(\d+) - (.+))regex",
+		{
+			"#2 - Pootis",
+			"#12 - name - with - dashes",
+			"#2 - ",
+			"# 2 - Pootis",
+		});
+
+	CheckParity<KillNotification, 4>(R"regex((.*) killed (.*) with (.*)\.( \(crit\))?)regex",
+		{
+			"Sniper killed Heavy with sniperrifle.",
+			"Sniper killed Heavy with sniperrifle. (crit)",
+			"a killed b killed c with d with e. (crit)",
+			"Dr. Evil killed Mr. Bigglesworth with tf_projectile_rocket.",
+			" killed  with .",
+			"Sniper killed Heavy with sniperrifle",
+			"Sniper killed Heavy with sniperrifle. (crit) ",
+			"Sniper killed Heavy using sniperrifle.",
+		});
+
+	CheckParity<CvarlistConvar, 4>(R"regex((\S+)\s+:\s+([-\d.]+)\s+:\s+(.+)?\s+:[\t ]+(.+)?)regex",
+		{
+			"tf_bot_quota                             : 0        : , \"sv\", \"nf\" : Determines the total number of tf bots in the game.",
+			"sv_cheats                                : 0        : , \"nf\", \"rep\" : \t Allow cheats on server",
+			"cl_interp                                : 0.1      :  , \"a\", \"user\" : ",
+			"net_graph                                : -1       :            :\t",
+			"sv_cheats                                : zero     : , \"nf\"     : Allow cheats",
+			"not a convar line",
+		});
+
+	CheckParity<VoiceReceive, 3>(R"regex(Voice - chan (\d+), ent (\d+), bufsize: (\d+))regex",
+		{
+			"Voice - chan 1, ent 7, bufsize: 128",
+			"Voice - chan 1, ent -7, bufsize: 128",
+			"Voice - chan 1, ent 7, bufsize: 128 ",
+		});
+
+	CheckParity<ServerStatusPlayerCount, 3>(R"regex(players : (\d+) humans, (\d+) bots \((\d+) max\))regex",
+		{
+			"players : 24 humans, 0 bots (32 max)",
+			"players : 24 humans, 0 bots (32 max",
+			"players : 24 humans 0 bots (32 max)",
+		});
+
+	CheckParity<EdictUsage, 2>(R"regex(edicts  : (\d+) used of (\d+) max)regex",
+		{
+			"edicts  : 1187 used of 2048 max",
+			"edicts : 1187 used of 2048 max",
+		});
+
+	CheckParity<Ping, 2>(R"regex( *(\d+) ms : (.{1,32}))regex",
+		{
+			" 57 ms : Pootis",
+			"105 ms : name with spaces",
+			"  7 ms : 12345678901234567890123456789012",
+			"  7 ms : 123456789012345678901234567890123",
+			"  7 ms : ",
+			" 57 ms : two\nlines",
+		});
+
+	CheckParity<SVCUserMessage, 3>(R"regex(Msg from ((?:\d+\.\d+\.\d+\.\d+:\d+)|loopback): svc_UserMessage: type (\d+), bytes (\d+))regex",
+		{
+			"Msg from 169.254.1.1:27015: svc_UserMessage: type 4, bytes 61",
+			"Msg from loopback: svc_UserMessage: type 5, bytes 12",
+			"Msg from 169.254.1:27015: svc_UserMessage: type 4, bytes 61",
+			"Msg from localhost: svc_UserMessage: type 4, bytes 61",
+		});
+
+	CheckParity<ConfigExecNotPresent, 1>(R"regex('(.*)' not present; not executing\.)regex",
+		{
+			"'cfg/user/autoexec.cfg' not present; not executing.",
+			"'it's' not present; not executing.",
+			"'' not present; not executing.",
+			"'cfg/user/autoexec.cfg' not present; not executing",
+		});
+
+	CheckParity<ServerStatusMap, 4>(R"regex(map     : (.*) at: ((?:-|\d)+) x, ((?:-|\d)+) y, ((?:-|\d)+) z)regex",
+		{
+			"map     : cp_process_final at: 0 x, 0 y, 0 z",
+			"map     : pl_upward at: -1024 x, 512 y, -64 z",
+			"map     : weird at: name at: 1 x, 2 y, 3 z",
+			"map     : cp_process_final at: 0.5 x, 0 y, 0 z",
+		});
+
+	CheckParity<Connecting, 3>(R"regex(Connecting to( matchmaking server)? (.*?)(\.\.\.)?)regex",
+		{
+			"Connecting to 169.254.1.1:27015...",
+			"Connecting to matchmaking server 169.254.1.1:27015...",
+			"Connecting to 169.254.1.1:27015",
+			"Connecting to .....",
+			"Connecting to ",
+			"Connecting to169.254.1.1:27015...",
+		});
+
+	CheckParity<Retrying, 1>(R"regex(Retrying (.*)\.\.\.)regex",
+		{
+			"Retrying 169.254.1.1:27015...",
+			"Retrying ......",
+			"Retrying 169.254.1.1:27015",
+		});
+
+	CheckParity<PartyHeader, 3>(R"regex(TFParty:\s+ID:([0-9a-f]+)\s+(\d+) member\(s\)\s+LeaderID: (\[.*\]))regex",
+		{
+			"TFParty: ID:2d8a58  1 member(s)  LeaderID: [U:1:1009448286]",
+			"TFParty:\tID:2d8a58 \t3 member(s)\tLeaderID: [U:1:1009448286]",
+			"TFParty: ID:  1 member(s)  LeaderID: [U:1:1009448286]",
+			"TFParty: ID:2d8a58  1 member(s)  LeaderID: U:1:1009448286",
+		});
+
+	CheckParity<InQueue, 3>(R"regex(    MatchGroup: (\d+)\s+Started matchmaking:\s+(.*)\s+\(\d+ seconds ago, now is (.*)\))regex",
+		{
+			"    MatchGroup: 7  Started matchmaking: Sat Oct 10 15:03:04 2020  (27 seconds ago, now is Sat Oct 10 15:03:31 2020)",
+			"    MatchGroup: 0\tStarted matchmaking:\tThu Jan 01 00:00:00 1970 (0 seconds ago, now is (soon))",
+			"    MatchGroup: 7  Started matchmaking: Sat Oct 10 15:03:04 2020 (? seconds ago, now is Sat Oct 10 15:03:31 2020)",
+		});
+
+	CheckParity<ServerJoin, 6>(R"regex(\n(.*)\nMap: (.*)\nPlayers: (\d+) \/ (\d+)\nBuild: (\d+)\nServer Number: (\d+)\s+)regex",
+		{
+			"\nValve Matchmaking Server (Virginia iad-1/srcds150 #12)\nMap: pl_upward\nPlayers: 24 / 24\nBuild: 6113698\nServer Number: 4\n\n",
+			"\nTeam Fortress\nMap: cp_process_final\nPlayers: 1 / 32\nBuild: 6113698\nServer Number: 1 ",
+			"\nTeam Fortress\nMap: cp_process_final\nPlayers: 1 / 32\nBuild: 6113698\nServer Number: 1",
+		});
+
+	CheckParity<ServerDroppedPlayer, 2>(R"regex(Dropped (.*) from server \((.*)\))regex",
+		{
+			"Dropped Pootis from server (Disconnect by user.)",
+			"Dropped (a) from server (b) from server (c)",
+			"Dropped Pootis from server Disconnect by user.",
+		});
+
+	CheckParity<ServerStatusPlayerIP, 2>(R"regex(udp\/ip  : (.*)  \(public ip: (.*)\))regex",
+		{
+			"udp/ip  : 0.0.0.0:27015  (public ip: 169.254.1.1)",
+			"udp/ip  : 0.0.0.0:27015 (public ip: 169.254.1.1)",
+		});
+
+	CheckParity<DifferingLobbyReceived, 9>(R"regex(Differing lobby received\. Lobby: (.*)\/Match(\d+)\/Lobby(\d+) CurrentlyAssigned: (.*)\/Match(\d+)\/Lobby(\d+) ConnectedToMatchServer: (\d+) HasLobby: (\d+) AssignedMatchEnded: (\d+))regex",
+		{
+			"Differing lobby received. Lobby: [A:1:2921694235:15291]/Match555616127/Lobby36039473432519683 CurrentlyAssigned: [A:1:2921694235:15291]/Match555616127/Lobby36039473432519683 ConnectedToMatchServer: 1 HasLobby: 1 AssignedMatchEnded: 0",
+			"Differing lobby received. Lobby: [I:0:0]/Match0/Lobby0 CurrentlyAssigned: [A:1:2921694235:15291]/Match555616127/Lobby36039473432519683 ConnectedToMatchServer: 0 HasLobby: 0 AssignedMatchEnded: 1",
+			"Differing lobby received. Lobby: [I:0:0]/Match0/Lobby0 ConnectedToMatchServer: 0 HasLobby: 0 AssignedMatchEnded: 1",
+		});
+
+	CheckParity<MatchmakingBannedTime, 2>(R"regex((?:(casual)|(?:ranked))_banned_time: (\d+))regex",
+		{
+			"casual_banned_time: 0",
+			"ranked_banned_time: 1602355200",
+			"competitive_banned_time: 0",
+		});
+
+	CheckParity<SplitPacket, 7>(R"regex(<-- \[(.{3})\] Split packet +(\d+)\/ +(\d+) seq +(\d+) size +(\d+) mtu +(\d+) from ([0-9.:a-fA-F]+:\d+))regex",
+		{
+			"<-- [cl ] Split packet    1/   3 seq 11463 size 1200 mtu 1200 from 169.254.1.1:27015",
+			"<-- [mat] Split packet    2/   2 seq   123 size  512 mtu 1200 from ::ffff:a9fe:101:27015",
+			"<-- [cl] Split packet    1/   3 seq 11463 size 1200 mtu 1200 from 169.254.1.1:27015",
+			"<-- [cl ] Split packet    1/   3 seq 11463 size 1200 mtu 1200 from loopback",
+		});
+
+	CheckParity<NetStatusConfig, 3>(R"regex(- Config: (.*), (.*), (\d+) connections)regex",
+		{
+			"- Config: Multiplayer, listen, 1 connections",
+			"- Config: Multiplayer, dedicated, 0 connections",
+			"- Config: Multiplayer, a, b, 2 connections",
+			"- Config: Multiplayer, listen, one connections",
+		});
+
+	CheckParity<NetChannelLatencyLoss, 2>(R"regex(- latency: (\d+\.\d+), loss (\d+\.\d+))regex",
+		{
+			"- latency: 0.0, loss 0.00",
+			"- latency: 57.1, loss 0.02",
+			"- latency: 57, loss 0.02",
+		});
+
+	CheckParity<NetChannelPackets, 2>(R"regex(- packets: in (\d+\.\d+)\/s, out (\d+\.\d+)\/s)regex",
+		{
+			"- packets: in 66.7/s, out 66.7/s",
+			"- packets: in 66.7/s, out 66.7",
+		});
+
+	CheckParity<NetChannelChoke, 2>(R"regex(- choke: in (\d+\.\d+), out (\d+\.\d+))regex",
+		{
+			"- choke: in 0.00, out 0.00",
+			"- choke: in 0.00, out .00",
+		});
+
+	CheckParity<NetChannelFlow, 2>(R"regex(- flow: in (\d+\.\d+), out (\d+\.\d+) kB\/s)regex",
+		{
+			"- flow: in 14.3, out 1.8 kB/s",
+			"- flow: in 14.3, out 1.8 KB/s",
+		});
+
+	CheckParity<NetChannelTotal, 2>(R"regex(- total: in (\d+\.\d+), out (\d+\.\d+) MB)regex",
+		{
+			"- total: in 12.34, out 1.23 MB",
+			"- total: in 12.34, out 1.23 kB",
+		});
+
+	CheckParity<NetLatency, 2>(R"regex(- Latency: avg out (\d+\.\d+)s, in (\d+\.\d+)s)regex",
+		{
+			"- Latency: avg out 0.03s, in 0.02s",
+			"- Latency: avg out 0.03s, in 0.02",
+		});
+
+	CheckParity<NetLoss, 2>(R"regex(- Loss:    avg out (\d+\.\d+), in (\d+\.\d+))regex",
+		{
+			"- Loss:    avg out 0.0, in 0.0",
+			"- Loss: avg out 0.0, in 0.0",
+		});
+
+	CheckParity<NetPacketsTotal, 2>(R"regex(- Packets: net total out  (\d+\.\d)\/s, in (\d+\.\d)\/s)regex",
+		{
+			"- Packets: net total out  66.7/s, in 66.7/s",
+			"- Packets: net total out  66.67/s, in 66.7/s",
+		});
+
+	CheckParity<NetPacketsPerClient, 2>(R"regex(           per client out (\d+\.\d)\/s, in (\d+\.\d)\/s)regex",
+		{
+			"           per client out 66.7/s, in 66.7/s",
+			"           per client out 1.4, in 14.3 kB/s",
+		});
+
+	CheckParity<NetDataTotal, 2>(R"regex(- Data:    net total out  (\d+\.\d), in (\d+\.\d) kB\/s)regex",
+		{
+			"- Data:    net total out  1.4, in 14.3 kB/s",
+			"- Data:    net total out  1.4, in 14 kB/s",
+		});
+
+	CheckParity<NetDataPerClient, 2>(R"regex(           per client out (\d+\.\d), in (\d+\.\d) kB\/s)regex",
+		{
+			"           per client out 1.4, in 14.3 kB/s",
+			"           per client out 66.7/s, in 66.7/s",
+		});
+}
+
+TEST_CASE("tf2bd_conline_pattern_benchmark", "[ConsoleLog][.benchmark]")
+{
+	constexpr auto KILL_LINE = "Dr. Evil killed Mr. Bigglesworth with tf_projectile_rocket. (crit)"sv;
+	constexpr auto STATUS_LINE = R"(#    348 "Pootis" [U:1:1118537734] 1:00:51  157    0 active 169.254.1.1:27005)"sv;
+
+	const std::regex killRegex(R"regex((.*) killed (.*) with (.*)\.( \(crit\))?)regex", std::regex::optimize);
+	const std::regex statusRegex(R"regex(#\s+(\d+)\s+"((?:.|[\r\n])+)"\s+(\[.*\])\s+(?:(\d+):)?(\d+):(\d+)\s+(\d+)\s+(\d+)\s+(\w+)(?:\s+(\S+))?)regex", std::regex::optimize);
+
+	BENCHMARK("std::regex kill")
+	{
+		std::match_results<const char*> result;
+		return std::regex_match(KILL_LINE.data(), KILL_LINE.data() + KILL_LINE.size(), result, killRegex);
+	};
+	BENCHMARK("StaticRegex kill")
+	{
+		StaticRegex::Groups<4> result;
+		return StaticRegex::FullMatch<ConsoleLinePatterns::KillNotification>(KILL_LINE, result);
+	};
+
+	BENCHMARK("std::regex status")
+	{
+		std::match_results<const char*> result;
+		return std::regex_match(STATUS_LINE.data(), STATUS_LINE.data() + STATUS_LINE.size(), result, statusRegex);
+	};
+	BENCHMARK("StaticRegex status")
+	{
+		StaticRegex::Groups<10> result;
+		return StaticRegex::FullMatch<ConsoleLinePatterns::ServerStatusPlayer>(STATUS_LINE, result);
+	};
+}
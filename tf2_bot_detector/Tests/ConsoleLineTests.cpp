@@ -1,116 +1,16 @@
 #include "ConsoleLog/ConsoleLines.h"
+#include "Tests/DummyWorldState.h"
 #include "SteamID.h"
 #include "WorldState.h"
 
 #include <catch2/catch.hpp>
-#include <mh/error/not_implemented_error.hpp>
 
 using namespace std::chrono_literals;
 using namespace tf2_bot_detector;
 
 namespace
 {
-	class DummyWorldState : public IWorldState
-	{
-		// Inherited via IWorldState
-		virtual IConsoleLineListener& GetConsoleLineListenerBroadcaster() override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void UpdateTimestamp(const ConsoleLogParser& parser) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void Update() override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual time_point_t GetCurrentTime() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual time_point_t GetLastStatusUpdateTime() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void AddWorldEventListener(IWorldEventListener* listener) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void RemoveWorldEventListener(IWorldEventListener* listener) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void AddConsoleLineListener(IConsoleLineListener* listener) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void RemoveConsoleLineListener(IConsoleLineListener* listener) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void AddConsoleOutputChunk(const std::string_view& chunk) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual mh::task<> AddConsoleOutputLine(std::string line) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual std::optional<SteamID> FindSteamIDForName(const std::string_view& playerName) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual std::optional<LobbyMemberTeam> FindLobbyMemberTeam(const SteamID& id) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual std::optional<UserID_t> FindUserID(const SteamID& id) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual TeamShareResult GetTeamShareResult(const SteamID& id) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual TeamShareResult GetTeamShareResult(const SteamID& id0, const SteamID& id1) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual TeamShareResult GetTeamShareResult(const std::optional<LobbyMemberTeam>& team0, const SteamID& id1) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual const IPlayer* FindPlayer(const SteamID& id) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual size_t GetApproxLobbyMemberCount() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual mh::generator<const IPlayer&> GetLobbyMembers() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual mh::generator<const IPlayer&> GetPlayers() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual bool IsLocalPlayerInitialized() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual bool IsVoteInProgress() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual const IAccountAges& GetAccountAges() const override
-		{
-			throw mh::not_implemented_error();
-		}
-
-	} static s_DummyWorldState;
+	DummyWorldState s_DummyWorldState;
 }
 
 TEST_CASE("tf2bd_cl_status", "[ConsoleLines]")
@@ -172,3 +72,129 @@ TEST_CASE("tf2bd_cl_status", "[ConsoleLines]")
 		REQUIRE(playerStatus.m_State == test.m_ExpectedState);
 	}
 }
+
+TEST_CASE("tf2bd_cl_dispatch", "[ConsoleLines]")
+{
+	struct DispatchTest
+	{
+		std::string_view m_Line;
+		std::optional<ConsoleLineType> m_ExpectedType;
+	};
+
+	const DispatchTest DISPATCH_TESTS[] =
+	{
+		{ "Voice - chan 1, ent 7, bufsize: 128", ConsoleLineType::VoiceReceive },
+		{ "CTFLobbyShared: ID:00021ad2a8b0b1d  24 member(s), 0 pending", ConsoleLineType::LobbyHeader },
+		{ "  Member[0] [U:1:1118537734]  team = TF_GC_TEAM_DEFENDERS  type = MATCH_PLAYER", ConsoleLineType::LobbyMember },
+		{ "  Pending[0] [U:1:1118537734]  team = TF_GC_TEAM_INVADERS  type = MATCH_PLAYER", ConsoleLineType::LobbyMember },
+		{ "Lobby updated", ConsoleLineType::LobbyChanged },
+		{ "players : 24 humans, 0 bots (32 max)", ConsoleLineType::PlayerStatusCount },
+		{ "#    348 \"Pootis\" [U:1:1118537734] 00:51  157    0 active", ConsoleLineType::PlayerStatus },
+		{ "#2 - Pootis", ConsoleLineType::PlayerStatusShort },
+		{ "Dropped Pootis from server (Disconnect by user.)", ConsoleLineType::ServerDroppedPlayer },
+		{ "execing autoexec.cfg", ConsoleLineType::ConfigExec },
+		{ "'autoexec.cfg' not present; not executing.", ConsoleLineType::ConfigExec },
+		{ "- latency: 12.5, loss 0.00", ConsoleLineType::NetChannelLatencyLoss },
+		{ "           per client out 66.0/s, in 66.0/s", ConsoleLineType::NetPacketsPerClient },
+		{ "           per client out 12.3, in 4.5 kB/s", ConsoleLineType::NetDataPerClient },
+
+		{ "", std::nullopt },
+		{ "Lobby", std::nullopt },
+		{ "Voice - chan", std::nullopt },
+		{ "#", std::nullopt },
+		{ "Some random line that nothing should even try to parse", std::nullopt },
+	};
+
+	for (const auto& test : DISPATCH_TESTS)
+	{
+		INFO("Line: " << std::string(test.m_Line));
+
+		auto parsed = IConsoleLine::ParseConsoleLine(test.m_Line, tfbd_clock_t::now(), s_DummyWorldState);
+		if (test.m_ExpectedType)
+		{
+			REQUIRE(parsed);
+			REQUIRE(parsed->GetType() == *test.m_ExpectedType);
+		}
+		else
+		{
+			REQUIRE(!parsed);
+		}
+	}
+}
+
+TEST_CASE("tf2bd_cl_text_slab", "[ConsoleLines]")
+{
+	const ConsoleTextSlab slab = std::make_shared<std::string>("Dropped Pootis from server (Disconnect by user.)");
+
+	SECTION("Lines point into the slab")
+	{
+		auto parsed = IConsoleLine::ParseConsoleLine(*slab, tfbd_clock_t::now(), s_DummyWorldState, &slab);
+		REQUIRE(parsed);
+		REQUIRE(parsed->GetType() == ConsoleLineType::ServerDroppedPlayer);
+
+		auto& dropLine = static_cast<const ServerDroppedPlayerLine&>(*parsed);
+		REQUIRE(dropLine.GetPlayerName() == "Pootis");
+		REQUIRE(dropLine.GetReason() == "Disconnect by user.");
+		REQUIRE(dropLine.GetPlayerName().data() == slab->data() + 8);
+		REQUIRE(slab.use_count() > 1);
+
+		parsed.reset();
+		REQUIRE(slab.use_count() == 1);
+	}
+
+	SECTION("Text outside the slab is copied")
+	{
+		const std::string text = *slab;
+		auto parsed = IConsoleLine::ParseConsoleLine(text, tfbd_clock_t::now(), s_DummyWorldState, &slab);
+		REQUIRE(parsed);
+
+		auto& dropLine = static_cast<const ServerDroppedPlayerLine&>(*parsed);
+		REQUIRE(dropLine.GetPlayerName() == "Pootis");
+		REQUIRE(dropLine.GetPlayerName().data() != text.data() + 8);
+		REQUIRE(slab.use_count() == 1);
+	}
+
+	SECTION("Retained text doesn't pin slabs much bigger than itself")
+	{
+		// The size of a normal read
+		const ConsoleTextSlab readSlab = std::make_shared<std::string>(64 * 1024, 'x');
+		const std::string_view text = std::string_view(*readSlab).substr(0, 100);
+
+		const ConsoleLineText shared(text, &readSlab);
+		REQUIRE(shared.data() == readSlab->data());
+
+		const ConsoleLineText retained(text, &readSlab, true);
+		REQUIRE(retained == text);
+		REQUIRE(retained.data() != readSlab->data());
+		REQUIRE(readSlab.use_count() == 2);
+
+		// Most of the slab anyway
+		const std::string_view bigText = std::string_view(*slab).substr(8);
+		const ConsoleLineText retainedBig(bigText, &slab, true);
+		REQUIRE(retainedBig.data() == slab->data() + 8);
+	}
+
+	SECTION("Copies")
+	{
+		// Past any small string buffer
+		const std::string text(1000, 'y');
+		const ConsoleLineText copy(text);
+		REQUIRE(copy == text);
+		REQUIRE(copy.data() != text.data());
+
+		REQUIRE(ConsoleLineText(std::string_view()).empty());
+	}
+}
+
+TEST_CASE("tf2bd_cl_listener_interest", "[ConsoleLines]")
+{
+	const ConsoleLineTypeMask mask{ ConsoleLineType::Chat, ConsoleLineType::NetChannelTotal };
+	REQUIRE(mask.Contains(ConsoleLineType::Chat));
+	REQUIRE(mask.Contains(ConsoleLineType::NetChannelTotal));
+	REQUIRE(!mask.Contains(ConsoleLineType::VoiceReceive));
+	REQUIRE(!mask.Contains(ConsoleLineType::Generic));
+
+	REQUIRE(!ConsoleLineTypeMask::None().Contains(ConsoleLineType::Generic));
+	for (size_t i = 0; i < CONSOLE_LINE_TYPE_COUNT; i++)
+		REQUIRE(ConsoleLineTypeMask::All().Contains(ConsoleLineType(i)));
+}
@@ -0,0 +1,108 @@
+#include "ConsoleLog/ConsoleLogBulkParser.h"
+#include "ConsoleLog/IConsoleLine.h"
+#include "Tests/DummyWorldState.h"
+
+#include <catch2/catch.hpp>
+#include <mh/text/format.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	DummyWorldState s_DummyWorldState;
+
+	constexpr std::string_view LINES[] =
+	{
+		"Lobby updated",
+		"CTFLobbyShared: ID:00021ad2a8b0b1d  24 member(s), 0 pending",
+		"  Member[0] [U:1:1118537734]  team = TF_GC_TEAM_DEFENDERS  type = MATCH_PLAYER",
+		"#    348 \"Pootis\" [U:1:1118537734] 00:51  157    0 active",
+		"Pootis killed Engineer with scattergun. (crit)",
+		"Voice - chan 1, ent 7, bufsize: 128",
+		"Some random line that nothing should even try to parse",
+		"- latency: 12.5, loss 0.00",
+	};
+
+	std::string GenerateConsoleLog(size_t lineCount, std::vector<std::string_view>& expectedLines)
+	{
+		std::string log = "preamble without a timestamp";
+
+		for (size_t i = 0; i < lineCount; i++)
+		{
+			const auto line = LINES[i % std::size(LINES)];
+			mh::format_to_container(log, "\n01/02/2021 - {:02}:{:02}:{:02}: {}", (i / 3600) % 24, (i / 60) % 60, i % 60, line);
+			expectedLines.push_back(line);
+		}
+
+		log += '\n';
+		return log;
+	}
+}
+
+TEST_CASE("tf2bd_conlog_bulk_parse", "[ConsoleLog]")
+{
+	std::vector<std::string_view> expectedLines;
+	const auto log = GenerateConsoleLog(40'000, expectedLines);
+
+	for (unsigned threadCount : { 1, 2, 4, 7 })
+	{
+		INFO("Threads: " << threadCount);
+
+		ConsoleLogBulkParseStats stats;
+		auto lines = ParseConsoleLogParallel(log, s_DummyWorldState, threadCount, &stats);
+
+		REQUIRE(lines.size() == expectedLines.size());
+		REQUIRE(stats.m_LineCount == expectedLines.size());
+		REQUIRE(stats.m_SegmentCount >= threadCount);
+
+		size_t parsedCount = 0;
+		size_t deferredCount = 0;
+		for (size_t i = 0; i < lines.size(); i++)
+		{
+			const auto& line = lines[i];
+			REQUIRE(line.m_Text == expectedLines[i]);
+
+			if (i > 0)
+				REQUIRE(line.m_Timestamp >= lines[i - 1].m_Timestamp);
+
+			// Kill notifications look up player names in the world state
+			const bool isKill = line.m_Text.find(" killed ") != line.m_Text.npos;
+			REQUIRE(line.m_NeedsWorldState == isKill);
+			if (isKill)
+			{
+				REQUIRE(!line.m_Parsed);
+				deferredCount++;
+				continue;
+			}
+
+			// Everything else has to match what the regular path would have done
+			auto expected = IConsoleLine::ParseConsoleLine(line.m_Text, line.m_Timestamp, s_DummyWorldState);
+			REQUIRE(!expected == !line.m_Parsed);
+			if (expected)
+			{
+				REQUIRE(expected->GetType() == line.m_Parsed->GetType());
+				parsedCount++;
+			}
+		}
+
+		REQUIRE(stats.m_ParsedLineCount == parsedCount);
+		REQUIRE(stats.m_DeferredLineCount == deferredCount);
+	}
+}
+
+TEST_CASE("tf2bd_conlog_bulk_parse_benchmark", "[ConsoleLog][.benchmark]")
+{
+	std::vector<std::string_view> expectedLines;
+	const auto log = GenerateConsoleLog(500'000, expectedLines);
+
+	for (unsigned threadCount : { 1, 2, 4, 8 })
+	{
+		BENCHMARK(mh::format("ParseConsoleLogParallel, {} threads", threadCount))
+		{
+			return ParseConsoleLogParallel(log, s_DummyWorldState, threadCount).size();
+		};
+	}
+}
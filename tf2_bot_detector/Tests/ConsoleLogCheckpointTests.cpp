@@ -0,0 +1,187 @@
+#include "ConsoleLog/ConsoleLogCheckpoint.h"
+#include "ConsoleLog/ConsoleLogTimestamps.h"
+
+#include <catch2/catch.hpp>
+#include <mh/text/format.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	struct TestLog
+	{
+		std::string m_Text;
+		std::vector<uint64_t> m_LineBegins;   // Offset of the leading '\n' of each line's timestamp (0 for the first one)
+	};
+
+	// Four lines a second, for minutes
+	TestLog MakeTestLog(int minutes)
+	{
+		TestLog log;
+		for (int second = 0; second < minutes * 60; second++)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				log.m_LineBegins.push_back(log.m_Text.empty() ? 0 : log.m_Text.size() - 1);
+				log.m_Text += mh::format("10/17/2026 - 12:{:02}:{:02}: Line {} of second {}, with some padding\n",
+					second / 60, second % 60, i, second);
+			}
+		}
+
+		return log;
+	}
+
+	struct FileDeleter
+	{
+		void operator()(FILE* file) const { std::fclose(file); }
+	};
+	using FilePtr = std::unique_ptr<FILE, FileDeleter>;
+
+	FilePtr MakeFile(const std::string_view& text)
+	{
+		FilePtr file(std::tmpfile());
+		REQUIRE(file);
+		REQUIRE(std::fwrite(text.data(), sizeof(char), text.size(), file.get()) == text.size());
+		std::fflush(file.get());
+		return file;
+	}
+
+	time_point_t GetTimestampAt(const std::string_view& text, uint64_t offset)
+	{
+		const auto timestamp = FindConsoleLogTimestamp(text, offset);
+		REQUIRE(timestamp);
+		REQUIRE(timestamp->m_Begin == offset);
+		return timestamp->ToTimePoint();
+	}
+}
+
+TEST_CASE("tf2bd_conlog_checkpoint_window", "[ConsoleLog]")
+{
+	const TestLog log = MakeTestLog(20);
+	const FilePtr file = MakeFile(log.m_Text);
+	const uint64_t fileSize = log.m_Text.size();
+	REQUIRE(fileSize > 4 * 64 * 1024);   // Spans a few scan blocks
+
+	const time_point_t lastTime = GetTimestampAt(log.m_Text, log.m_LineBegins.back());
+
+	SECTION("Starts at the first line within the window")
+	{
+		const auto offset = FindConsoleLogWindowStart(file.get(), fileSize, 5min, UINT64_MAX);
+		REQUIRE(GetTimestampAt(log.m_Text, offset) == lastTime - 5min);
+
+		// ...and not a line later
+		const auto prevLine = std::find(log.m_LineBegins.begin(), log.m_LineBegins.end(), offset) - 1;
+		REQUIRE(GetTimestampAt(log.m_Text, *prevLine) < lastTime - 5min);
+	}
+	SECTION("Whole file within the window")
+	{
+		REQUIRE(FindConsoleLogWindowStart(file.get(), fileSize, 30min, UINT64_MAX) == 0);
+	}
+	SECTION("Gives up after maxScanBytes")
+	{
+		const auto offset = FindConsoleLogWindowStart(file.get(), fileSize, 15min, 100 * 1024);
+		REQUIRE(offset >= fileSize - 100 * 1024 - 64 * 1024);
+		REQUIRE(GetTimestampAt(log.m_Text, offset) >= lastTime - 15min);
+	}
+	SECTION("No timestamps")
+	{
+		const std::string garbage(200 * 1024, 'x');
+		const FilePtr garbageFile = MakeFile(garbage);
+		REQUIRE(FindConsoleLogWindowStart(garbageFile.get(), garbage.size(), 5min, UINT64_MAX) == 0);
+	}
+}
+
+TEST_CASE("tf2bd_conlog_checkpoint_validation", "[ConsoleLog]")
+{
+	const TestLog log = MakeTestLog(2);
+	const FilePtr file = MakeFile(log.m_Text);
+	const uint64_t fileSize = log.m_Text.size();
+
+	ConsoleLogCheckpoint checkpoint;
+	checkpoint.m_Head = ReadConsoleLogHead(file.get()).value();
+	checkpoint.m_Offset = log.m_LineBegins[100];
+	checkpoint.m_Timestamp = GetTimestampAt(log.m_Text, checkpoint.m_Offset);
+
+	REQUIRE(checkpoint.m_Head.m_Size == ConsoleLogFileHead::MAX_SIZE);
+	REQUIRE(IsConsoleLogCheckpointValid(file.get(), fileSize, checkpoint));
+
+	SECTION("Survives a round trip through json")
+	{
+		const nlohmann::json json = checkpoint;
+		const auto loaded = json.get<ConsoleLogCheckpoint>();
+		REQUIRE(loaded.m_Head == checkpoint.m_Head);
+		REQUIRE(loaded.m_Offset == checkpoint.m_Offset);
+		REQUIRE(IsConsoleLogCheckpointValid(file.get(), fileSize, loaded));
+	}
+	SECTION("Different file")
+	{
+		std::string otherText = log.m_Text;
+		otherText[1] = '1';   // Launched a month later
+		const FilePtr otherFile = MakeFile(otherText);
+		REQUIRE(!IsConsoleLogCheckpointValid(otherFile.get(), otherText.size(), checkpoint));
+	}
+	SECTION("Not at a line")
+	{
+		checkpoint.m_Offset += 5;
+		REQUIRE(!IsConsoleLogCheckpointValid(file.get(), fileSize, checkpoint));
+	}
+	SECTION("Different line")
+	{
+		checkpoint.m_Timestamp += 1s;
+		REQUIRE(!IsConsoleLogCheckpointValid(file.get(), fileSize, checkpoint));
+	}
+	SECTION("Past the end of the file")
+	{
+		REQUIRE(!IsConsoleLogCheckpointValid(file.get(), checkpoint.m_Offset, checkpoint));
+	}
+	SECTION("File was still short when the checkpoint was taken")
+	{
+		checkpoint.m_Head = ReadConsoleLogHead(file.get(), 100).value();
+		REQUIRE(checkpoint.m_Head.m_Size == 100);
+		REQUIRE(IsConsoleLogCheckpointValid(file.get(), fileSize, checkpoint));
+	}
+}
+
+TEST_CASE("tf2bd_conlog_checkpoint_large_offsets", "[ConsoleLog]")
+{
+	const TestLog log = MakeTestLog(1);
+	const FilePtr file = MakeFile(log.m_Text);
+
+	// Past what a 32 bit long can hold. Seeking past the end is fine, we don't have to
+	// actually write gigabytes to get there.
+	const uint64_t largeOffset = uint64_t(INT32_MAX) + 12345;
+
+	REQUIRE(SeekFile(file.get(), largeOffset));
+	REQUIRE(TellFile(file.get()) == largeOffset);
+
+	REQUIRE(SeekFile(file.get(), 10));
+	REQUIRE(TellFile(file.get()) == 10u);
+
+	// Nothing is there, so it can't be valid, but it has to look there to find out
+	ConsoleLogCheckpoint checkpoint;
+	checkpoint.m_Head = ReadConsoleLogHead(file.get()).value();
+	checkpoint.m_Offset = largeOffset;
+	checkpoint.m_Timestamp = GetTimestampAt(log.m_Text, log.m_LineBegins[4]);
+	REQUIRE(!IsConsoleLogCheckpointValid(file.get(), largeOffset + 1024, checkpoint));
+}
+
+TEST_CASE("tf2bd_conlog_open_file_size", "[ConsoleLog]")
+{
+	const std::string text = "10/17/2026 - 12:00:00: Hello\n";
+	const FilePtr file = MakeFile(text);
+	REQUIRE(GetOpenFileSize(file.get()) == text.size());
+
+	// Seen through the handle we already have open, wherever its position is
+	REQUIRE(std::fwrite(text.data(), sizeof(char), text.size(), file.get()) == text.size());
+	std::fflush(file.get());
+	REQUIRE(SeekFile(file.get(), 0));
+	REQUIRE(GetOpenFileSize(file.get()) == text.size() * 2);
+}
@@ -0,0 +1,125 @@
+#include "ConsoleLog/ConsoleLogCheckpoint.h"
+#include "ConsoleLog/ConsoleLogPoller.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+using WakeReason = ConsoleLogPoller::WakeReason;
+
+TEST_CASE("tf2bd_conlog_poller", "[ConsoleLog]")
+{
+	ConsoleLogPoller poller;
+	const time_point_t start = tfbd_clock_t::now();
+
+	// The first size we see is always news
+	REQUIRE(poller.Poll(start, 100, false) == WakeReason::SizeChanged);
+	REQUIRE(poller.Poll(start + 10ms, 100, false) == WakeReason::None);
+
+	SECTION("Growing")
+	{
+		REQUIRE(poller.Poll(start + 20ms, 150, false) == WakeReason::SizeChanged);
+		REQUIRE(poller.Poll(start + 30ms, 150, false) == WakeReason::None);
+	}
+
+	SECTION("Truncated")
+	{
+		REQUIRE(poller.Poll(start + 20ms, 0, false) == WakeReason::SizeChanged);
+		REQUIRE(poller.Poll(start + 30ms, 0, false) == WakeReason::None);
+	}
+
+	SECTION("Read pending")
+	{
+		REQUIRE(poller.Poll(start + 20ms, 100, true) == WakeReason::ReadPending);
+		REQUIRE(poller.Poll(start + 30ms, 100, true) == WakeReason::ReadPending);
+		REQUIRE(poller.Poll(start + 40ms, 100, false) == WakeReason::None);
+
+		// A size change is the better reason
+		REQUIRE(poller.Poll(start + 50ms, 200, true) == WakeReason::SizeChanged);
+	}
+
+	SECTION("Periodic")
+	{
+		const auto interval = ConsoleLogPoller::PERIODIC_READ_INTERVAL;
+		REQUIRE(poller.Poll(start + interval - 1ms, 100, false) == WakeReason::None);
+		REQUIRE(poller.Poll(start + interval, 100, false) == WakeReason::Periodic);
+		REQUIRE(poller.Poll(start + interval + 10ms, 100, false) == WakeReason::None);
+
+		// Any wakeup restarts the interval
+		REQUIRE(poller.Poll(start + interval + 500ms, 200, false) == WakeReason::SizeChanged);
+		REQUIRE(poller.Poll(start + interval * 2 + 10ms, 200, false) == WakeReason::None);
+		REQUIRE(poller.Poll(start + interval * 2 + 500ms, 200, false) == WakeReason::Periodic);
+	}
+
+	SECTION("Unknown size")
+	{
+		// Doesn't count as a change, and doesn't make us forget the last size we did see
+		REQUIRE(poller.Poll(start + 20ms, std::nullopt, false) == WakeReason::None);
+		REQUIRE(poller.Poll(start + 30ms, std::nullopt, true) == WakeReason::ReadPending);
+		REQUIRE(poller.Poll(start + 40ms, 100, false) == WakeReason::None);
+		REQUIRE(poller.Poll(start + ConsoleLogPoller::PERIODIC_READ_INTERVAL + 30ms, std::nullopt, false) == WakeReason::Periodic);
+	}
+
+	SECTION("Reset")
+	{
+		poller.Reset();
+		REQUIRE(poller.Poll(start + 20ms, 100, false) == WakeReason::SizeChanged);
+	}
+}
+
+TEST_CASE("tf2bd_conlog_poller_file", "[ConsoleLog]")
+{
+	struct FileCloser
+	{
+		void operator()(FILE* file) const { std::fclose(file); }
+	};
+	using FilePtr = std::unique_ptr<FILE, FileCloser>;
+
+	const auto path = std::filesystem::temp_directory_path() / "tf2bd_conlog_poller_test.log";
+	std::filesystem::remove(path);
+
+	// Written through one handle (tf2's), watched through another (ours)
+	const FilePtr writer(std::fopen(path.string().c_str(), "wb"));
+	REQUIRE(writer);
+	const FilePtr reader(std::fopen(path.string().c_str(), "rb"));
+	REQUIRE(reader);
+
+	const auto write = [&](const std::string_view& text)
+	{
+		REQUIRE(std::fwrite(text.data(), sizeof(char), text.size(), writer.get()) == text.size());
+		std::fflush(writer.get());
+	};
+
+	ConsoleLogPoller poller;
+	time_point_t now = tfbd_clock_t::now();
+	const auto poll = [&] { return poller.Poll(now += 10ms, GetOpenFileSize(reader.get()), false); };
+
+	REQUIRE(poll() == WakeReason::SizeChanged);
+	REQUIRE(poll() == WakeReason::None);
+
+	write("10/17/2026 - 12:00:00: Hello\n");
+	REQUIRE(poll() == WakeReason::SizeChanged);
+	REQUIRE(poll() == WakeReason::None);
+
+	// Our position doesn't matter, only what has been written
+	char buf[64];
+	REQUIRE(std::fread(buf, sizeof(char), sizeof(buf), reader.get()) > 0);
+	REQUIRE(poll() == WakeReason::None);
+
+	write("10/17/2026 - 12:00:01: World\n");
+	REQUIRE(poll() == WakeReason::SizeChanged);
+
+	// Truncated by someone else
+	{
+		const FilePtr truncate(std::fopen(path.string().c_str(), "wb"));
+		REQUIRE(truncate);
+	}
+	REQUIRE(poll() == WakeReason::SizeChanged);
+	REQUIRE(GetOpenFileSize(reader.get()) == 0u);
+}
@@ -0,0 +1,149 @@
+#include "Config/ChatWrappers.h"
+#include "ConsoleLog/ConsoleLogReplay.h"
+#include "IPlayer.h"
+#include "WorldEventListener.h"
+#include "WorldState.h"
+
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	ChatWrappers MakeTestWrappers()
+	{
+		ChatWrappers wrappers;
+		for (size_t i = 0; i < size_t(ChatCategory::COUNT); i++)
+		{
+			auto& type = wrappers.m_Types[i];
+			type.m_Full.m_Start.m_Narrow = "[full" + std::to_string(i) + "]";
+			type.m_Full.m_End.m_Narrow = "[/full" + std::to_string(i) + "]";
+			type.m_Name.m_Start.m_Narrow = "[name" + std::to_string(i) + "]";
+			type.m_Name.m_End.m_Narrow = "[/name" + std::to_string(i) + "]";
+			type.m_Message.m_Start.m_Narrow = "[msg" + std::to_string(i) + "]";
+			type.m_Message.m_End.m_Narrow = "[/msg" + std::to_string(i) + "]";
+		}
+
+		return wrappers;
+	}
+
+	class ChatRecorder final : public AutoWorldEventListener
+	{
+	public:
+		using AutoWorldEventListener::AutoWorldEventListener;
+
+		void OnChatMsg(IWorldState& world, IPlayer& player, const std::string_view& msg) override
+		{
+			m_Messages.push_back({ player.GetSteamID(), std::string(msg) });
+		}
+
+		struct Message
+		{
+			SteamID m_SteamID;
+			std::string m_Text;
+		};
+		std::vector<Message> m_Messages;
+	};
+}
+
+TEST_CASE("tf2bd_conlog_replay", "[ConsoleLog]")
+{
+	const auto wrappersPath = std::filesystem::temp_directory_path() / "tf2bd_conlog_replay_test_wrappers.json";
+	{
+		const nlohmann::json json = { { "wrappers", MakeTestWrappers() } };
+		std::ofstream file(wrappersPath, std::ios::trunc | std::ios::binary);
+		file << json;
+	}
+
+	const SteamID pootis("[U:1:1001]"sv);
+	const SteamID engineer("[U:1:1002]"sv);
+	const SteamID joining("[U:1:1003]"sv);
+
+	// The last line is only there so the chat message before it counts as complete
+	const std::string log =
+		"10/17/2026 - 12:00:00: CTFLobbyShared: ID:00021ad2a8b0b1d  2 member(s), 1 pending\n"
+		"10/17/2026 - 12:00:00:   Member[0] [U:1:1001]  team = TF_GC_TEAM_DEFENDERS  type = MATCH_PLAYER\n"
+		"10/17/2026 - 12:00:00:   Member[1] [U:1:1002]  team = TF_GC_TEAM_INVADERS  type = MATCH_PLAYER\n"
+		"10/17/2026 - 12:00:00:   Pending[0] [U:1:1003]  team = TF_GC_TEAM_INVADERS  type = MATCH_PLAYER\n"
+		"10/17/2026 - 12:00:01: #      2 \"Pootis\" [U:1:1001] 00:51  57    0 active\n"
+		"10/17/2026 - 12:00:01: #      3 \"Engineer\" [U:1:1002] 12:34  80    0 active\n"
+		"10/17/2026 - 12:00:02: [full0][name0]Pootis[/name0] :  [msg0]pootis spenser here[/msg0][/full0]\n"
+		"10/17/2026 - 12:00:03: Some random line that nothing should even try to parse\n";
+
+	ConsoleLogReplaySettings replaySettings;
+	replaySettings.m_FileName = "tf2bd_conlog_replay_test.log";
+	replaySettings.m_ChatWrappersFileName = wrappersPath;
+
+	const auto replay = IConsoleLogReplay::Create(replaySettings);
+	IWorldState& world = replay->GetWorld();
+	ChatRecorder chat(world);
+
+	std::istringstream stream(log);
+	replay->Run(stream);
+
+	SECTION("Players")
+	{
+		const IPlayer* foundPootis = nullptr;
+		const IPlayer* foundEngineer = nullptr;
+		for (const IPlayer& player : world.GetPlayers())
+		{
+			if (player.GetSteamID() == pootis)
+				foundPootis = &player;
+			else if (player.GetSteamID() == engineer)
+				foundEngineer = &player;
+		}
+
+		REQUIRE(foundPootis);
+		CHECK(foundPootis->GetNameUnsafe() == "Pootis");
+		CHECK(foundPootis->GetUserID() == UserID_t(2));
+
+		REQUIRE(foundEngineer);
+		CHECK(foundEngineer->GetNameUnsafe() == "Engineer");
+		CHECK(foundEngineer->GetUserID() == UserID_t(3));
+	}
+
+	SECTION("Lobby")
+	{
+		CHECK(world.GetApproxLobbyMemberCount() == 3);
+
+		std::vector<SteamID> members;
+		for (const IPlayer& player : world.GetLobbyMembers())
+		{
+			const LobbyMember* member = player.GetLobbyMember();
+			REQUIRE(member);
+			members.push_back(player.GetSteamID());
+
+			if (player.GetSteamID() == pootis)
+			{
+				CHECK(member->m_Team == LobbyMemberTeam::Defenders);
+				CHECK(!member->m_Pending);
+			}
+			else if (player.GetSteamID() == joining)
+			{
+				CHECK(member->m_Team == LobbyMemberTeam::Invaders);
+				CHECK(member->m_Pending);
+			}
+		}
+
+		CHECK(members == std::vector<SteamID>{ pootis, engineer, joining });
+		CHECK(world.GetTeamShareResult(pootis, engineer) == TeamShareResult::OppositeTeams);
+	}
+
+	SECTION("Chat")
+	{
+		REQUIRE(chat.m_Messages.size() == 1);
+		CHECK(chat.m_Messages[0].m_SteamID == pootis);
+		CHECK(chat.m_Messages[0].m_Text == "pootis spenser here");
+	}
+
+	std::filesystem::remove(wrappersPath);
+}
@@ -0,0 +1,385 @@
+#include "ConsoleLog/ConsoleLogTimestamps.h"
+
+#include <catch2/catch.hpp>
+#include <mh/text/format.hpp>
+
+#include <cstdlib>
+#include <ctime>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	// What ConsoleLogParser used to use to find line boundaries
+	const std::regex& GetTimestampRegex()
+	{
+		static const std::regex s_TimestampRegex(R"regex(\n(\d\d)\/(\d\d)\/(\d\d\d\d) - (\d\d):(\d\d):(\d\d):[ \n])regex", std::regex::optimize);
+		return s_TimestampRegex;
+	}
+
+	struct BoundaryMatch
+	{
+		size_t m_Begin;
+		size_t m_End;
+		int m_Fields[6];
+
+		bool operator==(const BoundaryMatch&) const = default;
+	};
+
+	std::vector<BoundaryMatch> FindAllWithRegex(const std::string_view& buf)
+	{
+		std::vector<BoundaryMatch> retVal;
+
+		std::match_results<std::string_view::const_iterator> match;
+		auto begin = buf.begin();
+		while (std::regex_search(begin, buf.end(), match, GetTimestampRegex()))
+		{
+			BoundaryMatch& m = retVal.emplace_back();
+			m.m_Begin = match[0].first - buf.begin();
+			m.m_End = match[0].second - buf.begin();
+			for (int i = 0; i < 6; i++)
+				m.m_Fields[i] = std::stoi(match[i + 1].str());
+
+			begin = match[0].second;
+		}
+
+		return retVal;
+	}
+
+	std::vector<BoundaryMatch> FindAllWithScanner(const std::string_view& buf)
+	{
+		std::vector<BoundaryMatch> retVal;
+
+		size_t offset = 0;
+		while (auto ts = FindConsoleLogTimestamp(buf, offset))
+		{
+			retVal.push_back(BoundaryMatch{ ts->m_Begin, ts->m_End,
+				{ ts->m_Month, ts->m_Day, ts->m_Year, ts->m_Hour, ts->m_Minute, ts->m_Second } });
+
+			offset = ts->m_End;
+		}
+
+		return retVal;
+	}
+
+	std::string GenerateConsoleLog(size_t targetSize)
+	{
+		constexpr const char* LINES[] =
+		{
+			"#    348 \"Pootis\" [U:1:1118537734] 00:51  157    0 active",
+			"Dropped Pootis from server (Disconnect by user.)",
+			"Voice - chan 1, ent 7, bufsize: 128",
+			"players : 24 humans, 0 bots (32 max)",
+			"Sniper killed Heavy with sniperrifle. (crit)",
+			"ent_fire\n12/34/56 not a timestamp",
+			"",
+		};
+
+		std::string retVal;
+		retVal.reserve(targetSize + 256);
+
+		for (size_t i = 0; retVal.size() < targetSize; i++)
+		{
+			retVal += mh::format("\n{:02}/{:02}/2021 - {:02}:{:02}:{:02}: {}",
+				(i / 86400) % 12 + 1, (i / 3600) % 28 + 1, (i / 3600) % 24, (i / 60) % 60, i % 60,
+				LINES[i % std::size(LINES)]);
+		}
+
+		return retVal;
+	}
+
+	// Points the CRT at a different timezone for as long as it's alive
+	class ScopedTimezone final
+	{
+	public:
+		explicit ScopedTimezone(const char* tz)
+		{
+			if (const char* old = std::getenv("TZ"))
+				m_OldTZ = old;
+
+			Set(tz);
+		}
+		~ScopedTimezone()
+		{
+			Set(m_OldTZ ? m_OldTZ->c_str() : nullptr);
+		}
+
+	private:
+		std::optional<std::string> m_OldTZ;
+
+		static void Set(const char* tz)
+		{
+#ifdef _WIN32
+			_putenv_s("TZ", tz ? tz : "");
+			_tzset();
+#else
+			if (tz)
+				setenv("TZ", tz, 1);
+			else
+				unsetenv("TZ");
+
+			tzset();
+#endif
+		}
+	};
+
+	ConsoleLogTimestamp MakeTimestamp(const std::tm& time)
+	{
+		ConsoleLogTimestamp ts;
+		ts.m_Month = time.tm_mon + 1;
+		ts.m_Day = time.tm_mday;
+		ts.m_Year = time.tm_year + 1900;
+		ts.m_Hour = time.tm_hour;
+		ts.m_Minute = time.tm_min;
+		ts.m_Second = time.tm_sec;
+		return ts;
+	}
+
+	// Every local time from startYear to endYear (exclusive), step seconds apart, in order
+	std::vector<ConsoleLogTimestamp> GenerateTimestamps(int startYear, int endYear, int step)
+	{
+		std::vector<ConsoleLogTimestamp> retVal;
+
+		std::tm time{};
+		time.tm_year = startYear - 1900;
+		time.tm_mday = 1;
+
+		// Walk local time with integer arithmetic (timegm-style, no timezone involved), so we
+		// hit every wall clock time including the ones that are skipped or repeated by DST
+		for (int64_t second = 0; ; second += step)
+		{
+			std::tm local = time;
+			local.tm_sec = int(second % 60);
+			local.tm_min = int((second / 60) % 60);
+			local.tm_hour = int((second / 3600) % 24);
+			local.tm_mday = 1 + int(second / 86400);
+
+			// Normalize the date without mktime(), which would also adjust for DST
+			static constexpr int DAYS_IN_MONTH[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+			while (true)
+			{
+				const int year = local.tm_year + 1900;
+				const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+				const int days = DAYS_IN_MONTH[local.tm_mon] + ((local.tm_mon == 1 && leap) ? 1 : 0);
+				if (local.tm_mday <= days)
+					break;
+
+				local.tm_mday -= days;
+				if (++local.tm_mon == 12)
+				{
+					local.tm_mon = 0;
+					local.tm_year++;
+				}
+			}
+
+			if ((local.tm_year + 1900) >= endYear)
+				break;
+
+			retVal.push_back(MakeTimestamp(local));
+		}
+
+		return retVal;
+	}
+
+	// Local times that are repeated when DST ends have two valid answers, and which one mktime()
+	// picks can depend on what it was asked before (glibc remembers the last offset it used)
+	bool IsSameWallClockTime(const time_point_t& lhs, const time_point_t& rhs)
+	{
+		const auto lhsTime = tfbd_clock_t::to_time_t(lhs);
+		const auto rhsTime = tfbd_clock_t::to_time_t(rhs);
+		const std::tm lhsTM = *std::localtime(&lhsTime);
+		const std::tm rhsTM = *std::localtime(&rhsTime);
+
+		return lhsTM.tm_year == rhsTM.tm_year && lhsTM.tm_mon == rhsTM.tm_mon && lhsTM.tm_mday == rhsTM.tm_mday &&
+			lhsTM.tm_hour == rhsTM.tm_hour && lhsTM.tm_min == rhsTM.tm_min && lhsTM.tm_sec == rhsTM.tm_sec;
+	}
+
+	void RequireDecoderParity(const std::vector<ConsoleLogTimestamp>& timestamps, ConsoleLogTimestampDecoder& decoder)
+	{
+		for (const auto& ts : timestamps)
+		{
+			const auto expected = ts.ToTimePoint();
+			const auto actual = decoder.ToTimePoint(ts);
+			if (actual != expected && !IsSameWallClockTime(actual, expected))
+			{
+				FAIL(mh::format("{:02}/{:02}/{:04} - {:02}:{:02}:{:02}: expected {}, got {}",
+					ts.m_Month, ts.m_Day, ts.m_Year, ts.m_Hour, ts.m_Minute, ts.m_Second,
+					tfbd_clock_t::to_time_t(expected), tfbd_clock_t::to_time_t(actual)));
+			}
+		}
+	}
+}
+
+TEST_CASE("tf2bd_conlog_timestamp_scanner", "[ConsoleLog]")
+{
+	constexpr std::string_view TEST_CASES[] =
+	{
+		"",
+		"\n",
+		"\n01/02/2021 - 03:04:05: line",
+		"\n01/02/2021 - 03:04:05:\n01/02/2021 - 03:04:06: empty line before this one",
+		"garbage\n01/02/2021 - 03:04:05: line\n01/02/2021 - 03:04:06: another",
+		"\n01/02/2021 - 03:04:05:",                  // Missing trailing character
+		"\n01/02/2021 - 03:04:05:x",                 // Bad trailing character
+		"\n1/02/2021 - 03:04:05: line",              // Not zero-padded
+		"\n01/02/21 - 03:04:05: line",               // Two digit year
+		"\n01-02-2021 - 03:04:05: line",             // Wrong separators
+		"\n\n01/02/2021 - 03:04:05: line",           // Consecutive newlines
+		"\n01/02/2021 - 03:04:05 line\n12/31/2020 - 23:59:59: line",
+		"\n01/02/2021 - 03:04:05: \n01/02/2021 - 03:04:05:",
+		"\n01/02/2021 - 03:04:05: a\n01/0",          // Partial timestamp at the end of the buffer
+	};
+
+	for (const auto& test : TEST_CASES)
+	{
+		INFO("Buffer: " << std::string(test));
+		CHECK(FindAllWithScanner(test) == FindAllWithRegex(test));
+	}
+
+	const auto log = GenerateConsoleLog(1024 * 64);
+	const auto expected = FindAllWithRegex(log);
+	REQUIRE(!expected.empty());
+	REQUIRE(FindAllWithScanner(log) == expected);
+
+	// Starting in the middle of a timestamp skips it
+	REQUIRE(FindConsoleLogTimestamp(log, 1)->m_Begin == expected.at(1).m_Begin);
+}
+
+TEST_CASE("tf2bd_conlog_timestamp_decoder", "[ConsoleLog]")
+{
+	constexpr const char* TIMEZONES[] =
+	{
+#ifdef _WIN32
+		// The MSVC CRT only understands "tzn[+|-]hh[:mm[:ss]][dzn]" and ignores POSIX transition
+		// rules. Any zone with a DST name gets the US rules, so there is no way to test a
+		// southern hemisphere zone here. What's left still covers both offsets and both transitions.
+		"UTC0",
+		"PST8PDT",
+		"CET-1CEST",
+		"AEST-10AEDT",
+#else
+		"UTC0",
+		"PST8PDT,M3.2.0,M11.1.0",        // DST changes at 2am
+		"CET-1CEST,M3.5.0,M10.5.0/3",     // DST changes at 2am/3am
+		"AEST-10AEDT,M10.1.0,M4.1.0/3",   // Southern hemisphere, DST over new year
+		"NZST-12NZDT,M9.5.0,M4.1.0/3",
+#endif
+	};
+
+	for (const char* tz : TIMEZONES)
+	{
+		INFO("TZ: " << tz);
+		const ScopedTimezone scopedTZ(tz);
+
+		// Make sure the CRT actually took the zone, instead of quietly testing UTC over and over
+		if (std::string_view(tz) != "UTC0")
+		{
+			const auto IsDST = [](int month)
+			{
+				std::tm time{};
+				time.tm_year = 2021 - 1900;
+				time.tm_mon = month;
+				time.tm_mday = 15;
+				time.tm_hour = 12;
+				time.tm_isdst = -1;
+				std::mktime(&time);
+				return time.tm_isdst > 0;
+			};
+			REQUIRE(IsDST(0) != IsDST(6));
+		}
+
+		// Consecutive lines, like a real console.log
+		{
+			const auto timestamps = GenerateTimestamps(2020, 2022, 397);
+			ConsoleLogTimestampDecoder decoder;
+			RequireDecoderParity(timestamps, decoder);
+
+			// A couple of mktime() calls per day (and more on DST days), not one per line
+			CHECK(decoder.GetFullConversionCount() < (timestamps.size() / 50));
+		}
+
+		// Finer steps, so the edges of the DST transition windows get hit too
+		{
+			const auto timestamps = GenerateTimestamps(2021, 2022, 13);
+			ConsoleLogTimestampDecoder decoder;
+			RequireDecoderParity(timestamps, decoder);
+		}
+
+		// Out of order, and values mktime() has to normalize
+		{
+			std::vector<ConsoleLogTimestamp> timestamps;
+			const auto Add = [&](int month, int day, int year, int hour, int minute, int second)
+			{
+				auto& ts = timestamps.emplace_back();
+				ts.m_Month = month;
+				ts.m_Day = day;
+				ts.m_Year = year;
+				ts.m_Hour = hour;
+				ts.m_Minute = minute;
+				ts.m_Second = second;
+			};
+
+			Add(3, 14, 2021, 1, 59, 59);
+			Add(3, 28, 2021, 2, 30, 0);
+			Add(3, 14, 2021, 3, 0, 0);
+			Add(11, 7, 2021, 1, 30, 0);
+			Add(3, 14, 2021, 2, 30, 0);
+			Add(2, 29, 2021, 12, 0, 0);  // Not a leap year
+			Add(2, 29, 2020, 12, 0, 0);
+			Add(13, 1, 2021, 0, 0, 0);
+			Add(0, 0, 2021, 0, 0, 0);
+			Add(6, 30, 2021, 23, 59, 60); // Leap second
+			Add(6, 30, 2021, 24, 0, 0);
+			Add(6, 30, 2021, 12, 99, 99);
+			Add(1, 1, 2021, 0, 0, 0);
+			Add(12, 31, 2021, 23, 59, 59);
+
+			ConsoleLogTimestampDecoder decoder;
+			RequireDecoderParity(timestamps, decoder);
+		}
+	}
+}
+
+TEST_CASE("tf2bd_conlog_timestamp_scanner_benchmark", "[ConsoleLog][.benchmark]")
+{
+	const auto log = GenerateConsoleLog(1024 * 1024 * 4);
+
+	BENCHMARK("std::regex_search")
+	{
+		return FindAllWithRegex(log).size();
+	};
+
+	BENCHMARK("FindConsoleLogTimestamp")
+	{
+		return FindAllWithScanner(log).size();
+	};
+}
+
+TEST_CASE("tf2bd_conlog_timestamp_decoder_benchmark", "[ConsoleLog][.benchmark]")
+{
+	const auto timestamps = GenerateTimestamps(2021, 2022, 31);
+
+	BENCHMARK("ConsoleLogTimestamp::ToTimePoint")
+	{
+		int64_t total = 0;
+		for (const auto& ts : timestamps)
+			total += ts.ToTimePoint().time_since_epoch().count();
+
+		return total;
+	};
+
+	BENCHMARK("ConsoleLogTimestampDecoder")
+	{
+		ConsoleLogTimestampDecoder decoder;
+		int64_t total = 0;
+		for (const auto& ts : timestamps)
+			total += decoder.ToTimePoint(ts).time_since_epoch().count();
+
+		return total;
+	};
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "WorldState.h"
+
+#include <mh/error/not_implemented_error.hpp>
+
+namespace tf2_bot_detector
+{
+	// An IWorldState that throws if anything is asked of it, for testing code that shouldn't
+	// need one (or shouldn't need much of one).
+	class DummyWorldState : public IWorldState
+	{
+		// Inherited via IWorldState
+		virtual IConsoleLineListener& GetConsoleLineListenerBroadcaster() override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual void UpdateTimestamp(const ConsoleLogParser& parser) override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual void Update() override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual time_point_t GetCurrentTime() const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual time_point_t GetLastStatusUpdateTime() const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual void AddWorldEventListener(IWorldEventListener* listener, WorldEvent interest) override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual void RemoveWorldEventListener(IWorldEventListener* listener) override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual void AddConsoleLineListener(IConsoleLineListener* listener, ConsoleLineTypeMask interest) override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual void RemoveConsoleLineListener(IConsoleLineListener* listener) override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual void AddConsoleOutputChunk(const std::string_view& chunk) override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual mh::task<> AddConsoleOutputLine(std::string line) override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual std::optional<SteamID> FindSteamIDForName(const std::string_view& playerName) const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual std::optional<LobbyMemberTeam> FindLobbyMemberTeam(const SteamID& id) const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual std::optional<UserID_t> FindUserID(const SteamID& id) const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual const IPlayer* FindPlayerByUserID(UserID_t userID) const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual TeamShareResult GetTeamShareResult(const SteamID& id) const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual TeamShareResult GetTeamShareResult(const SteamID& id0, const SteamID& id1) const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual TeamShareResult GetTeamShareResult(const std::optional<LobbyMemberTeam>& team0, const SteamID& id1) const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual const IPlayer* FindPlayer(const SteamID& id) const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual size_t GetApproxLobbyMemberCount() const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual PlayerRange<const IPlayer> GetLobbyMembers() const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual PlayerRange<const IPlayer> GetPlayers() const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual uint64_t GetLobbyGeneration() const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual bool IsLocalPlayerInitialized() const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual bool IsVoteInProgress() const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual const IAccountAges& GetAccountAges() const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual const PlayerCacheStats& GetPlayerCacheStats() const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual const StatusUpdateStats& GetStatusUpdateStats() const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual const ConsoleLineCoalescerStats& GetConsoleLineCoalescerStats() const override
+		{
+			throw mh::not_implemented_error();
+		}
+		virtual ExternalDataStats GetExternalDataStats() const override
+		{
+			throw mh::not_implemented_error();
+		}
+	};
+}
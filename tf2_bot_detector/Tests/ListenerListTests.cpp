@@ -0,0 +1,96 @@
+#include "Util/ListenerList.h"
+
+#include <catch2/catch.hpp>
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	struct TestListener
+	{
+		int m_ID = 0;
+		std::function<void()> m_OnCalled;
+	};
+}
+
+TEST_CASE("tf2bd_listener_list", "[Util]")
+{
+	ListenerList<TestListener> list;
+	TestListener a{ 1 }, b{ 2 }, c{ 3 };
+	list.Add(&a);
+	list.Add(&b);
+	list.Add(&c);
+	list.Add(&b);
+	REQUIRE(list.size() == 3);
+
+	std::vector<int> called;
+	const auto Dispatch = [&]
+	{
+		called.clear();
+		list.ForEach([&](TestListener& l)
+			{
+				called.push_back(l.m_ID);
+				if (l.m_OnCalled)
+					l.m_OnCalled();
+			});
+	};
+
+	SECTION("Called in the order they were added")
+	{
+		Dispatch();
+		REQUIRE(called == std::vector{ 1, 2, 3 });
+	}
+	SECTION("Removing yourself doesn't skip the next listener")
+	{
+		a.m_OnCalled = [&] { list.Remove(&a); };
+		Dispatch();
+		REQUIRE(called == std::vector{ 1, 2, 3 });
+		REQUIRE(list.size() == 2);
+
+		Dispatch();
+		REQUIRE(called == std::vector{ 2, 3 });
+	}
+	SECTION("Listeners removed by an earlier one aren't called")
+	{
+		a.m_OnCalled = [&] { list.Remove(&b); };
+		Dispatch();
+		REQUIRE(called == std::vector{ 1, 3 });
+		REQUIRE(!list.Contains(&b));
+	}
+	SECTION("Removing an earlier listener doesn't skip the next one")
+	{
+		b.m_OnCalled = [&] { list.Remove(&a); };
+		Dispatch();
+		REQUIRE(called == std::vector{ 1, 2, 3 });
+	}
+	SECTION("Listeners added during a dispatch are called by it")
+	{
+		TestListener d{ 4 };
+		a.m_OnCalled = [&] { list.Add(&d); };
+		Dispatch();
+		REQUIRE(called == std::vector{ 1, 2, 3, 4 });
+	}
+	SECTION("Nested dispatches")
+	{
+		bool nested = false;
+		b.m_OnCalled = [&]
+		{
+			if (std::exchange(nested, true))
+				return;
+
+			list.Remove(&b);
+			list.ForEach([&](TestListener& l) { called.push_back(l.m_ID * 10); });
+		};
+
+		Dispatch();
+		REQUIRE(called == std::vector{ 1, 2, 10, 30, 3 });
+		REQUIRE(list.size() == 2);
+
+		Dispatch();
+		REQUIRE(called == std::vector{ 1, 3 });
+	}
+}
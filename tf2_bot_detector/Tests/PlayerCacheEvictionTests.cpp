@@ -0,0 +1,48 @@
+#include "PlayerCacheEviction.h"
+
+#include <catch2/catch.hpp>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	PlayerEvictionCandidate MakeCandidate(uint32_t accountID, int lastSeenMinutes, size_t bytes, bool evictable = true)
+	{
+		PlayerEvictionCandidate candidate;
+		candidate.m_SteamID = SteamID(accountID, SteamAccountType::Individual);
+		candidate.m_LastSeen = time_point_t(std::chrono::minutes(lastSeenMinutes));
+		candidate.m_ApproxBytes = bytes;
+		candidate.m_Evictable = evictable;
+		return candidate;
+	}
+
+	SteamID MakeSteamID(uint32_t accountID)
+	{
+		return SteamID(accountID, SteamAccountType::Individual);
+	}
+}
+
+TEST_CASE("tf2bd_player_cache_eviction", "[WorldState]")
+{
+	const std::vector<PlayerEvictionCandidate> candidates
+	{
+		MakeCandidate(1, 30, 100),
+		MakeCandidate(2, 10, 100),
+		MakeCandidate(3, 20, 100),
+		MakeCandidate(4, 0, 100, false),   // Oldest, but still around
+	};
+
+	SECTION("Under the limit")
+	{
+		REQUIRE(SelectPlayersToEvict(candidates, 400).empty());
+	}
+	SECTION("Least recently seen first, only as many as needed")
+	{
+		REQUIRE(SelectPlayersToEvict(candidates, 250) == std::vector{ MakeSteamID(2), MakeSteamID(3) });
+	}
+	SECTION("Never evicts players who aren't evictable")
+	{
+		REQUIRE(SelectPlayersToEvict(candidates, 0) == std::vector{ MakeSteamID(2), MakeSteamID(3), MakeSteamID(1) });
+	}
+}
@@ -0,0 +1,153 @@
+#include "PlayerDataStorage.h"
+
+#include <catch2/catch.hpp>
+
+#include <any>
+#include <map>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	struct SmallData
+	{
+		int m_Value = 0;
+		std::string m_Text;
+	};
+
+	struct LargeData
+	{
+		char m_Bytes[PlayerDataStorage::INLINE_DATA_SIZE + 1]{};
+	};
+
+	template<int N>
+	struct CountedData
+	{
+		explicit CountedData(int& liveCount) : m_LiveCount(liveCount) { m_LiveCount++; }
+		~CountedData() { m_LiveCount--; }
+
+		int& m_LiveCount;
+	};
+
+	// What players used to do
+	struct AnyMapStorage
+	{
+		template<typename T> T& GetOrCreate()
+		{
+			auto& storage = m_Data[typeid(T)];
+			if (!storage.has_value())
+				return storage.emplace<T>();
+			else
+				return std::any_cast<T&>(storage);
+		}
+
+		std::map<std::type_index, std::any> m_Data;
+	};
+}
+
+TEST_CASE("tf2bd_player_data_storage", "[PlayerDataStorage]")
+{
+	PlayerDataStorage storage;
+	REQUIRE(!storage.Find<SmallData>());
+
+	SECTION("GetOrCreate only creates once")
+	{
+		storage.GetOrCreate<SmallData>().m_Value = 5;
+		REQUIRE(storage.GetOrCreate<SmallData>().m_Value == 5);
+		REQUIRE(storage.Find<SmallData>() == &storage.GetOrCreate<SmallData>());
+		REQUIRE(!storage.Find<LargeData>());
+	}
+	SECTION("Emplace replaces")
+	{
+		storage.GetOrCreate<SmallData>().m_Text = "Pootis";
+		REQUIRE(storage.Emplace<SmallData>(7, "Sandvich").m_Text == "Sandvich");
+		REQUIRE(storage.Find<SmallData>()->m_Value == 7);
+	}
+	SECTION("Data too large to store inline")
+	{
+		storage.GetOrCreate<LargeData>().m_Bytes[PlayerDataStorage::INLINE_DATA_SIZE] = 'x';
+		REQUIRE(storage.Find<LargeData>()->m_Bytes[PlayerDataStorage::INLINE_DATA_SIZE] == 'x');
+	}
+	SECTION("Destroys what it holds")
+	{
+		int liveCount = 0;
+		{
+			PlayerDataStorage inner;
+			inner.GetOrCreate<CountedData<0>>(liveCount);
+			inner.GetOrCreate<CountedData<1>>(liveCount);
+			inner.GetOrCreate<CountedData<2>>(liveCount);
+			inner.GetOrCreate<CountedData<3>>(liveCount);
+			inner.GetOrCreate<CountedData<4>>(liveCount);
+			REQUIRE(liveCount == 5);
+
+			inner.Erase<CountedData<1>>();
+			REQUIRE(liveCount == 4);
+			REQUIRE(!inner.Find<CountedData<1>>());
+
+			inner.Emplace<CountedData<2>>(liveCount);
+			REQUIRE(liveCount == 4);
+		}
+		REQUIRE(liveCount == 0);
+	}
+	SECTION("More types than inline slots")
+	{
+		// Doesn't matter which of these were registered first, there are more of them than
+		// there are inline slots
+		int liveCount = 0;
+		PlayerDataStorage inner;
+		inner.GetOrCreate<CountedData<10>>(liveCount);
+		inner.GetOrCreate<CountedData<11>>(liveCount);
+		inner.GetOrCreate<CountedData<12>>(liveCount);
+		inner.GetOrCreate<CountedData<13>>(liveCount);
+		inner.GetOrCreate<CountedData<14>>(liveCount);
+		REQUIRE(PlayerDataStorage::GetRegisteredSlotCount() > PlayerDataStorage::INLINE_SLOTS);
+
+		REQUIRE(inner.Find<CountedData<10>>());
+		REQUIRE(inner.Find<CountedData<14>>());
+		REQUIRE(!inner.Find<CountedData<15>>());
+
+		inner.Erase<CountedData<10>>();
+		inner.Erase<CountedData<14>>();
+		REQUIRE(liveCount == 3);
+	}
+}
+
+TEST_CASE("tf2bd_player_data_storage_benchmark", "[PlayerDataStorage][.benchmark]")
+{
+	std::vector<PlayerDataStorage> slotStorages(100);
+	std::vector<AnyMapStorage> anyStorages(100);
+
+	// A few other types ahead of the one we want, like players actually have
+	for (auto& storage : anyStorages)
+	{
+		storage.GetOrCreate<LargeData>();
+		storage.GetOrCreate<std::string>();
+		storage.GetOrCreate<SmallData>();
+	}
+	for (auto& storage : slotStorages)
+	{
+		storage.GetOrCreate<LargeData>();
+		storage.GetOrCreate<std::string>();
+		storage.GetOrCreate<SmallData>();
+	}
+
+	BENCHMARK("GetOrCreate, type_index -> std::any map, 100 players")
+	{
+		int sum = 0;
+		for (auto& storage : anyStorages)
+			sum += storage.GetOrCreate<SmallData>().m_Value;
+
+		return sum;
+	};
+	BENCHMARK("GetOrCreate, slots, 100 players")
+	{
+		int sum = 0;
+		for (auto& storage : slotStorages)
+			sum += storage.GetOrCreate<SmallData>().m_Value;
+
+		return sum;
+	};
+}
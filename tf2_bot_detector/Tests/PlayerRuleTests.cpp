@@ -14,6 +14,7 @@ namespace
 	struct MockPlayer : IPlayer
 	{
 		std::string m_Name;
+		mh::expected<SteamAPI::PlayerSummary, std::error_condition> m_Summary = std::errc::operation_in_progress;
 
 		const IWorldState& GetWorld() const override { throw mh::not_implemented_error(); }
 
@@ -29,7 +30,7 @@ namespace
 		}
 		const mh::expected<SteamAPI::PlayerSummary, std::error_condition>& GetPlayerSummary() const override
 		{
-			throw mh::not_implemented_error();
+			return m_Summary;
 		}
 		const mh::expected<SteamAPI::PlayerBans, std::error_condition>& GetPlayerBans() const override
 		{
@@ -79,11 +80,7 @@ namespace
 		{
 			throw mh::not_implemented_error();
 		}
-		std::any& GetOrCreateDataStorage(const std::type_index& type) override
-		{
-			throw mh::not_implemented_error();
-		}
-		const std::any* FindDataStorage(const std::type_index& type) const override
+		const PlayerDataStorage& GetDataStorage() const override
 		{
 			throw mh::not_implemented_error();
 		}
@@ -193,3 +190,48 @@ TEST_CASE("Player Rules - chatmsg word", "[PlayerRuleTests]")
 	textMatch.m_Patterns = { "smelly" };
 	REQUIRE(!rule.Match(player, chatMsg));
 }
+
+TEST_CASE("Player Rules - inputs", "[PlayerRuleTests]")
+{
+	MockPlayer player;
+	player.m_Name = "Special Gamer";
+
+	const ConfigFileGroupVersion loading{ 1, false, false };
+	const ModerationRuleInputs checked(loading, player);
+	REQUIRE(checked == ModerationRuleInputs(loading, player));
+
+	SECTION("Rules that finish loading after the player was checked")
+	{
+		REQUIRE(checked != ModerationRuleInputs({ 1, true, false }, player));
+		REQUIRE(checked != ModerationRuleInputs({ 1, false, true }, player));
+	}
+	SECTION("Rules that were reloaded")
+	{
+		REQUIRE(checked != ModerationRuleInputs({ 2, false, false }, player));
+	}
+	SECTION("Player summary")
+	{
+		SteamAPI::PlayerSummary summary;
+		summary.m_Nickname = "Special Gamer";
+		summary.m_AvatarHash = "0123456789abcdef";
+		player.m_Summary = summary;
+
+		const ModerationRuleInputs withSummary(loading, player);
+		REQUIRE(checked != withSummary);
+
+		player.m_Summary->m_Nickname = "Even More Special Gamer";
+		REQUIRE(withSummary != ModerationRuleInputs(loading, player));
+
+		player.m_Summary = summary;
+		player.m_Summary->m_AvatarHash = "fedcba9876543210";
+		REQUIRE(withSummary != ModerationRuleInputs(loading, player));
+
+		player.m_Summary = summary;
+		REQUIRE(withSummary == ModerationRuleInputs(loading, player));
+	}
+	SECTION("Name")
+	{
+		player.m_Name = "Gamer";
+		REQUIRE(checked != ModerationRuleInputs(loading, player));
+	}
+}
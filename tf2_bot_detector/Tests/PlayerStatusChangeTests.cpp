@@ -0,0 +1,67 @@
+#include "PlayerStatus.h"
+
+#include <catch2/catch.hpp>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	PlayerStatus MakeStatus()
+	{
+		PlayerStatus status;
+		status.m_Name = "Player";
+		status.m_Address = "127.0.0.1:27005";
+		status.m_SteamID = SteamID(1234, SteamAccountType::Individual);
+		status.m_ConnectionTime = time_point_t(10min);
+		status.m_UserID = 42;
+		status.m_Ping = 50;
+		status.m_Loss = 0;
+		status.m_State = PlayerStatusState::Active;
+		return status;
+	}
+}
+
+TEST_CASE("tf2bd_player_status_change", "[WorldState]")
+{
+	const PlayerStatus oldStatus = MakeStatus();
+	PlayerStatus newStatus = oldStatus;
+
+	SECTION("Identical rows")
+	{
+		REQUIRE(ClassifyPlayerStatusChange(oldStatus, newStatus) == PlayerStatusChange::None);
+	}
+	SECTION("Ping only")
+	{
+		newStatus.m_Ping = 60;
+		REQUIRE(ClassifyPlayerStatusChange(oldStatus, newStatus) == PlayerStatusChange::Ping);
+
+		newStatus.m_Ping = oldStatus.m_Ping;
+		newStatus.m_Loss = 3;
+		REQUIRE(ClassifyPlayerStatusChange(oldStatus, newStatus) == PlayerStatusChange::Ping);
+	}
+	SECTION("Name")
+	{
+		newStatus.m_Name = "Renamed";
+		newStatus.m_Ping = 60;
+		REQUIRE(ClassifyPlayerStatusChange(oldStatus, newStatus) == (PlayerStatusChange::Name | PlayerStatusChange::Ping));
+	}
+	SECTION("State")
+	{
+		newStatus.m_State = PlayerStatusState::Spawning;
+		REQUIRE(ClassifyPlayerStatusChange(oldStatus, newStatus) == PlayerStatusChange::State);
+	}
+	SECTION("Reconnected")
+	{
+		newStatus.m_UserID = 43;
+		newStatus.m_ConnectionTime = time_point_t(0s);
+		REQUIRE(ClassifyPlayerStatusChange(oldStatus, newStatus) == PlayerStatusChange::Connection);
+	}
+	SECTION("First row for a player")
+	{
+		PlayerStatus initial{};
+		initial.m_SteamID = oldStatus.m_SteamID;
+		REQUIRE(ClassifyPlayerStatusChange(initial, oldStatus) ==
+			(PlayerStatusChange::Name | PlayerStatusChange::State | PlayerStatusChange::Connection | PlayerStatusChange::Ping));
+	}
+}
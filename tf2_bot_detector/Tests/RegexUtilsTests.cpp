@@ -0,0 +1,21 @@
+#include "Util/RegexUtils.h"
+
+#include <catch2/catch.hpp>
+
+using namespace tf2_bot_detector;
+
+TEST_CASE("tf2bd_regex_cache", "[Regex]")
+{
+	const std::regex& a = GetCachedRegex(R"regex((\d+) ms)regex");
+	const std::regex& b = GetCachedRegex(std::string(R"regex((\d+) ms)regex"));
+	REQUIRE(&a == &b);
+	REQUIRE(std::regex_match("57 ms", a));
+
+	const std::regex& icase = GetCachedRegex("pl_upward", std::regex::icase);
+	REQUIRE(&icase != &GetCachedRegex("pl_upward"));
+	REQUIRE(std::regex_match("PL_UPWARD", icase));
+	REQUIRE(!std::regex_match("PL_UPWARD", GetCachedRegex("pl_upward")));
+
+	REQUIRE_THROWS_AS(GetCachedRegex("(unbalanced"), std::regex_error);
+	REQUIRE_THROWS_AS(GetCachedRegex("(unbalanced"), std::regex_error);
+}
@@ -0,0 +1,74 @@
+#include "Util/SPSCRing.h"
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <thread>
+
+using namespace tf2_bot_detector;
+
+TEST_CASE("tf2bd_spsc_ring", "[Util]")
+{
+	SECTION("Capacity is rounded up to a power of two")
+	{
+		REQUIRE(SPSCRing<int>(0).capacity() == 1);
+		REQUIRE(SPSCRing<int>(5).capacity() == 8);
+		REQUIRE(SPSCRing<int>(32).capacity() == 32);
+	}
+
+	SECTION("Fills up and drains in order")
+	{
+		SPSCRing<std::unique_ptr<int>> ring(4);
+
+		for (int i = 0; i < 4; i++)
+			REQUIRE(ring.TryPush(std::make_unique<int>(i)));
+
+		auto extra = std::make_unique<int>(4);
+		REQUIRE(!ring.TryPush(std::move(extra)));
+		REQUIRE(extra); // Left alone when the ring is full
+		REQUIRE(ring.size() == 4);
+
+		std::unique_ptr<int> value;
+		for (int i = 0; i < 4; i++)
+		{
+			REQUIRE(ring.TryPop(value));
+			REQUIRE(*value == i);
+		}
+
+		REQUIRE(!ring.TryPop(value));
+		REQUIRE(ring.empty());
+	}
+
+	SECTION("Two threads")
+	{
+		constexpr size_t VALUE_COUNT = 200'000;
+		SPSCRing<size_t> ring(16);
+
+		std::thread producer([&]
+			{
+				for (size_t i = 0; i < VALUE_COUNT; i++)
+				{
+					while (!ring.TryPush(size_t(i)))
+						std::this_thread::yield();
+				}
+			});
+
+		size_t expected = 0;
+		bool inOrder = true;
+		while (expected < VALUE_COUNT)
+		{
+			size_t value;
+			if (!ring.TryPop(value))
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			inOrder &= (value == expected++);
+		}
+
+		producer.join();
+		REQUIRE(inOrder);
+		REQUIRE(ring.empty());
+	}
+}
@@ -0,0 +1,113 @@
+#include "ConsoleLog/ConsoleLines.h"
+#include "ConsoleLog/ServerStatusBlock.h"
+#include "Tests/DummyWorldState.h"
+
+#include <catch2/catch.hpp>
+
+#include <string_view>
+#include <vector>
+
+using namespace std::string_view_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	DummyWorldState s_DummyWorldState;
+
+	// Feeds the lines through the assembler like WorldState does, with one chunk per inner vector
+	std::vector<ServerStatusBlock> AssembleBlocks(const std::vector<std::vector<std::string_view>>& chunks)
+	{
+		std::vector<ServerStatusBlock> blocks;
+		ServerStatusBlockAssembler assembler;
+
+		for (const auto& chunk : chunks)
+		{
+			for (const auto& text : chunk)
+			{
+				if (auto parsed = IConsoleLine::ParseConsoleLine(text, tfbd_clock_t::now(), s_DummyWorldState))
+				{
+					if (auto block = assembler.AddLine(*parsed))
+						blocks.push_back(std::move(*block));
+				}
+			}
+
+			if (auto block = assembler.Flush())
+				blocks.push_back(std::move(*block));
+		}
+
+		return blocks;
+	}
+
+	constexpr std::string_view STATUS_HEADER[] =
+	{
+		"hostname: Valve Matchmaking Server (Virginia iad-1/srcds148 #23)"sv,
+		"version : 6300758/24 6300758 secure"sv,
+		"map     : pl_badwater at: 0 x, 0 y, 0 z"sv,
+		"players : 2 humans, 0 bots (32 max)"sv,
+		"edicts  : 1183 used of 2048 max"sv,
+		"# userid name                uniqueid            connected ping loss state"sv,
+	};
+
+	constexpr auto STATUS_ROW_0 = "#    348 \"Pootis\" [U:1:1118537734] 00:51  157    0 active"sv;
+	constexpr auto STATUS_ROW_1 = "#    350 \"Sandvich\" [U:1:1009448286] 10:02   62    0 active"sv;
+
+	std::vector<std::string_view> MakeStatusDump()
+	{
+		std::vector<std::string_view> lines(std::begin(STATUS_HEADER), std::end(STATUS_HEADER));
+		lines.push_back(STATUS_ROW_0);
+		lines.push_back(STATUS_ROW_1);
+		return lines;
+	}
+}
+
+TEST_CASE("tf2bd_status_block", "[ConsoleLog]")
+{
+	SECTION("One block per status dump")
+	{
+		const auto blocks = AssembleBlocks({ MakeStatusDump() });
+		REQUIRE(blocks.size() == 1);
+		REQUIRE(blocks[0].m_HasHeader);
+		REQUIRE(blocks[0].m_Players == std::vector<SteamID>{ SteamID("[U:1:1118537734]"sv), SteamID("[U:1:1009448286]"sv) });
+	}
+
+	SECTION("Parsed lines after the rows end the block")
+	{
+		auto lines = MakeStatusDump();
+		lines.push_back("Voice - chan 1, ent 7, bufsize: 128"sv);
+		lines.push_back(STATUS_ROW_0);
+
+		const auto blocks = AssembleBlocks({ lines });
+		REQUIRE(blocks.size() == 2);
+		REQUIRE(blocks[0].m_Players.size() == 2);
+		REQUIRE(!blocks[1].m_HasHeader);
+		REQUIRE(blocks[1].m_Players.size() == 1);
+	}
+
+	SECTION("Back to back status dumps")
+	{
+		auto lines = MakeStatusDump();
+		const auto second = MakeStatusDump();
+		lines.insert(lines.end(), second.begin(), second.end());
+
+		const auto blocks = AssembleBlocks({ lines });
+		REQUIRE(blocks.size() == 2);
+		REQUIRE(blocks[0].m_Players.size() == 2);
+		REQUIRE(blocks[1].m_Players.size() == 2);
+	}
+
+	SECTION("Unparsed lines don't split the rows")
+	{
+		auto lines = MakeStatusDump();
+		lines.insert(lines.end() - 1, "#      3 \"Pyro\" BOT active"sv);
+
+		const auto blocks = AssembleBlocks({ lines });
+		REQUIRE(blocks.size() == 1);
+		REQUIRE(blocks[0].m_Players.size() == 2);
+	}
+
+	SECTION("A header without rows is not a block")
+	{
+		const std::vector<std::string_view> lines(std::begin(STATUS_HEADER), std::end(STATUS_HEADER));
+		REQUIRE(AssembleBlocks({ lines, { "Voice - chan 1, ent 7, bufsize: 128"sv } }).empty());
+	}
+}
@@ -0,0 +1,252 @@
+#include "WorldStateIndices.h"
+
+#include <catch2/catch.hpp>
+#include <mh/text/format.hpp>
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	SteamID MakeSteamID(uint32_t accountID)
+	{
+		return SteamID(accountID, SteamAccountType::Individual);
+	}
+
+	LobbyMember MakeLobbyMember(uint32_t accountID, unsigned index, LobbyMemberTeam team, bool pending = false)
+	{
+		LobbyMember member{};
+		member.m_SteamID = MakeSteamID(accountID);
+		member.m_Index = index;
+		member.m_Team = team;
+		member.m_Type = LobbyMemberType::Player;
+		member.m_Pending = pending;
+		return member;
+	}
+
+	// What WorldState looked like before it had indices, and what it had to scan
+	struct BenchmarkPlayer
+	{
+		std::string m_Name;
+		UserID_t m_UserID;
+		int m_LastStatusUpdate;
+	};
+
+	struct BenchmarkWorld
+	{
+		explicit BenchmarkWorld(size_t playerCount)
+		{
+			for (uint32_t i = 0; i < playerCount; i++)
+			{
+				const SteamID id = MakeSteamID(1000 + i);
+				auto& player = m_Players[id];
+				player.m_Name = mh::format("Player name number {}", i);
+				player.m_UserID = UserID_t(300 + i);
+				player.m_LastStatusUpdate = int(i);
+
+				m_Names.Rename(id, {}, player.m_Name);
+				m_UserIDs.Update(id, std::nullopt, player.m_UserID);
+
+				(i % 4 ? m_CurrentLobby : m_PendingLobby).push_back(MakeLobbyMember(1000 + i, i,
+					i % 2 ? LobbyMemberTeam::Invaders : LobbyMemberTeam::Defenders, (i % 4) == 0));
+				m_LobbyTeams.Refresh(id, m_CurrentLobby, m_PendingLobby);
+			}
+		}
+
+		std::optional<SteamID> FindSteamIDForNameLinear(const std::string_view& name) const
+		{
+			std::optional<SteamID> retVal;
+			int lastUpdated = -1;
+			for (const auto& [id, player] : m_Players)
+			{
+				if (player.m_Name == name && player.m_LastStatusUpdate > lastUpdated)
+				{
+					retVal = id;
+					lastUpdated = player.m_LastStatusUpdate;
+				}
+			}
+
+			return retVal;
+		}
+		std::optional<SteamID> FindSteamIDForNameIndexed(const std::string_view& name) const
+		{
+			std::optional<SteamID> retVal;
+			int lastUpdated = -1;
+			for (const SteamID& id : m_Names.Find(name))
+			{
+				if (auto found = m_Players.find(id); found != m_Players.end() && found->second.m_LastStatusUpdate > lastUpdated)
+				{
+					retVal = id;
+					lastUpdated = found->second.m_LastStatusUpdate;
+				}
+			}
+
+			return retVal;
+		}
+
+		std::optional<SteamID> FindUserIDLinear(UserID_t userID) const
+		{
+			for (const auto& [id, player] : m_Players)
+			{
+				if (player.m_UserID == userID)
+					return id;
+			}
+
+			return std::nullopt;
+		}
+
+		std::optional<LobbyMemberTeam> FindLobbyMemberTeamLinear(const SteamID& id) const
+		{
+			for (const auto& member : m_CurrentLobby)
+			{
+				if (member.m_SteamID == id)
+					return member.m_Team;
+			}
+			for (const auto& member : m_PendingLobby)
+			{
+				if (member.m_SteamID == id)
+					return member.m_Team;
+			}
+
+			return std::nullopt;
+		}
+
+		std::unordered_map<SteamID, BenchmarkPlayer> m_Players;
+		std::vector<LobbyMember> m_CurrentLobby;
+		std::vector<LobbyMember> m_PendingLobby;
+
+		PlayerNameIndex m_Names;
+		UserIDIndex m_UserIDs;
+		LobbyMemberTeamIndex m_LobbyTeams;
+	};
+}
+
+TEST_CASE("tf2bd_worldstate_name_index", "[WorldState]")
+{
+	PlayerNameIndex index;
+	const SteamID a = MakeSteamID(1);
+	const SteamID b = MakeSteamID(2);
+
+	index.Rename(a, {}, "Pootis");
+	index.Rename(b, {}, "Pootis");
+	REQUIRE(index.Find("Pootis").size() == 2);
+	REQUIRE(index.Find("pootis").empty());
+
+	index.Rename(a, "Pootis", "Sandvich");
+	REQUIRE(index.Find("Pootis").size() == 1);
+	REQUIRE(index.Find("Pootis")[0] == b);
+	REQUIRE(index.Find("Sandvich").size() == 1);
+	REQUIRE(index.Find("Sandvich")[0] == a);
+
+	// Renaming to the same name doesn't add a duplicate
+	index.Rename(a, "Sandvich", "Sandvich");
+	REQUIRE(index.Find("Sandvich").size() == 1);
+
+	index.Remove(b, "Pootis");
+	REQUIRE(index.Find("Pootis").empty());
+
+	index.clear();
+	REQUIRE(index.Find("Sandvich").empty());
+}
+
+TEST_CASE("tf2bd_worldstate_userid_index", "[WorldState]")
+{
+	UserIDIndex index;
+	const SteamID a = MakeSteamID(1);
+	const SteamID b = MakeSteamID(2);
+
+	index.Update(a, std::nullopt, 10);
+	REQUIRE(index.Find(10) == a);
+	REQUIRE(!index.Find(11));
+
+	// New server, and b gets the same userid that a had on the old one
+	index.Update(b, std::nullopt, 10);
+	REQUIRE(index.Find(10) == b);
+
+	// a moving on doesn't take b's userid with it
+	index.Update(a, 10, 20);
+	REQUIRE(index.Find(10) == b);
+	REQUIRE(index.Find(20) == a);
+
+	index.Update(b, 10, std::nullopt);
+	REQUIRE(!index.Find(10));
+}
+
+TEST_CASE("tf2bd_worldstate_lobby_team_index", "[WorldState]")
+{
+	LobbyMemberTeamIndex index;
+	std::vector<LobbyMember> current{ MakeLobbyMember(1, 0, LobbyMemberTeam::Invaders) };
+	std::vector<LobbyMember> pending{ MakeLobbyMember(1, 0, LobbyMemberTeam::Defenders, true) };
+
+	index.Refresh(MakeSteamID(1), current, pending);
+	REQUIRE(index.Find(MakeSteamID(1)) == LobbyMemberTeam::Invaders);   // Current wins over pending
+
+	current.clear();
+	index.Refresh(MakeSteamID(1), current, pending);
+	REQUIRE(index.Find(MakeSteamID(1)) == LobbyMemberTeam::Defenders);
+
+	pending.clear();
+	index.Refresh(MakeSteamID(1), current, pending);
+	REQUIRE(!index.Find(MakeSteamID(1)));
+
+	// Empty slots are ignored
+	index.Refresh(SteamID{}, current, pending);
+	REQUIRE(!index.Find(SteamID{}));
+}
+
+TEST_CASE("tf2bd_worldstate_indices_match_scans", "[WorldState]")
+{
+	const BenchmarkWorld world(100);
+	for (const auto& [id, player] : world.m_Players)
+	{
+		REQUIRE(world.FindSteamIDForNameIndexed(player.m_Name) == world.FindSteamIDForNameLinear(player.m_Name));
+		REQUIRE(world.m_UserIDs.Find(player.m_UserID) == world.FindUserIDLinear(player.m_UserID));
+		REQUIRE(world.m_LobbyTeams.Find(id) == world.FindLobbyMemberTeamLinear(id));
+	}
+
+	REQUIRE(!world.FindSteamIDForNameIndexed("Nobody"));
+}
+
+TEST_CASE("tf2bd_worldstate_indices_benchmark", "[WorldState][.benchmark]")
+{
+	for (size_t playerCount : { 32, 100 })
+	{
+		const BenchmarkWorld world(playerCount);
+
+		// The last player the scans would get to, or close to it
+		const std::string name = mh::format("Player name number {}", playerCount - 1);
+		const UserID_t userID = UserID_t(300 + playerCount - 1);
+		const SteamID id = MakeSteamID(uint32_t(1000 + playerCount - 1));
+
+		BENCHMARK(mh::format("FindSteamIDForName, scan, {} players", playerCount))
+		{
+			return world.FindSteamIDForNameLinear(name);
+		};
+		BENCHMARK(mh::format("FindSteamIDForName, index, {} players", playerCount))
+		{
+			return world.FindSteamIDForNameIndexed(name);
+		};
+
+		BENCHMARK(mh::format("Find by userid, scan, {} players", playerCount))
+		{
+			return world.FindUserIDLinear(userID);
+		};
+		BENCHMARK(mh::format("Find by userid, index, {} players", playerCount))
+		{
+			return world.m_UserIDs.Find(userID);
+		};
+
+		BENCHMARK(mh::format("FindLobbyMemberTeam, scan, {} players", playerCount))
+		{
+			return world.FindLobbyMemberTeamLinear(id);
+		};
+		BENCHMARK(mh::format("FindLobbyMemberTeam, index, {} players", playerCount))
+		{
+			return world.m_LobbyTeams.Find(id);
+		};
+	}
+}
@@ -0,0 +1,282 @@
+#include "Config/Settings.h"
+#include "ConsoleLog/ConsoleLineListener.h"
+#include "ConsoleLog/ConsoleLines.h"
+#include "ConsoleLog/ConsoleLogParser.h"
+#include "GlobalDispatcher.h"
+#include "IPlayer.h"
+#include "WorldState.h"
+
+#include <catch2/catch.hpp>
+#include <mh/text/format.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace std::string_view_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	// A world state fed through a ConsoleLogParser, the same way a replay does it
+	class TestWorld final
+	{
+	public:
+		TestWorld() :
+			m_World(IWorldState::Create(m_Settings)),
+			m_Parser(*m_World, m_Settings)
+		{
+		}
+
+		IWorldState& GetWorld() const { return *m_World; }
+
+		// A line only counts as complete once the next one starts, so every call ends with a
+		// line nothing parses. Everything has the same timestamp, so the same "connected" column
+		// in two status dumps means the same connection.
+		void Feed(std::initializer_list<std::string_view> lines)
+		{
+			std::string text;
+			for (const auto& line : lines)
+				AppendLine(text, line);
+
+			AppendLine(text, "Some random line that nothing should even try to parse");
+			m_Parser.Feed(text);
+		}
+
+		std::vector<SteamID> GetLobbyMembers() const
+		{
+			std::vector<SteamID> ids;
+			for (const IPlayer& player : m_World->GetLobbyMembers())
+				ids.push_back(player.GetSteamID());
+
+			return ids;
+		}
+
+		std::vector<SteamID> GetPlayers() const
+		{
+			std::vector<SteamID> ids;
+			for (const IPlayer& player : m_World->GetPlayers())
+				ids.push_back(player.GetSteamID());
+
+			std::sort(ids.begin(), ids.end());
+			return ids;
+		}
+
+	private:
+		static void AppendLine(std::string& text, const std::string_view& line)
+		{
+			mh::format_to_container(text, "10/17/2026 - 12:00:00: {}\n", line);
+		}
+
+		Settings m_Settings{ Settings::DefaultsOnly{} };
+		std::shared_ptr<IWorldState> m_World;
+		ConsoleLogParser m_Parser;
+	};
+
+	const SteamID PLAYER_0("[U:1:1001]"sv);
+	const SteamID PLAYER_1("[U:1:1002]"sv);
+	const SteamID PLAYER_2("[U:1:1003]"sv);
+
+	// Every line dispatched, in order, with the SteamIDs the line resolved
+	class LineRecorder final : public AutoConsoleLineListener
+	{
+	public:
+		using AutoConsoleLineListener::AutoConsoleLineListener;
+
+		struct Line
+		{
+			std::optional<ConsoleLineType> m_Type;  // Unparsed if empty
+			SteamID m_ID0;
+			SteamID m_ID1;
+
+			bool operator==(const Line&) const = default;
+		};
+		std::vector<Line> m_Lines;
+
+		void OnConsoleLineParsed(IWorldState& world, IConsoleLine& line) override
+		{
+			Line& recorded = m_Lines.emplace_back();
+			recorded.m_Type = line.GetType();
+
+			if (line.GetType() == ConsoleLineType::PlayerStatus)
+			{
+				recorded.m_ID0 = static_cast<const ServerStatusPlayerLine&>(line).GetPlayerStatus().m_SteamID;
+			}
+			else if (line.GetType() == ConsoleLineType::KillNotification)
+			{
+				auto& killLine = static_cast<const KillNotificationLine&>(line);
+				recorded.m_ID0 = killLine.GetAttacker();
+				recorded.m_ID1 = killLine.GetVictim();
+			}
+		}
+
+		void OnConsoleLineUnparsed(IWorldState& world, const std::string_view& text) override
+		{
+			m_Lines.emplace_back();
+		}
+	};
+}
+
+TEST_CASE("tf2bd_worldstate_snapshots", "[WorldState]")
+{
+	TestWorld test;
+	IWorldState& world = test.GetWorld();
+
+	REQUIRE(world.GetLobbyMembers().empty());
+	REQUIRE(world.GetPlayers().empty());
+
+	const auto emptyRange = world.GetPlayers();
+	uint64_t generation = world.GetLobbyGeneration();
+
+	test.Feed({
+		"CTFLobbyShared: ID:00021ad2a8b0b1d  2 member(s), 0 pending",
+		"  Member[0] [U:1:1001]  team = TF_GC_TEAM_DEFENDERS  type = MATCH_PLAYER",
+		"  Member[1] [U:1:1002]  team = TF_GC_TEAM_INVADERS  type = MATCH_PLAYER",
+		});
+
+	// Rebuilt, and anything handed out before is stale
+	CHECK(!emptyRange.IsValid());
+	CHECK(world.GetLobbyGeneration() > generation);
+	CHECK(test.GetLobbyMembers() == std::vector<SteamID>{ PLAYER_0, PLAYER_1 });
+	CHECK(test.GetPlayers() == std::vector<SteamID>{ PLAYER_0, PLAYER_1 });
+
+	const auto lobbyRange = world.GetLobbyMembers();
+	const auto playersRange = world.GetPlayers();
+	REQUIRE(lobbyRange.IsValid());
+	REQUIRE(playersRange.IsValid());
+
+	SECTION("Status")
+	{
+		generation = world.GetLobbyGeneration();
+		test.Feed({
+			"# userid name                uniqueid            connected ping loss state",
+			"#      2 \"Pootis\" [U:1:1001] 00:51  57    0 active",
+			"#      3 \"Engineer\" [U:1:1002] 12:34  80    0 active",
+			});
+
+		// Names and a new set of players in `status` change the generation, but nobody was
+		// added or removed, so the snapshots are still good
+		CHECK(world.GetLobbyGeneration() > generation);
+		CHECK(lobbyRange.IsValid());
+		CHECK(playersRange.IsValid());
+		CHECK(test.GetLobbyMembers() == std::vector<SteamID>{ PLAYER_0, PLAYER_1 });
+
+		// Ping alone doesn't change anything
+		generation = world.GetLobbyGeneration();
+		test.Feed({
+			"# userid name                uniqueid            connected ping loss state",
+			"#      2 \"Pootis\" [U:1:1001] 00:51  61    0 active",
+			"#      3 \"Engineer\" [U:1:1002] 12:34  75    0 active",
+			});
+
+		CHECK(world.GetLobbyGeneration() == generation);
+		CHECK(lobbyRange.IsValid());
+
+		// Someone who isn't in the lobby
+		test.Feed({
+			"# userid name                uniqueid            connected ping loss state",
+			"#      2 \"Pootis\" [U:1:1001] 00:51  61    0 active",
+			"#      3 \"Engineer\" [U:1:1002] 12:34  75    0 active",
+			"#      4 \"Spy\" [U:1:1003] 00:01  40    0 spawning",
+			});
+
+		CHECK(world.GetLobbyGeneration() > generation);
+		CHECK(!lobbyRange.IsValid());
+		CHECK(!playersRange.IsValid());
+		CHECK(test.GetLobbyMembers() == std::vector<SteamID>{ PLAYER_0, PLAYER_1 });
+		CHECK(test.GetPlayers() == std::vector<SteamID>{ PLAYER_0, PLAYER_1, PLAYER_2 });
+	}
+
+	SECTION("Lobby changes")
+	{
+		generation = world.GetLobbyGeneration();
+		test.Feed({
+			"CTFLobbyShared: ID:00021ad2a8b0b1d  2 member(s), 1 pending",
+			"  Member[0] [U:1:1001]  team = TF_GC_TEAM_DEFENDERS  type = MATCH_PLAYER",
+			"  Member[1] [U:1:1002]  team = TF_GC_TEAM_INVADERS  type = MATCH_PLAYER",
+			"  Pending[0] [U:1:1003]  team = TF_GC_TEAM_INVADERS  type = MATCH_PLAYER",
+			});
+
+		CHECK(world.GetLobbyGeneration() > generation);
+		CHECK(!lobbyRange.IsValid());
+		CHECK(test.GetLobbyMembers() == std::vector<SteamID>{ PLAYER_0, PLAYER_1, PLAYER_2 });
+
+		// Down to one member
+		const auto biggerLobby = world.GetLobbyMembers();
+		generation = world.GetLobbyGeneration();
+		test.Feed({
+			"CTFLobbyShared: ID:00021ad2a8b0b1d  1 member(s), 0 pending",
+			"  Member[0] [U:1:1002]  team = TF_GC_TEAM_INVADERS  type = MATCH_PLAYER",
+			});
+
+		CHECK(world.GetLobbyGeneration() > generation);
+		CHECK(!biggerLobby.IsValid());
+		CHECK(test.GetLobbyMembers() == std::vector<SteamID>{ PLAYER_1 });
+
+		// The same lobby again
+		const auto smallerLobby = world.GetLobbyMembers();
+		generation = world.GetLobbyGeneration();
+		test.Feed({
+			"CTFLobbyShared: ID:00021ad2a8b0b1d  1 member(s), 0 pending",
+			"  Member[0] [U:1:1002]  team = TF_GC_TEAM_INVADERS  type = MATCH_PLAYER",
+			});
+
+		CHECK(world.GetLobbyGeneration() == generation);
+		CHECK(smallerLobby.IsValid());
+	}
+}
+
+TEST_CASE("tf2bd_worldstate_output_chunk", "[WorldState]")
+{
+	const Settings settings{ Settings::DefaultsOnly{} };
+	const auto world = IWorldState::Create(settings);
+	LineRecorder recorder(*world);
+
+	// Straight from rcon, no timestamps. The kill notifications can only be resolved to SteamIDs
+	// if the status rows in front of them have already been handled.
+	world->AddConsoleOutputChunk(
+		"# userid name                uniqueid            connected ping loss state\n"
+		"#      2 \"Pootis\" [U:1:1001] 00:51  57    0 active\n"
+		"#      3 \"Engineer\" [U:1:1002] 12:34  80    0 active\n"
+		"Pootis killed Engineer with scattergun.\n"
+		"Engineer killed Spy with wrench.\n");
+
+	// Has to come out after the whole first chunk, and can see everything from it
+	world->AddConsoleOutputChunk(
+		"#      4 \"Spy\" [U:1:1003] 00:01  40    0 spawning\n"
+		"Spy killed Pootis with knife. (crit)\n");
+
+	using Line = LineRecorder::Line;
+	const std::vector<Line> expected
+	{
+		Line{},
+		Line{ ConsoleLineType::PlayerStatus, PLAYER_0 },
+		Line{ ConsoleLineType::PlayerStatus, PLAYER_1 },
+		Line{ ConsoleLineType::KillNotification, PLAYER_0, PLAYER_1 },
+		Line{ ConsoleLineType::KillNotification, PLAYER_1 },  // Spy isn't here yet
+		Line{ ConsoleLineType::PlayerStatus, PLAYER_2 },
+		Line{ ConsoleLineType::KillNotification, PLAYER_2, PLAYER_0 },
+	};
+
+	// Parsed on the parsing thread, dispatched on this one
+	const auto deadline = tfbd_clock_t::now() + 10s;
+	while (recorder.m_Lines.size() < expected.size() && tfbd_clock_t::now() < deadline)
+	{
+		GetDispatcher().run();
+		std::this_thread::sleep_for(1ms);
+	}
+
+	REQUIRE(recorder.m_Lines == expected);
+
+	// Both status blocks were handled too
+	const IPlayer* spy = world->FindPlayer(PLAYER_2);
+	REQUIRE(spy);
+	CHECK(spy->GetNameUnsafe() == "Spy");
+	CHECK(world->FindSteamIDForName("Engineer") == PLAYER_1);
+}
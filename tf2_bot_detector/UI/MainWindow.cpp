@@ -1,6 +1,7 @@
 #include "MainWindow.h"
 #include "DiscordRichPresence.h"
 #include "ConsoleLog/ConsoleLines.h"
+#include "ConsoleLog/ConsoleLineParseStats.h"
 #include "Networking/GithubAPI.h"
 #include "Networking/SteamAPI.h"
 #include "ConsoleLog/NetworkStatus.h"
@@ -33,6 +34,7 @@
 #include <mh/text/fmtstr.hpp>
 #include <mh/text/string_insertion.hpp>
 #include <mh/text/stringops.hpp>
+#include <nlohmann/json.hpp>
 #include <srcon/async_client.h>
 
 #include <cassert>
@@ -67,7 +69,7 @@ MainWindow::MainWindow(ImGuiDesktop::Application& app) :
 	ILogManager::GetInstance().CleanupLogFiles();
 
 	GetWorld().AddConsoleLineListener(this);
-	GetWorld().AddWorldEventListener(this);
+	GetWorld().AddWorldEventListener(this, WorldEvent::None);
 
 	PrintDebugInfo();
 
@@ -361,6 +363,80 @@ void MainWindow::OnDrawAboutPopup()
 	}
 }
 
+void MainWindow::OnDrawParseStatsWindow()
+{
+	if (!m_ParseStatsWindowOpen)
+		return;
+
+	ImGui::SetNextWindowSize({ 700, 400 }, ImGuiCond_FirstUseEver);
+	if (ImGui::Begin("Console Parse Stats", &m_ParseStatsWindowOpen))
+	{
+		const ConsoleLineParseStats stats = ConsoleLineParseProfiler::GetStats();
+
+		if (bool timingEnabled = ConsoleLineParseProfiler::IsTimingEnabled(); ImGui::Checkbox("Time Parsers", &timingEnabled))
+			ConsoleLineParseProfiler::SetTimingEnabled(timingEnabled);
+		ImGui::SetHoverTooltip("Measures how long each line type takes to try parsing a line. Adds a little overhead to every line.");
+
+		ImGui::SameLine();
+		if (ImGui::Button("Reset"))
+			ConsoleLineParseProfiler::Reset();
+
+		ImGui::SameLine();
+		if (ImGui::Button("Save to JSON"))
+			SaveParseStats();
+
+		ImGui::TextFmt("{} lines ({} unparsed), {:1.1f} KB in {:1.1f} seconds: {:1.1f} lines/s, {:1.1f} KB/s | {:1.1f} ms parsing",
+			stats.m_Lines, stats.m_UnparsedLines, stats.m_Bytes / 1024.0f, to_seconds<float>(stats.m_Elapsed),
+			stats.GetLinesPerSecond(), stats.GetBytesPerSecond() / 1024, to_seconds<float>(stats.m_ParseTime) * 1000);
+
+		ImGui::Separator();
+
+		ImGui::Columns(7, "ParseStatsColumns");
+		for (const char* header : { "Line Type", "Attempts", "Hits", "Hit %", "Total (ms)", "Avg (ns)", "p99 (ns)" })
+		{
+			ImGui::TextFmt(header);
+			ImGui::NextColumn();
+		}
+		ImGui::Separator();
+
+		for (const ConsoleLineTypeParseStats& type : stats.m_Types)
+		{
+			if (type.m_Attempts == 0)
+				continue;
+
+			ImGui::TextFmt("{}", type.m_TypeName); ImGui::NextColumn();
+			ImGui::TextFmt("{}", type.m_Attempts); ImGui::NextColumn();
+			ImGui::TextFmt("{}", type.m_Hits); ImGui::NextColumn();
+			ImGui::TextFmt("{:1.1f}", type.GetHitRate() * 100); ImGui::NextColumn();
+			ImGui::TextFmt("{:1.2f}", to_seconds<float>(type.m_TotalTime) * 1000); ImGui::NextColumn();
+			ImGui::TextFmt("{}", type.GetAverageTime().count()); ImGui::NextColumn();
+			ImGui::TextFmt("{}", type.m_P99Time.count()); ImGui::NextColumn();
+		}
+
+		ImGui::Columns();
+
+		if (ImGui::CollapsingHeader("Unparsed Line Samples"))
+		{
+			for (const std::string& sample : stats.m_UnparsedSamples)
+				ImGui::TextUnformatted(sample.data(), sample.data() + sample.size());
+		}
+	}
+	ImGui::End();
+}
+
+void MainWindow::SaveParseStats() try
+{
+	const auto path = IFilesystem::Get().GetLogsDir() / "console_parse_stats.json";
+
+	nlohmann::json json = ConsoleLineParseProfiler::GetStats();
+	IFilesystem::Get().WriteFile(path, json.dump(1, '\t', true, nlohmann::detail::error_handler_t::replace) << '\n', PathUsage::WriteLocal);
+	Log("Saved console parse stats to {}", path);
+}
+catch (...)
+{
+	LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to save console parse stats");
+}
+
 void MainWindow::PrintDebugInfo()
 {
 	DebugLog("Debug Info:"s
@@ -471,6 +547,7 @@ void MainWindow::OnDraw()
 
 	OnDrawUpdateCheckPopup();
 	OnDrawAboutPopup();
+	OnDrawParseStatsWindow();
 
 	{
 		ISetupFlowPage::DrawState ds;
@@ -541,6 +618,61 @@ void MainWindow::OnDraw()
 
 		ImGui::TextFmt("RAM Usage: {:1.1f} MB", Platform::Processes::GetCurrentRAMUsage() / 1024.0f / 1024);
 
+		if (m_MainState)
+		{
+			const ConsoleLogReadStats& readStats = m_MainState->m_Parser.GetReadStats();
+			ImGui::TextFmt("Console Log: {:1.1f} KB/s | {:1.1f} MB total ({:1.1f} MB skipped) | buffer {} KB (peak {} KB, {} replaced) | read size {} KB",
+				readStats.m_BytesPerSecond / 1024, readStats.m_TotalBytesRead / 1024.0f / 1024,
+				readStats.m_SkippedBytes / 1024.0f / 1024,
+				readStats.m_BufferSize / 1024, readStats.m_PeakBufferSize / 1024, readStats.m_ReplacedBuffers,
+				readStats.m_ReadSize / 1024);
+			ImGui::TextFmt("Console Log Latency: {:1.1f} ms (avg {:1.1f} ms, max {:1.1f} ms) | {} wakeups ({} from size changes, {} periodic), {} idle polls",
+				to_seconds<float>(readStats.m_LastWriteToParseLatency) * 1000,
+				to_seconds<float>(readStats.m_AvgWriteToParseLatency) * 1000,
+				to_seconds<float>(readStats.m_MaxWriteToParseLatency) * 1000,
+				readStats.m_Wakeups, readStats.m_SizeWakeups, readStats.m_PeriodicWakeups, readStats.m_IdleUpdates);
+			ImGui::TextFmt("Console Log Queue: {}/{} chunks (peak {}) | {} lines pending | {} stalls ({:1.1f} ms) | {} over budget",
+				readStats.m_QueueDepth, readStats.m_QueueCapacity, readStats.m_PeakQueueDepth, readStats.m_PendingLines,
+				readStats.m_IngestStalls, to_seconds<float>(readStats.m_IngestStallTime) * 1000,
+				readStats.m_BudgetExhaustedUpdates);
+		}
+
+		{
+			const ConsoleLineCoalescerStats& coalescerStats = GetWorld().GetConsoleLineCoalescerStats();
+			ImGui::TextFmt("Coalesced Lines: {} folded into {} summaries",
+				coalescerStats.m_LinesCoalesced, coalescerStats.m_SummariesEmitted);
+		}
+
+		{
+			const PlayerCacheStats& cacheStats = GetWorld().GetPlayerCacheStats();
+			ImGui::TextFmt("Players: {} in memory (peak {}, ~{} KB) | {} evicted, {} spilled, {} rehydrated | {} on disk",
+				cacheStats.m_Players, cacheStats.m_PeakPlayers, cacheStats.m_ApproxBytes / 1024,
+				cacheStats.m_Evictions, cacheStats.m_Spills, cacheStats.m_Rehydrations, cacheStats.m_SpilledPlayers);
+
+			const StatusUpdateStats& statusStats = GetWorld().GetStatusUpdateStats();
+			ImGui::TextFmt("Status: {} dumps ({} unchanged) | {} rows: {} name, {} state, {} reconnect | {} ping only, {} unchanged (suppressed)",
+				statusStats.m_Snapshots, statusStats.m_UnchangedSnapshots, statusStats.m_Rows,
+				statusStats.m_NameChanges, statusStats.m_StateChanges, statusStats.m_Reconnects,
+				statusStats.m_PingOnlyRows, statusStats.m_UnchangedRows);
+		}
+
+		{
+			const auto BatchedActionText = [](const std::string_view& name, const BatchedActionStats& stats)
+			{
+				ImGui::TextFmt("{}: {} queued (oldest {:1.1f}s) | {} in flight ({} batches, every {:1.1f}s) | {} done, "
+					"{} given up, {:1.1f}s avg/{:1.1f}s max to data | {} sent, {} throttled, {} failed",
+					name, stats.m_Queued, to_seconds<float>(stats.m_OldestQueuedAge),
+					stats.m_InFlightItems, stats.m_InFlightBatches, to_seconds<float>(stats.m_Interval),
+					stats.m_ItemsCompleted, stats.m_ItemsGivenUp, to_seconds<float>(stats.m_AverageTimeToData),
+					to_seconds<float>(stats.m_MaxTimeToData), stats.m_BatchesSent, stats.m_Throttled, stats.m_Failed);
+			};
+
+			const ExternalDataStats dataStats = GetWorld().GetExternalDataStats();
+			BatchedActionText("Player Summaries", dataStats.m_PlayerSummaries);
+			BatchedActionText("Player Bans", dataStats.m_PlayerBans);
+			BatchedActionText("SourceBans", dataStats.m_SourceBans);
+		}
+
 		if (auto client = m_Settings.GetHTTPClient())
 		{
 			const IHTTPClient::RequestCounts reqs = client->GetRequestCounts();
@@ -683,6 +815,10 @@ void MainWindow::OnDrawMenuBar()
 		if (ImGui::MenuItem("Show Scoreboard", nullptr, &m_Settings.m_UIState.m_MainWindow.m_ScoreboardEnabled))
 			m_Settings.SaveFile();
 
+		ImGui::Separator();
+
+		ImGui::MenuItem("Show Console Parse Stats", nullptr, &m_ParseStatsWindowOpen);
+
 		ImGui::EndMenu();
 	}
 
@@ -873,46 +1009,37 @@ void MainWindow::OnConsoleLineUnparsed(IWorldState& world, const std::string_vie
 	m_ParsedLineCount++;
 }
 
-mh::generator<IPlayer&> MainWindow::PostSetupFlowState::GeneratePlayerPrintData()
+PlayerRange<IPlayer> MainWindow::PostSetupFlowState::GeneratePlayerPrintData()
 {
-	IPlayer* printData[33]{};
-	auto begin = std::begin(printData);
-	auto end = std::end(printData);
-	assert(begin <= end);
 	auto& world = m_Parent->m_WorldState;
-	assert(static_cast<size_t>(end - begin) >= world->GetApproxLobbyMemberCount());
 
-	std::fill(begin, end, nullptr);
+	// Nothing this depends on has changed, the order from last time is still good
+	if (m_PlayerPrintDataGeneration == world->GetLobbyGeneration())
+		return PlayerRange<IPlayer>(m_PlayerPrintData);
 
-	{
-		auto* current = begin;
-		for (IPlayer& member : world->GetLobbyMembers())
-		{
-			*current = &member;
-			current++;
-		}
+	m_PlayerPrintData.clear();
+	m_PlayerPrintDataGeneration = world->GetLobbyGeneration();
 
-		if (current == begin)
+	for (IPlayer& member : world->GetLobbyMembers())
+		m_PlayerPrintData.push_back(&member);
+
+	if (m_PlayerPrintData.empty())
+	{
+		// We seem to have either an empty lobby or we're playing on a community server.
+		// Just find the most recent status updates.
+		for (IPlayer& playerData : world->GetPlayers())
 		{
-			// We seem to have either an empty lobby or we're playing on a community server.
-			// Just find the most recent status updates.
-			for (IPlayer& playerData : world->GetPlayers())
+			if (playerData.GetLastStatusUpdateTime() >= (world->GetLastStatusUpdateTime() - 15s))
 			{
-				if (playerData.GetLastStatusUpdateTime() >= (world->GetLastStatusUpdateTime() - 15s))
-				{
-					*current = &playerData;
-					current++;
+				m_PlayerPrintData.push_back(&playerData);
 
-					if (current >= end)
-						break; // This might happen, but we're not in a lobby so everything has to be approximate
-				}
+				if (m_PlayerPrintData.size() >= MAX_PLAYER_PRINT_DATA)
+					break; // This might happen, but we're not in a lobby so everything has to be approximate
 			}
 		}
-
-		end = current;
 	}
 
-	std::sort(begin, end, [](const IPlayer* lhs, const IPlayer* rhs) -> bool
+	std::sort(m_PlayerPrintData.begin(), m_PlayerPrintData.end(), [](const IPlayer* lhs, const IPlayer* rhs) -> bool
 		{
 			assert(lhs);
 			assert(rhs);
@@ -942,8 +1069,7 @@ mh::generator<IPlayer&> MainWindow::PostSetupFlowState::GeneratePlayerPrintData(
 			return false;
 		});
 
-	for (auto it = begin; it != end; ++it)
-		co_yield **it;
+	return PlayerRange<IPlayer>(m_PlayerPrintData);
 }
 
 void MainWindow::UpdateServerPing(time_point_t timestamp)
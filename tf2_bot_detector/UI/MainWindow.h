@@ -90,6 +90,10 @@ namespace tf2_bot_detector
 		bool m_AboutPopupOpen = false;
 		void OpenAboutPopup() { m_AboutPopupOpen = true; }
 
+		void OnDrawParseStatsWindow();
+		bool m_ParseStatsWindowOpen = false;
+		void SaveParseStats();
+
 		void PrintDebugInfo();
 		void GenerateDebugReport();
 
@@ -109,6 +113,7 @@ namespace tf2_bot_detector
 		void OnConsoleLineParsed(IWorldState& world, IConsoleLine& line) override;
 		void OnConsoleLineUnparsed(IWorldState& world, const std::string_view& text) override;
 		void OnConsoleLogChunkParsed(IWorldState& world, bool consoleLinesParsed) override;
+		void OnConsoleLogCaughtUp(IWorldState& world) override {}
 		size_t m_ParsedLineCount = 0;
 
 		// IWorldEventListener
@@ -188,7 +193,10 @@ namespace tf2_bot_detector
 			ConsoleLogParser m_Parser;
 			std::list<std::shared_ptr<const IConsoleLine>> m_PrintingLines;  // newest to oldest order
 			static constexpr size_t MAX_PRINTING_LINES = 512;
-			mh::generator<IPlayer&> GeneratePlayerPrintData();
+			PlayerRange<IPlayer> GeneratePlayerPrintData();
+			std::vector<IPlayer*> m_PlayerPrintData;   // Sorted for the scoreboard
+			std::optional<uint64_t> m_PlayerPrintDataGeneration;
+			static constexpr size_t MAX_PLAYER_PRINT_DATA = 33;
 
 			void OnUpdateDiscord();
 #ifdef TF2BD_ENABLE_DISCORD_INTEGRATION
@@ -285,6 +285,14 @@ void SettingsWindow::OnDrawPerformanceSettings()
 			ImGui::SetHoverTooltip("Slows program refresh rate when not focused to reduce CPU/GPU usage.");
 		}
 
+		// Player cache memory limit
+		{
+			if (ImGui::SliderInt("Player memory limit", &m_Settings.m_PlayerCacheMemoryLimitMB, 1, 256, "%d MB"))
+				m_Settings.SaveFile();
+			ImGui::SetHoverTooltip("Once players take up more memory than this, those who left a while ago are"
+				" moved to the on-disk cache, and loaded back in if they return.");
+		}
+
 		ImGui::NewLine();
 		ImGui::TreePop();
 	}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	// Listeners in the order they were added. Listeners are allowed to add or remove listeners
+	// (including themselves) from inside a callback. Removed listeners are only nulled out
+	// until the outermost ForEach() is done, so nobody after them gets skipped, and they
+	// aren't called again. Listeners added during a ForEach() are called by it too.
+	template<typename TListener>
+	class ListenerList final
+	{
+	public:
+		bool Contains(const TListener* listener) const
+		{
+			return std::find(m_Listeners.begin(), m_Listeners.end(), listener) != m_Listeners.end();
+		}
+
+		// Does nothing if listener was already added
+		void Add(TListener* listener)
+		{
+			if (!Contains(listener))
+				m_Listeners.push_back(listener);
+		}
+
+		void Remove(TListener* listener)
+		{
+			if (m_DispatchDepth > 0)
+			{
+				std::replace(m_Listeners.begin(), m_Listeners.end(), listener, static_cast<TListener*>(nullptr));
+				m_NeedsCompact = true;
+			}
+			else
+			{
+				std::erase(m_Listeners, listener);
+			}
+		}
+
+		template<typename TFunc>
+		void ForEach(TFunc&& func)
+		{
+			struct DispatchScope final
+			{
+				DispatchScope(ListenerList& list) : m_List(list) { m_List.m_DispatchDepth++; }
+				~DispatchScope()
+				{
+					if (--m_List.m_DispatchDepth == 0 && m_List.m_NeedsCompact)
+					{
+						std::erase(m_List.m_Listeners, nullptr);
+						m_List.m_NeedsCompact = false;
+					}
+				}
+
+				ListenerList& m_List;
+
+			} scope(*this);
+
+			// By index, the vector may grow while we are in here
+			for (size_t i = 0; i < m_Listeners.size(); i++)
+			{
+				if (TListener* listener = m_Listeners[i])
+					func(*listener);
+			}
+		}
+
+		// Not counting listeners that were removed during the current ForEach()
+		size_t size() const
+		{
+			return m_Listeners.size() - std::count(m_Listeners.begin(), m_Listeners.end(), nullptr);
+		}
+
+	private:
+		std::vector<TListener*> m_Listeners;
+		size_t m_DispatchDepth = 0;
+		bool m_NeedsCompact = false;
+	};
+}
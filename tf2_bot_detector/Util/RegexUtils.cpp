@@ -0,0 +1,56 @@
+#include "RegexUtils.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	struct RegexCacheKeyLess
+	{
+		using is_transparent = void;
+
+		template<typename TLhs, typename TRhs>
+		bool operator()(const TLhs& lhs, const TRhs& rhs) const
+		{
+			return std::forward_as_tuple(lhs.first, std::string_view(lhs.second)) <
+				std::forward_as_tuple(rhs.first, std::string_view(rhs.second));
+		}
+	};
+
+	using RegexCacheKey = std::pair<unsigned, std::string>;
+	using RegexCacheKeyView = std::pair<unsigned, std::string_view>;
+
+	class RegexCache final
+	{
+	public:
+		const std::regex& Get(const std::string_view& pattern, std::regex_constants::syntax_option_type flags)
+		{
+			const RegexCacheKeyView key(static_cast<unsigned>(flags), pattern);
+
+			std::lock_guard lock(m_Mutex);
+			if (auto found = m_Regexes.find(key); found != m_Regexes.end())
+				return *found->second;
+
+			// Throws std::regex_error on bad patterns, before anything is inserted
+			auto regex = std::make_unique<const std::regex>(pattern.begin(), pattern.end(), flags);
+
+			return *m_Regexes.emplace(RegexCacheKey(key.first, pattern), std::move(regex)).first->second;
+		}
+
+	private:
+		std::mutex m_Mutex;
+		std::map<RegexCacheKey, std::unique_ptr<const std::regex>, RegexCacheKeyLess> m_Regexes;
+	};
+}
+
+const std::regex& tf2_bot_detector::GetCachedRegex(const std::string_view& pattern,
+	std::regex_constants::syntax_option_type flags)
+{
+	static RegexCache s_Cache;
+	return s_Cache.Get(pattern, flags);
+}
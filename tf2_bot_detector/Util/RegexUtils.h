@@ -34,4 +34,11 @@ namespace tf2_bot_detector
 			throw std::runtime_error(mh::format("Failed to parse {} as {}", std::quoted(sv), typeid(T).name()));
 		}
 	}
+
+	// Returns a std::regex compiled from pattern, building it only the first time a given
+	// pattern/flags combination is seen. Use this for patterns that are only known at runtime
+	// (rules, config files); the returned reference stays valid for the life of the program.
+	// Throws std::regex_error if the pattern is invalid, and will retry compiling it next time.
+	const std::regex& GetCachedRegex(const std::string_view& pattern,
+		std::regex_constants::syntax_option_type flags = std::regex_constants::ECMAScript);
 }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+
+namespace tf2_bot_detector
+{
+	// Bounded, lock-free queue between exactly one producer thread and one consumer thread.
+	// Values are moved into preallocated slots, so pushing and popping never allocate. The
+	// capacity is rounded up to a power of two.
+	template<typename T>
+	class SPSCRing final
+	{
+	public:
+		explicit SPSCRing(size_t capacity) :
+			m_Capacity(std::bit_ceil(std::max<size_t>(capacity, 1))),
+			m_Slots(std::make_unique<T[]>(m_Capacity))
+		{
+		}
+
+		SPSCRing(const SPSCRing&) = delete;
+		SPSCRing& operator=(const SPSCRing&) = delete;
+
+		size_t capacity() const { return m_Capacity; }
+
+		// Exact when called from the producer or the consumer, a snapshot from anywhere else
+		size_t size() const { return m_Tail.load(std::memory_order_acquire) - m_Head.load(std::memory_order_acquire); }
+		bool empty() const { return size() == 0; }
+
+		// Producer only. Returns false, and leaves value alone, if the ring is full.
+		bool TryPush(T&& value)
+		{
+			const size_t tail = m_Tail.load(std::memory_order_relaxed);
+			if ((tail - m_ProducerHead) >= m_Capacity)
+			{
+				m_ProducerHead = m_Head.load(std::memory_order_acquire);
+				if ((tail - m_ProducerHead) >= m_Capacity)
+					return false;
+			}
+
+			m_Slots[tail & (m_Capacity - 1)] = std::move(value);
+			m_Tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Consumer only. Returns false if the ring is empty.
+		bool TryPop(T& value)
+		{
+			const size_t head = m_Head.load(std::memory_order_relaxed);
+			if (head == m_ConsumerTail)
+			{
+				m_ConsumerTail = m_Tail.load(std::memory_order_acquire);
+				if (head == m_ConsumerTail)
+					return false;
+			}
+
+			T& slot = m_Slots[head & (m_Capacity - 1)];
+			value = std::move(slot);
+			slot = T{}; // Don't hold on to anything the moved-from value still owns
+			m_Head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+	private:
+		static constexpr size_t CACHE_LINE_SIZE = 64;
+
+		const size_t m_Capacity;
+		const std::unique_ptr<T[]> m_Slots;
+
+		// Each side keeps its own copy of the other side's index, and only reloads it when the
+		// ring looks full/empty. Keeps the two threads from fighting over the same cache line
+		// on every operation.
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_Head{};   // Next slot to pop, written by the consumer
+		size_t m_ConsumerTail = 0;
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_Tail{};   // Next slot to push, written by the producer
+		size_t m_ProducerHead = 0;
+	};
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <regex>
+#include <string_view>
+
+// A tiny compile-time regex engine. Patterns are spelled out as types, for example
+//
+//   (\d+) ms : (.{1,32})   =>   Seq<Cap<1, Plus<Digit>>, Lit<" ms : ">, Cap<2, Repeat<Dot, 1, 32>>>
+//
+// and matched with the same leftmost, greedy-first backtracking rules as ECMAScript std::regex,
+// so they fill in the same capture groups. Everything is resolved at compile time, and
+// matching never allocates.
+namespace tf2_bot_detector::StaticRegex
+{
+	template<size_t N>
+	struct FixedString
+	{
+		constexpr FixedString(const char(&str)[N])
+		{
+			std::copy_n(str, N, m_Data);
+		}
+
+		constexpr std::string_view view() const { return std::string_view(m_Data, N - 1); }
+
+		char m_Data[N]{};
+	};
+
+	////////////////////////
+	// Character classes //
+	////////////////////////
+
+	// \d
+	struct Digit
+	{
+		static constexpr bool Test(char c) { return c >= '0' && c <= '9'; }
+	};
+
+	// \s
+	struct Space
+	{
+		static constexpr bool Test(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+		}
+	};
+
+	// \S
+	struct NotSpace
+	{
+		static constexpr bool Test(char c) { return !Space::Test(c); }
+	};
+
+	// \w
+	struct Word
+	{
+		static constexpr bool Test(char c)
+		{
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || Digit::Test(c) || c == '_';
+		}
+	};
+
+	// .
+	struct Dot
+	{
+		static constexpr bool Test(char c) { return c != '\n' && c != '\r'; }
+	};
+
+	// (?:.|[\r\n])
+	struct AnyChar
+	{
+		static constexpr bool Test(char) { return true; }
+	};
+
+	// [...], without ranges
+	template<FixedString TChars>
+	struct OneOf
+	{
+		static constexpr bool Test(char c) { return TChars.view().find(c) != std::string_view::npos; }
+	};
+
+	// [a-z]
+	template<char TFirst, char TLast>
+	struct Range
+	{
+		static constexpr bool Test(char c) { return c >= TFirst && c <= TLast; }
+	};
+
+	// Union of several character classes, e.g. [0-9a-f]
+	template<typename... TClasses>
+	struct AnyOf
+	{
+		static constexpr bool Test(char c) { return (TClasses::Test(c) || ...); }
+	};
+
+	/////////////
+	// Matcher //
+	/////////////
+
+	using Group = std::sub_match<const char*>;
+
+	template<size_t TGroupCount>
+	using Groups = std::array<Group, TGroupCount + 1>;
+
+	struct Context
+	{
+		const char* m_Begin;
+		const char* m_End;
+		Group* m_Groups;
+	};
+
+	inline constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+
+	// Literal text
+	template<FixedString TText>
+	struct Lit
+	{
+		template<typename TCont>
+		static bool Match(const char* cur, Context& ctx, TCont&& cont)
+		{
+			constexpr std::string_view text = TText.view();
+			if (size_t(ctx.m_End - cur) < text.size() || std::string_view(cur, text.size()) != text)
+				return false;
+
+			return cont(cur + text.size());
+		}
+	};
+
+	// TClass{TMin,TMax}, TClass{TMin,TMax}?
+	template<typename TClass, size_t TMin = 0, size_t TMax = UNBOUNDED, bool TGreedy = true>
+	struct Repeat
+	{
+		template<typename TCont>
+		static bool Match(const char* cur, Context& ctx, TCont&& cont)
+		{
+			const size_t maxCount = std::min(TMax, size_t(ctx.m_End - cur));
+
+			size_t count = 0;
+			while (count < maxCount && TClass::Test(cur[count]))
+				count++;
+
+			if (count < TMin)
+				return false;
+
+			if constexpr (TGreedy)
+			{
+				for (size_t i = count + 1; i-- > TMin; )
+				{
+					if (cont(cur + i))
+						return true;
+				}
+			}
+			else
+			{
+				for (size_t i = TMin; i <= count; i++)
+				{
+					if (cont(cur + i))
+						return true;
+				}
+			}
+
+			return false;
+		}
+	};
+
+	template<typename TClass> using Star = Repeat<TClass, 0>;
+	template<typename TClass> using Plus = Repeat<TClass, 1>;
+	template<typename TClass> using LazyStar = Repeat<TClass, 0, UNBOUNDED, false>;
+
+	// One pattern after another
+	template<typename TFirst, typename... TRest>
+	struct Seq
+	{
+		template<typename TCont>
+		static bool Match(const char* cur, Context& ctx, TCont&& cont)
+		{
+			if constexpr (sizeof...(TRest) == 0)
+			{
+				return TFirst::Match(cur, ctx, cont);
+			}
+			else
+			{
+				return TFirst::Match(cur, ctx, [&](const char* next)
+					{
+						return Seq<TRest...>::Match(next, ctx, cont);
+					});
+			}
+		}
+	};
+
+	// (?:A|B|...)
+	template<typename... TAlternatives>
+	struct Alt
+	{
+		template<typename TCont>
+		static bool Match(const char* cur, Context& ctx, TCont&& cont)
+		{
+			return (TAlternatives::Match(cur, ctx, cont) || ...);
+		}
+	};
+
+	// (?:...)?
+	template<typename TPattern>
+	struct Opt
+	{
+		template<typename TCont>
+		static bool Match(const char* cur, Context& ctx, TCont&& cont)
+		{
+			return TPattern::Match(cur, ctx, cont) || cont(cur);
+		}
+	};
+
+	// (...)
+	template<size_t TIndex, typename TPattern>
+	struct Cap
+	{
+		template<typename TCont>
+		static bool Match(const char* cur, Context& ctx, TCont&& cont)
+		{
+			return TPattern::Match(cur, ctx, [&](const char* end)
+				{
+					Group& group = ctx.m_Groups[TIndex];
+					const Group prev = group;
+
+					group.first = cur;
+					group.second = end;
+					group.matched = true;
+
+					if (cont(end))
+						return true;
+
+					group = prev;
+					return false;
+				});
+		}
+	};
+
+	// Equivalent to std::regex_match: the whole of text must match TPattern.
+	template<typename TPattern, size_t TSize>
+	bool FullMatch(const std::string_view& text, std::array<Group, TSize>& groups)
+	{
+		groups.fill(Group{});
+
+		Context ctx{ text.data(), text.data() + text.size(), groups.data() };
+		if (!TPattern::Match(ctx.m_Begin, ctx, [&](const char* end) { return end == ctx.m_End; }))
+			return false;
+
+		groups[0].first = ctx.m_Begin;
+		groups[0].second = ctx.m_End;
+		groups[0].matched = true;
+		return true;
+	}
+}
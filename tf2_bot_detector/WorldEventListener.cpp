@@ -3,37 +3,52 @@
 
 using namespace tf2_bot_detector;
 
-AutoWorldEventListener::AutoWorldEventListener(IWorldState& world) :
-	m_World(&world)
+void BaseWorldEventListener::OnServerStatusSnapshot(IWorldState& world, const ServerStatusSnapshot& snapshot)
 {
-	m_World->AddWorldEventListener(this);
+	// Listeners that don't care about batching still get to see every row that changed
+	for (const ServerStatusSnapshot::Player& player : snapshot.m_Players)
+	{
+		if (player.m_Changes != PlayerStatusChange::None)
+			OnPlayerStatusUpdate(world, *player.m_Player, player.m_Changes);
+	}
+}
+
+AutoWorldEventListener::AutoWorldEventListener(IWorldState& world, WorldEvent interest) :
+	m_World(&world),
+	m_Interest(interest)
+{
+	m_World->AddWorldEventListener(this, m_Interest);
 }
 
 AutoWorldEventListener::AutoWorldEventListener(const AutoWorldEventListener& other) :
-	m_World(other.m_World)
+	m_World(other.m_World),
+	m_Interest(other.m_Interest)
 {
-	m_World->AddWorldEventListener(this);
+	m_World->AddWorldEventListener(this, m_Interest);
 }
 
 AutoWorldEventListener& AutoWorldEventListener::operator=(const AutoWorldEventListener& other)
 {
 	m_World->RemoveWorldEventListener(this);
 	m_World = other.m_World;
-	m_World->AddWorldEventListener(this);
+	m_Interest = other.m_Interest;
+	m_World->AddWorldEventListener(this, m_Interest);
 	return *this;
 }
 
 AutoWorldEventListener::AutoWorldEventListener(AutoWorldEventListener&& other) :
-	m_World(other.m_World)
+	m_World(other.m_World),
+	m_Interest(other.m_Interest)
 {
-	m_World->AddWorldEventListener(this);
+	m_World->AddWorldEventListener(this, m_Interest);
 }
 
 AutoWorldEventListener& AutoWorldEventListener::operator=(AutoWorldEventListener&& other)
 {
 	m_World->RemoveWorldEventListener(this);
 	m_World = other.m_World;
-	m_World->AddWorldEventListener(this);
+	m_Interest = other.m_Interest;
+	m_World->AddWorldEventListener(this, m_Interest);
 	return *this;
 }
 
@@ -1,8 +1,13 @@
 #pragma once
 
 #include "Clock.h"
+#include "PlayerStatus.h"
 
+#include <mh/types/enum_class_bit_ops.hpp>
+
+#include <cstdint>
 #include <string_view>
+#include <vector>
 
 namespace tf2_bot_detector
 {
@@ -10,13 +15,50 @@ namespace tf2_bot_detector
 	class IWorldState;
 	enum class TFClassType;
 
+	// All the players listed by one `status` command, see ServerStatusBlockAssembler
+	struct ServerStatusSnapshot
+	{
+		struct Player
+		{
+			const IPlayer* m_Player = nullptr;
+			PlayerStatusChange m_Changes = PlayerStatusChange::None;  // Since the previous `status` dump
+		};
+
+		bool m_HasHeader = false;   // False if only the player rows were seen
+		time_point_t m_Timestamp{};
+		std::vector<Player> m_Players;
+	};
+
+	// The IWorldEventListener callbacks a listener wants to be called for. OnPlayerStatusUpdate()
+	// is called by BaseWorldEventListener::OnServerStatusSnapshot(), so it comes with ServerStatusSnapshot.
+	enum class WorldEvent : uint8_t
+	{
+		None = 0,
+
+		TimestampUpdate = (1 << 0),
+		ServerStatusSnapshot = (1 << 1),
+		ChatMsg = (1 << 2),
+		LocalPlayerInitialized = (1 << 3),
+		LocalPlayerSpawned = (1 << 4),
+		PlayerDroppedFromServer = (1 << 5),
+
+		All = TimestampUpdate | ServerStatusSnapshot | ChatMsg | LocalPlayerInitialized | LocalPlayerSpawned | PlayerDroppedFromServer,
+	};
+	MH_ENABLE_ENUM_CLASS_BIT_OPS(WorldEvent);
+	inline constexpr size_t WORLD_EVENT_COUNT = 6;
+
 	class IWorldEventListener
 	{
 	public:
 		virtual ~IWorldEventListener() = default;
 
 		virtual void OnTimestampUpdate(IWorldState& world) = 0;
-		virtual void OnPlayerStatusUpdate(IWorldState& world, const IPlayer& player) = 0;
+		virtual void OnPlayerStatusUpdate(IWorldState& world, const IPlayer& player, PlayerStatusChange changes) = 0;
+
+		// Fired once per `status` dump, after every player in it has been updated. The
+		// player status updates are not fired individually. Players whose rows are
+		// identical to last time are still included, with PlayerStatusChange::None.
+		virtual void OnServerStatusSnapshot(IWorldState& world, const ServerStatusSnapshot& snapshot) = 0;
 		virtual void OnChatMsg(IWorldState& world, IPlayer& player, const std::string_view& msg) = 0;
 		virtual void OnLocalPlayerInitialized(IWorldState& world, bool initialized) = 0;
 		virtual void OnLocalPlayerSpawned(IWorldState& world, TFClassType classType) = 0;
@@ -27,7 +69,8 @@ namespace tf2_bot_detector
 	{
 	public:
 		void OnTimestampUpdate(IWorldState& world) override {}
-		void OnPlayerStatusUpdate(IWorldState& world, const IPlayer& player) override {}
+		void OnPlayerStatusUpdate(IWorldState& world, const IPlayer& player, PlayerStatusChange changes) override {}
+		void OnServerStatusSnapshot(IWorldState& world, const ServerStatusSnapshot& snapshot) override;
 		void OnChatMsg(IWorldState& world, IPlayer& player, const std::string_view& msg) override {}
 		void OnLocalPlayerInitialized(IWorldState& world, bool initialized) override {}
 		void OnLocalPlayerSpawned(IWorldState& world, TFClassType classType) override {}
@@ -37,7 +80,7 @@ namespace tf2_bot_detector
 	class AutoWorldEventListener : public BaseWorldEventListener
 	{
 	public:
-		AutoWorldEventListener(IWorldState& world);
+		AutoWorldEventListener(IWorldState& world, WorldEvent interest = WorldEvent::All);
 		AutoWorldEventListener(const AutoWorldEventListener& other);
 		AutoWorldEventListener& operator=(const AutoWorldEventListener& other);
 		AutoWorldEventListener(AutoWorldEventListener&& other);
@@ -46,5 +89,6 @@ namespace tf2_bot_detector
 
 	private:
 		IWorldState* m_World = nullptr;
+		WorldEvent m_Interest = WorldEvent::All;
 	};
 }
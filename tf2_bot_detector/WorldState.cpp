@@ -3,20 +3,25 @@
 #include "Config/Settings.h"
 #include "ConsoleLog/ConsoleLineListener.h"
 #include "ConsoleLog/ConsoleLines.h"
+#include "ConsoleLog/ConsoleLogBulkParser.h"
 #include "ConsoleLog/ConsoleLogParser.h"
+#include "ConsoleLog/ServerStatusBlock.h"
 #include "GameData/TFClassType.h"
 #include "GameData/UserMessageType.h"
 #include "Networking/HTTPHelpers.h"
 #include "Networking/SteamAPI.h"
 #include "Networking/SteamHistoryAPI.h"
 #include "Networking/LogsTFAPI.h"
+#include "Util/ListenerList.h"
 #include "Util/RegexUtils.h"
 #include "Util/TextUtils.h"
 #include "BatchedAction.h"
 #include "GenericErrors.h"
 #include "IPlayer.h"
 #include "Log.h"
+#include "PlayerCacheEviction.h"
 #include "WorldEventListener.h"
+#include "WorldStateIndices.h"
 #include "Config/AccountAges.h"
 #include "GlobalDispatcher.h"
 #include "Application.h"
@@ -30,6 +35,9 @@
 #include <mh/future.hpp>
 #include <mh/coroutine/future.hpp>
 
+#include <array>
+#include <bit>
+
 #undef GetCurrentTime
 #undef max
 #undef min
@@ -43,6 +51,12 @@ namespace
 {
 	class Player;
 
+	size_t GetWorldEventIndex(WorldEvent event)
+	{
+		assert(std::has_single_bit(std::underlying_type_t<WorldEvent>(event)));
+		return std::countr_zero(std::underlying_type_t<WorldEvent>(event));
+	}
+
 	class WorldState final : public IWorldState, BaseConsoleLineListener
 	{
 	public:
@@ -58,9 +72,9 @@ namespace
 		void Update() override;
 		void UpdateTimestamp(const ConsoleLogParser& parser);
 
-		void AddWorldEventListener(IWorldEventListener* listener) override;
+		void AddWorldEventListener(IWorldEventListener* listener, WorldEvent interest) override;
 		void RemoveWorldEventListener(IWorldEventListener* listener) override;
-		void AddConsoleLineListener(IConsoleLineListener* listener) override;
+		void AddConsoleLineListener(IConsoleLineListener* listener, ConsoleLineTypeMask interest) override;
 		void RemoveConsoleLineListener(IConsoleLineListener* listener) override;
 
 		void AddConsoleOutputChunk(const std::string_view& chunk) override;
@@ -69,6 +83,7 @@ namespace
 		std::optional<SteamID> FindSteamIDForName(const std::string_view& playerName) const override;
 		std::optional<LobbyMemberTeam> FindLobbyMemberTeam(const SteamID& id) const override;
 		std::optional<UserID_t> FindUserID(const SteamID& id) const override;
+		const IPlayer* FindPlayerByUserID(UserID_t userID) const override;
 
 		TeamShareResult GetTeamShareResult(const SteamID& id) const override;
 		TeamShareResult GetTeamShareResult(const SteamID& id0, const SteamID& id1) const override;
@@ -79,8 +94,9 @@ namespace
 		using IWorldState::FindPlayer;
 		const IPlayer* FindPlayer(const SteamID& id) const override;
 
-		mh::generator<const IPlayer&> GetLobbyMembers() const;
-		mh::generator<const IPlayer&> GetPlayers() const;
+		PlayerRange<const IPlayer> GetLobbyMembers() const override;
+		PlayerRange<const IPlayer> GetPlayers() const override;
+		uint64_t GetLobbyGeneration() const override { return m_LobbyGeneration; }
 		std::vector<const IPlayer*> GetRecentPlayers(size_t recentPlayerCount = 32) const;
 		std::vector<IPlayer*> GetRecentPlayers(size_t recentPlayerCount = 32);
 
@@ -102,6 +118,11 @@ namespace
 		IAccountAges& GetAccountAges() { return *m_AccountAges; }
 		const IAccountAges& GetAccountAges() const override { return *m_AccountAges; }
 
+		const PlayerCacheStats& GetPlayerCacheStats() const override { return m_PlayerCacheStats; }
+		const StatusUpdateStats& GetStatusUpdateStats() const override { return m_StatusUpdateStats; }
+		const ConsoleLineCoalescerStats& GetConsoleLineCoalescerStats() const override { return m_LineCoalescer.GetStats(); }
+		ExternalDataStats GetExternalDataStats() const override;
+
 	protected:
 		virtual IConsoleLineListener& GetConsoleLineListenerBroadcaster() { return m_ConsoleLineListenerBroadcaster; }
 
@@ -111,8 +132,15 @@ namespace
 		CompensatedTS m_CurrentTimestamp;
 
 		void OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed) override;
+		void OnConsoleLogCaughtUp(IWorldState& world) override;
 		void OnConfigExecLineParsed(const ConfigExecLine& execLine);
 
+		ServerStatusBlockAssembler m_StatusBlockAssembler;
+		void OnServerStatusBlock(const ServerStatusBlock& block);
+		std::vector<SteamID> m_LastStatusBlockPlayers;  // Sorted
+		StatusUpdateStats m_StatusUpdateStats;
+		mh::task<> ParseConsoleOutputChunk(ConsoleTextSlab chunk, time_point_t timestamp);
+
 		void UpdateFriends();
 		mh::task<std::unordered_set<SteamID>> m_FriendsFuture;
 		std::unordered_set<SteamID> m_Friends;
@@ -120,6 +148,33 @@ namespace
 
 		Player& FindOrCreatePlayer(const SteamID& id);
 
+		// Players who left a while ago are evicted once everyone together takes up more than
+		// Settings::m_PlayerCacheMemoryLimitMB. Anything we had fetched for them is spilled to
+		// the temp DB, and read back if they return.
+		static constexpr duration_t PLAYER_EVICTION_INTERVAL = 10s;
+		static constexpr duration_t PLAYER_EVICTION_MIN_ABSENCE = 2min;
+		void EvictPlayers();
+		std::unordered_set<SteamID> m_SpilledPlayers;
+		time_point_t m_LastPlayerEviction{};
+		PlayerCacheStats m_PlayerCacheStats;
+
+		// Flat lists of player pointers behind GetLobbyMembers()/GetPlayers(), rebuilt the next
+		// time they're asked for after lobby membership or the set of players changes.
+		// m_SnapshotGeneration changes at the same time, so older PlayerRanges know they are stale.
+		void OnLobbyChanged();
+		void OnPlayerDataChanged() { m_LobbyGeneration++; }
+		void UpdateSnapshots() const;
+		mutable std::vector<IPlayer*> m_LobbySnapshot;
+		mutable std::vector<IPlayer*> m_PlayersSnapshot;
+		mutable bool m_SnapshotsDirty = true;
+		uint64_t m_SnapshotGeneration = 0;
+		uint64_t m_LobbyGeneration = 0;
+
+		friend class Player;
+		void OnPlayerStatusChanged(const Player& player, const PlayerStatus& oldStatus, PlayerStatusChange changes);
+		void SetLobbyMember(const LobbyMember& member);
+		void ClearLobbyState();
+
 		struct PlayerSummaryUpdateAction final :
 			BatchedAction<WorldState*, SteamID, std::vector<SteamAPI::PlayerSummary>>
 		{
@@ -128,6 +183,7 @@ namespace
 			response_future_type SendRequest(WorldState*& state, queue_collection_type& collection) override;
 			void OnDataReady(WorldState*& state, const response_type& response,
 				queue_collection_type& collection) override;
+			void OnGaveUp(WorldState*& state, const SteamID& steamID) override;
 		} m_PlayerSummaryUpdates;
 
 		struct PlayerBansUpdateAction final :
@@ -138,6 +194,7 @@ namespace
 			response_future_type SendRequest(state_type& state, queue_collection_type& collection) override;
 			void OnDataReady(state_type& state, const response_type& response,
 				queue_collection_type& collection) override;
+			void OnGaveUp(state_type& state, const SteamID& steamID) override;
 		} m_PlayerBansUpdates;
 
 		struct PlayerSourceBansUpdateAction final :
@@ -148,11 +205,15 @@ namespace
 			response_future_type SendRequest(state_type& state, queue_collection_type& collection) override;
 			void OnDataReady(state_type& state, const response_type& response,
 				queue_collection_type& collection) override;
+			void OnGaveUp(state_type& state, const SteamID& steamID) override;
 		} m_PlayerSourceBansUpdates;
 
 		std::vector<LobbyMember> m_CurrentLobbyMembers;
 		std::vector<LobbyMember> m_PendingLobbyMembers;
 		std::unordered_map<SteamID, std::shared_ptr<Player>> m_CurrentPlayerData;
+		PlayerNameIndex m_PlayerNames;
+		UserIDIndex m_PlayerUserIDs;
+		LobbyMemberTeamIndex m_LobbyMemberTeams;
 		bool m_IsLocalPlayerInitialized = false;
 		bool m_IsVoteInProgress = false;
 
@@ -160,8 +221,13 @@ namespace
 
 		time_point_t m_LastStatusUpdateTime{};
 
-		std::unordered_set<IConsoleLineListener*> m_ConsoleLineListeners;
-		std::unordered_set<IWorldEventListener*> m_EventListeners;
+		// Everyone in the order they were added, and just the ones interested in each line type/event
+		ListenerList<IConsoleLineListener> m_ConsoleLineListeners;
+		std::array<ListenerList<IConsoleLineListener>, CONSOLE_LINE_TYPE_COUNT> m_ConsoleLineListenersByType;
+		ListenerList<IWorldEventListener> m_EventListeners;
+		std::array<ListenerList<IWorldEventListener>, WORLD_EVENT_COUNT> m_EventListenersByType;
+
+		ConsoleLineCoalescer m_LineCoalescer;
 
 		mh::thread_pool m_ConsoleLineParsingPool{ 1 };
 		std::vector<mh::shared_future<std::shared_ptr<IConsoleLine>>> m_ConsoleLineParsingTasks;
@@ -172,28 +238,52 @@ namespace
 
 			void OnConsoleLineParsed(IWorldState& world, IConsoleLine& line) override
 			{
-				for (IConsoleLineListener* l : m_World.m_ConsoleLineListeners)
-					l->OnConsoleLineParsed(world, line);
+				const auto Dispatch = [&](IConsoleLine& l) { DispatchParsed(world, l); };
+				if (!m_World.m_Settings.m_Unsaved.m_CoalesceConsoleLines)
+					m_World.m_LineCoalescer.Flush(Dispatch);
+				else if (m_World.m_LineCoalescer.AddLine(line, Dispatch))
+					return;
+
+				DispatchParsed(world, line);
 			}
 			void OnConsoleLineUnparsed(IWorldState& world, const std::string_view& text) override
 			{
-				for (IConsoleLineListener* l : m_World.m_ConsoleLineListeners)
-					l->OnConsoleLineUnparsed(world, text);
+				m_World.m_ConsoleLineListeners.ForEach(
+					[&](IConsoleLineListener& l) { l.OnConsoleLineUnparsed(world, text); });
 			}
 			void OnConsoleLogChunkParsed(IWorldState& world, bool consoleLinesParsed) override
 			{
-				for (IConsoleLineListener* l : m_World.m_ConsoleLineListeners)
-					l->OnConsoleLogChunkParsed(world, consoleLinesParsed);
+				FlushCoalescedLines(world);
+				m_World.m_ConsoleLineListeners.ForEach(
+					[&](IConsoleLineListener& l) { l.OnConsoleLogChunkParsed(world, consoleLinesParsed); });
+			}
+			void OnConsoleLogCaughtUp(IWorldState& world) override
+			{
+				FlushCoalescedLines(world);
+				m_World.m_ConsoleLineListeners.ForEach(
+					[&](IConsoleLineListener& l) { l.OnConsoleLogCaughtUp(world); });
+			}
+
+			// Summaries shouldn't be held back waiting for the next tick once there's nothing left to read
+			void FlushCoalescedLines(IWorldState& world)
+			{
+				m_World.m_LineCoalescer.Flush([&](IConsoleLine& l) { DispatchParsed(world, l); });
+			}
+
+			void DispatchParsed(IWorldState& world, IConsoleLine& line)
+			{
+				m_World.m_ConsoleLineListenersByType[size_t(line.GetType())].ForEach(
+					[&](IConsoleLineListener& l) { l.OnConsoleLineParsed(world, line); });
 			}
 
 			WorldState& m_World;
 
 		} m_ConsoleLineListenerBroadcaster;
 		template<typename TRet, typename... TArgs, typename... TArgs2>
-		inline void InvokeEventListener(TRet(IWorldEventListener::* func)(TArgs... args), TArgs2&&... args)
+		inline void InvokeEventListener(WorldEvent event, TRet(IWorldEventListener::* func)(TArgs... args), TArgs2&&... args)
 		{
-			for (IWorldEventListener* listener : m_EventListeners)
-				(listener->*func)(std::forward<TArgs2>(args)...);
+			m_EventListenersByType[GetWorldEventIndex(event)].ForEach(
+				[&](IWorldEventListener& listener) { (listener.*func)(args...); });
 		}
 	};
 
@@ -240,15 +330,27 @@ namespace
 		mutable mh::expected<SteamHistoryAPI::PlayerSourceBans> m_PlayerSourceBans = ErrorCode::LazyValueUninitialized;
 		mutable mh::expected<SteamHistoryAPI::PlayerSourceBanState> m_PlayerSourceBanState = ErrorCode::LazyValueUninitialized;
 
+		// When the data above was fetched (or when the fetch we rehydrated it from happened), so
+		// spilling it to the temp DB doesn't make it look fresher than it is
+		time_point_t m_PlayerSummaryFetchTime{};
+		time_point_t m_PlayerSteamBansFetchTime{};
+
 		void SetStatus(PlayerStatus status, time_point_t timestamp);
 		const PlayerStatus& GetStatus() const { return m_Status; }
 
+		// Everything that changed since this was last called, see WorldState::OnServerStatusBlock()
+		PlayerStatusChange TakeStatusChanges() { return std::exchange(m_UnreportedStatusChanges, PlayerStatusChange::None); }
+
 		void SetPing(uint16_t ping, time_point_t timestamp);
 
+		size_t GetApproxMemoryUsage() const;
+		bool IsFetchPending() const;
+		bool SpillTo(DB::ITempDB& db) const;
+		bool RehydrateFrom(const DB::ITempDB& db);
+
 	protected:
-		std::map<std::type_index, std::any> m_UserData;
-		const std::any* FindDataStorage(const std::type_index& type) const override;
-		std::any& GetOrCreateDataStorage(const std::type_index& type) override;
+		PlayerDataStorage m_UserData;
+		const PlayerDataStorage& GetDataStorage() const override { return m_UserData; }
 
 		std::shared_ptr<Player> shared_from_this() { return std::static_pointer_cast<Player>(IPlayer::shared_from_this()); }
 		std::shared_ptr<const Player> shared_from_this() const { return std::static_pointer_cast<const Player>(IPlayer::shared_from_this()); }
@@ -262,6 +364,7 @@ namespace
 
 		WorldState* m_World = nullptr;
 		PlayerStatus m_Status{};
+		PlayerStatusChange m_UnreportedStatusChanges = PlayerStatusChange::None;
 
 		time_point_t m_LastStatusActiveBegin{};
 
@@ -271,6 +374,7 @@ namespace
 		mutable mh::expected<duration_t> m_TF2Playtime = ErrorCode::LazyValueUninitialized;
 		mutable mh::expected<LogsTFAPI::PlayerLogsInfo> m_LogsInfo = ErrorCode::LazyValueUninitialized;
 		mutable mh::expected<SteamAPI::PlayerFriends> m_FriendsInfo = ErrorCode::LazyValueUninitialized;
+		mutable time_point_t m_FriendsInfoFetchTime{};
 		mutable mh::expected<SteamAPI::PlayerInventoryInfo> m_InventoryInfo = ErrorCode::LazyValueUninitialized;
 	};
 }
@@ -287,7 +391,7 @@ WorldState::WorldState(const Settings& settings) :
 	m_PlayerSourceBansUpdates(this),
 	m_ConsoleLineListenerBroadcaster(*this)
 {
-	AddConsoleLineListener(this);
+	AddConsoleLineListener(this, ConsoleLineTypeMask::All());
 }
 
 WorldState::~WorldState()
@@ -302,6 +406,12 @@ void WorldState::Update()
 	m_PlayerSourceBansUpdates.Update();
 
 	UpdateFriends();
+
+	if (const auto now = tfbd_clock_t::now(); (now - m_LastPlayerEviction) >= PLAYER_EVICTION_INTERVAL)
+	{
+		m_LastPlayerEviction = now;
+		EvictPlayers();
+	}
 }
 
 void WorldState::UpdateFriends()
@@ -354,27 +464,78 @@ void WorldState::UpdateFriends()
 	}
 }
 
-void WorldState::AddConsoleLineListener(IConsoleLineListener* listener)
+void WorldState::AddConsoleLineListener(IConsoleLineListener* listener, ConsoleLineTypeMask interest)
 {
-	m_ConsoleLineListeners.insert(listener);
+	if (m_ConsoleLineListeners.Contains(listener))
+		return;
+
+	m_ConsoleLineListeners.Add(listener);
+	for (size_t i = 0; i < CONSOLE_LINE_TYPE_COUNT; i++)
+	{
+		if (interest.Contains(ConsoleLineType(i)))
+			m_ConsoleLineListenersByType[i].Add(listener);
+	}
 }
 
 void WorldState::RemoveConsoleLineListener(IConsoleLineListener* listener)
 {
-	m_ConsoleLineListeners.erase(listener);
+	m_ConsoleLineListeners.Remove(listener);
+	for (auto& listeners : m_ConsoleLineListenersByType)
+		listeners.Remove(listener);
 }
 
 void WorldState::AddConsoleOutputChunk(const std::string_view& chunk)
 {
+	if (!chunk.empty())
+		ParseConsoleOutputChunk(std::make_shared<std::string>(chunk), GetCurrentTime());
+}
+
+mh::task<> WorldState::ParseConsoleOutputChunk(ConsoleTextSlab chunk, time_point_t timestamp)
+{
+	auto worldState = shared_from_this();
+
+	// The whole chunk makes one trip to the parsing thread and back, instead of every line
+	// making its own. Goes through the same (single threaded) queues as AddConsoleOutputLine(),
+	// so everything still comes out in the order it was added.
+	co_await m_ConsoleLineParsingPool.co_add_task();
+
+	std::vector<PreparsedConsoleLine> lines;
+	const std::string_view text(*chunk);
 	size_t last = 0;
-	for (auto i = chunk.find('\n', 0); i != chunk.npos; i = chunk.find('\n', last))
+	for (auto i = text.find('\n', 0); i != text.npos; i = text.find('\n', last))
 	{
-		auto line = chunk.substr(last, i - last);
-		AddConsoleOutputLine(std::string(line));
+		PreparsedConsoleLine& line = lines.emplace_back();
+		line.m_Timestamp = timestamp;
+		line.m_Text = text.substr(last, i - last);
+		line.m_Parsed = IConsoleLine::ParseConsoleLineStateless(line.m_Text, timestamp, *this,
+			line.m_NeedsWorldState, &chunk);
+
 		last = i + 1;
 	}
+
+	// switch to main thread
+	co_await GetDispatcher().co_dispatch();
+
+	for (PreparsedConsoleLine& line : lines)
+	{
+		// Anything that depends on the world state has to see it as of the lines before it
+		if (line.m_NeedsWorldState)
+			line.m_Parsed = IConsoleLine::ParseConsoleLine(line.m_Text, timestamp, *this, &chunk);
+
+		if (line.m_Parsed)
+			m_ConsoleLineListenerBroadcaster.OnConsoleLineParsed(*worldState, *line.m_Parsed);
+		else
+			m_ConsoleLineListenerBroadcaster.OnConsoleLineUnparsed(*worldState, line.m_Text);
+
+		line.m_Parsed.reset();
+	}
+
+	m_ConsoleLineListenerBroadcaster.FlushCoalescedLines(*worldState);
+	if (auto block = m_StatusBlockAssembler.Flush())
+		OnServerStatusBlock(*block);
 }
 
+
 mh::task<> WorldState::AddConsoleOutputLine(std::string line)
 {
 	auto worldState = shared_from_this();
@@ -388,15 +549,11 @@ mh::task<> WorldState::AddConsoleOutputLine(std::string line)
 	co_await GetDispatcher().co_dispatch();
 
 	if (parsed)
-	{
-		for (auto listener : m_ConsoleLineListeners)
-			listener->OnConsoleLineParsed(*worldState, *parsed);
-	}
+		m_ConsoleLineListenerBroadcaster.OnConsoleLineParsed(*worldState, *parsed);
 	else
-	{
-		for (auto listener : m_ConsoleLineListeners)
-			listener->OnConsoleLineUnparsed(*worldState, std::move(line));
-	}
+		m_ConsoleLineListenerBroadcaster.OnConsoleLineUnparsed(*worldState, line);
+
+	m_ConsoleLineListenerBroadcaster.FlushCoalescedLines(*worldState);
 }
 
 void WorldState::UpdateTimestamp(const ConsoleLogParser& parser)
@@ -404,14 +561,24 @@ void WorldState::UpdateTimestamp(const ConsoleLogParser& parser)
 	m_CurrentTimestamp = parser.GetCurrentTimestamp();
 }
 
-void WorldState::AddWorldEventListener(IWorldEventListener* listener)
+void WorldState::AddWorldEventListener(IWorldEventListener* listener, WorldEvent interest)
 {
-	m_EventListeners.insert(listener);
+	if (m_EventListeners.Contains(listener))
+		return;
+
+	m_EventListeners.Add(listener);
+	for (size_t i = 0; i < WORLD_EVENT_COUNT; i++)
+	{
+		if (interest & WorldEvent(1 << i))
+			m_EventListenersByType[i].Add(listener);
+	}
 }
 
 void WorldState::RemoveWorldEventListener(IWorldEventListener* listener)
 {
-	m_EventListeners.erase(listener);
+	m_EventListeners.Remove(listener);
+	for (auto& listeners : m_EventListenersByType)
+		listeners.Remove(listener);
 }
 
 std::optional<SteamID> WorldState::FindSteamIDForName(const std::string_view& playerName) const
@@ -419,12 +586,13 @@ std::optional<SteamID> WorldState::FindSteamIDForName(const std::string_view& pl
 	std::optional<SteamID> retVal;
 	time_point_t lastUpdated{};
 
-	for (const auto& data : m_CurrentPlayerData)
+	// If more than one player goes by this name, the one we heard from most recently wins
+	for (const SteamID& id : m_PlayerNames.Find(playerName))
 	{
-		if (data.second->GetStatus().m_Name == playerName && data.second->GetLastStatusUpdateTime() > lastUpdated)
+		if (auto player = FindPlayer(id); player && player->GetLastStatusUpdateTime() > lastUpdated)
 		{
-			retVal = data.second->GetSteamID();
-			lastUpdated = data.second->GetLastStatusUpdateTime();
+			retVal = id;
+			lastUpdated = player->GetLastStatusUpdateTime();
 		}
 	}
 
@@ -433,30 +601,89 @@ std::optional<SteamID> WorldState::FindSteamIDForName(const std::string_view& pl
 
 std::optional<LobbyMemberTeam> WorldState::FindLobbyMemberTeam(const SteamID& id) const
 {
-	for (const auto& member : m_CurrentLobbyMembers)
+	return m_LobbyMemberTeams.Find(id);
+}
+
+std::optional<UserID_t> WorldState::FindUserID(const SteamID& id) const
+{
+	if (auto player = FindPlayer(id))
+		return player->GetUserID();
+
+	return std::nullopt;
+}
+
+const IPlayer* WorldState::FindPlayerByUserID(UserID_t userID) const
+{
+	if (auto id = m_PlayerUserIDs.Find(userID))
+		return FindPlayer(*id);
+
+	return nullptr;
+}
+
+void WorldState::OnPlayerStatusChanged(const Player& player, const PlayerStatus& oldStatus, PlayerStatusChange changes)
+{
+	m_StatusUpdateStats.m_Rows++;
+	if (changes == PlayerStatusChange::None)
 	{
-		if (member.m_SteamID == id)
-			return member.m_Team;
+		m_StatusUpdateStats.m_UnchangedRows++;
+		return;
+	}
+	else if (changes == PlayerStatusChange::Ping)
+	{
+		m_StatusUpdateStats.m_PingOnlyRows++;
+		return;
 	}
 
-	for (const auto& member : m_PendingLobbyMembers)
+	const PlayerStatus& newStatus = player.GetStatus();
+	if (changes & PlayerStatusChange::Name)
 	{
-		if (member.m_SteamID == id)
-			return member.m_Team;
+		m_StatusUpdateStats.m_NameChanges++;
+		m_PlayerNames.Rename(player.GetSteamID(), oldStatus.m_Name, newStatus.m_Name);
 	}
 
-	return std::nullopt;
-}
+	if (changes & PlayerStatusChange::State)
+		m_StatusUpdateStats.m_StateChanges++;
 
-std::optional<UserID_t> WorldState::FindUserID(const SteamID& id) const
-{
-	for (const auto& player : m_CurrentPlayerData)
+	if (changes & PlayerStatusChange::Connection)
 	{
-		if (player.second->GetSteamID() == id)
-			return player.second->GetUserID();
+		m_StatusUpdateStats.m_Reconnects++;
+
+		const auto ToUserID = [](const PlayerStatus& status) -> std::optional<UserID_t>
+		{
+			if (status.m_UserID > 0)
+				return status.m_UserID;
+
+			return std::nullopt;
+		};
+		m_PlayerUserIDs.Update(player.GetSteamID(), ToUserID(oldStatus), ToUserID(newStatus));
 	}
 
-	return std::nullopt;
+	OnPlayerDataChanged();
+}
+
+void WorldState::SetLobbyMember(const LobbyMember& member)
+{
+	auto& vec = member.m_Pending ? m_PendingLobbyMembers : m_CurrentLobbyMembers;
+	if (member.m_Index >= vec.size() || vec[member.m_Index] == member)
+		return;
+
+	const SteamID oldID = std::exchange(vec[member.m_Index], member).m_SteamID;
+	m_LobbyMemberTeams.Refresh(oldID, m_CurrentLobbyMembers, m_PendingLobbyMembers);
+	m_LobbyMemberTeams.Refresh(member.m_SteamID, m_CurrentLobbyMembers, m_PendingLobbyMembers);
+	OnLobbyChanged();
+}
+
+void WorldState::ClearLobbyState()
+{
+	m_CurrentLobbyMembers.clear();
+	m_PendingLobbyMembers.clear();
+	m_CurrentPlayerData.clear();
+	m_PlayerCacheStats.m_Players = 0;
+
+	m_PlayerNames.clear();
+	m_PlayerUserIDs.clear();
+	m_LobbyMemberTeams.clear();
+	OnLobbyChanged();
 }
 
 TeamShareResult WorldState::GetTeamShareResult(const SteamID& id) const
@@ -499,54 +726,67 @@ size_t WorldState::GetApproxLobbyMemberCount() const
 	return m_CurrentLobbyMembers.size() + m_PendingLobbyMembers.size();
 }
 
-mh::generator<const IPlayer&> WorldState::GetLobbyMembers() const
+void WorldState::OnLobbyChanged()
 {
-	const auto GetPlayer = [&](const LobbyMember& member) -> const IPlayer*
-	{
-		assert(member != LobbyMember{});
-		assert(member.m_SteamID.IsValid());
+	m_SnapshotsDirty = true;
+	m_SnapshotGeneration++;
+	m_LobbyGeneration++;
+}
 
-		if (auto found = m_CurrentPlayerData.find(member.m_SteamID); found != m_CurrentPlayerData.end())
-		{
-			[[maybe_unused]] const LobbyMember* testMember = found->second->GetLobbyMember();
-			//assert(*testMember == member);
+void WorldState::UpdateSnapshots() const
+{
+	if (!m_SnapshotsDirty)
+		return;
+
+	const auto GetPlayer = [&](const SteamID& id) -> IPlayer*
+	{
+		if (auto found = m_CurrentPlayerData.find(id); found != m_CurrentPlayerData.end())
 			return found->second.get();
-		}
-		else
-		{
-			throw std::runtime_error("Missing player for lobby member!");
-		}
+
+		throw std::runtime_error("Missing player for lobby member!");
 	};
 
+	m_LobbySnapshot.clear();
 	for (const auto& member : m_CurrentLobbyMembers)
 	{
-		if (!member.IsValid())
-			continue;
-
-		if (auto found = GetPlayer(member))
-			co_yield *found;
+		if (member.IsValid())
+			m_LobbySnapshot.push_back(GetPlayer(member.m_SteamID));
 	}
+
+	const size_t currentMemberCount = m_LobbySnapshot.size();
 	for (const auto& member : m_PendingLobbyMembers)
 	{
 		if (!member.IsValid())
 			continue;
 
-		if (std::any_of(m_CurrentLobbyMembers.begin(), m_CurrentLobbyMembers.end(),
-			[&](const LobbyMember& member2) { return member.m_SteamID == member2.m_SteamID; }))
+		// Don't return two different instances with the same steamid. This only runs when the
+		// lobby changes, so a scan of the current members is fine.
+		IPlayer* player = GetPlayer(member.m_SteamID);
+		if (std::find(m_LobbySnapshot.begin(), m_LobbySnapshot.begin() + currentMemberCount, player) ==
+			m_LobbySnapshot.begin() + currentMemberCount)
 		{
-			// Don't return two different instances with the same steamid.
-			continue;
+			m_LobbySnapshot.push_back(player);
 		}
-
-		if (auto found = GetPlayer(member))
-			co_yield *found;
 	}
+
+	m_PlayersSnapshot.clear();
+	m_PlayersSnapshot.reserve(m_CurrentPlayerData.size());
+	for (const auto& [id, player] : m_CurrentPlayerData)
+		m_PlayersSnapshot.push_back(player.get());
+
+	m_SnapshotsDirty = false;
+}
+
+PlayerRange<const IPlayer> WorldState::GetLobbyMembers() const
+{
+	UpdateSnapshots();
+	return PlayerRange<const IPlayer>(m_LobbySnapshot, &m_SnapshotGeneration);
 }
 
-mh::generator<const IPlayer&> WorldState::GetPlayers() const
+PlayerRange<const IPlayer> WorldState::GetPlayers() const
 {
-	for (const auto& pair : m_CurrentPlayerData)
-		co_yield *pair.second;
+	UpdateSnapshots();
+	return PlayerRange<const IPlayer>(m_PlayersSnapshot, &m_SnapshotGeneration);
 }
 
 void WorldState::QueuePlayerSummaryUpdate(const SteamID& id)
@@ -564,6 +804,16 @@ void WorldState::QueuePlayerSourceBansUpdate(const SteamID& id)
 	return m_PlayerSourceBansUpdates.Queue(id);
 }
 
+ExternalDataStats WorldState::GetExternalDataStats() const
+{
+	return ExternalDataStats
+	{
+		.m_PlayerSummaries = m_PlayerSummaryUpdates.GetStats(),
+		.m_PlayerBans = m_PlayerBansUpdates.GetStats(),
+		.m_SourceBans = m_PlayerSourceBansUpdates.GetStats(),
+	};
+}
+
 template<typename TMap>
 static auto GetRecentPlayersImpl(TMap&& map, size_t recentPlayerCount)
 {
@@ -595,6 +845,51 @@ std::vector<IPlayer*> WorldState::GetRecentPlayers(size_t recentPlayerCount)
 	return GetRecentPlayersImpl(m_CurrentPlayerData, recentPlayerCount);
 }
 
+void WorldState::OnConsoleLogCaughtUp(IWorldState& world)
+{
+	assert(&world == this);
+
+	// Not on OnConsoleLogChunkParsed(), a chunk can end in the middle of a `status` dump
+	if (auto block = m_StatusBlockAssembler.Flush())
+		OnServerStatusBlock(*block);
+}
+
+void WorldState::OnServerStatusBlock(const ServerStatusBlock& block)
+{
+	ServerStatusSnapshot snapshot;
+	snapshot.m_HasHeader = block.m_HasHeader;
+	snapshot.m_Timestamp = block.m_Timestamp;
+	snapshot.m_Players.reserve(block.m_Players.size());
+
+	bool anyChanges = false;
+	for (const SteamID& id : block.m_Players)
+	{
+		if (auto found = m_CurrentPlayerData.find(id); found != m_CurrentPlayerData.end())
+		{
+			const PlayerStatusChange changes = found->second->TakeStatusChanges();
+			anyChanges |= (changes != PlayerStatusChange::None && changes != PlayerStatusChange::Ping);
+			snapshot.m_Players.push_back({ found->second.get(), changes });
+		}
+	}
+
+	// Players who stopped showing up in `status` can drop out of anything built from the
+	// most recent dump, even though none of the rows that are left changed
+	std::vector<SteamID> players = block.m_Players;
+	std::sort(players.begin(), players.end());
+	if (players != m_LastStatusBlockPlayers)
+	{
+		m_LastStatusBlockPlayers = std::move(players);
+		OnPlayerDataChanged();
+	}
+	else if (!anyChanges)
+	{
+		m_StatusUpdateStats.m_UnchangedSnapshots++;
+	}
+
+	m_StatusUpdateStats.m_Snapshots++;
+	InvokeEventListener(WorldEvent::ServerStatusSnapshot, &IWorldEventListener::OnServerStatusSnapshot, *this, snapshot);
+}
+
 void WorldState::OnConfigExecLineParsed(const ConfigExecLine& execLine)
 {
 	const std::string_view& cfgName = execLine.GetConfigFileName();
@@ -630,12 +925,12 @@ void WorldState::OnConfigExecLineParsed(const ConfigExecLine& execLine)
 		else if (cfgName.starts_with("engineer"))
 			cl = TFClassType::Engie;
 
-		InvokeEventListener(&IWorldEventListener::OnLocalPlayerSpawned, *this, cl);
+		InvokeEventListener(WorldEvent::LocalPlayerSpawned, &IWorldEventListener::OnLocalPlayerSpawned, *this, cl);
 
 		if (!m_IsLocalPlayerInitialized)
 		{
 			m_IsLocalPlayerInitialized = true;
-			InvokeEventListener(&IWorldEventListener::OnLocalPlayerInitialized, *this, m_IsLocalPlayerInitialized);
+			InvokeEventListener(WorldEvent::LocalPlayerInitialized, &IWorldEventListener::OnLocalPlayerInitialized, *this, m_IsLocalPlayerInitialized);
 		}
 	}
 }
@@ -644,20 +939,34 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 {
 	assert(&world == this);
 
-	const auto ClearLobbyState = [&]
-	{
-		m_CurrentLobbyMembers.clear();
-		m_PendingLobbyMembers.clear();
-		m_CurrentPlayerData.clear();
-	};
+	if (auto block = m_StatusBlockAssembler.AddLine(parsed))
+		OnServerStatusBlock(*block);
 
 	switch (parsed.GetType())
 	{
 	case ConsoleLineType::LobbyHeader:
 	{
 		auto& headerLine = static_cast<const LobbyHeaderLine&>(parsed);
-		m_CurrentLobbyMembers.resize(headerLine.GetMemberCount());
-		m_PendingLobbyMembers.resize(headerLine.GetPendingCount());
+		const auto Resize = [&](std::vector<LobbyMember>& vec, size_t newSize)
+		{
+			if (newSize == vec.size())
+				return;
+
+			OnLobbyChanged();
+			if (newSize > vec.size())
+			{
+				vec.resize(newSize);
+				return;
+			}
+
+			std::vector<LobbyMember> removed(vec.begin() + newSize, vec.end());
+			vec.resize(newSize);
+			for (const auto& member : removed)
+				m_LobbyMemberTeams.Refresh(member.m_SteamID, m_CurrentLobbyMembers, m_PendingLobbyMembers);
+		};
+
+		Resize(m_CurrentLobbyMembers, headerLine.GetMemberCount());
+		Resize(m_PendingLobbyMembers, headerLine.GetPendingCount());
 		break;
 	}
 	case ConsoleLineType::LobbyStatusFailed:
@@ -698,7 +1007,7 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 		if (m_IsLocalPlayerInitialized)
 		{
 			m_IsLocalPlayerInitialized = false;
-			InvokeEventListener(&IWorldEventListener::OnLocalPlayerInitialized, *this, m_IsLocalPlayerInitialized);
+			InvokeEventListener(WorldEvent::LocalPlayerInitialized, &IWorldEventListener::OnLocalPlayerInitialized, *this, m_IsLocalPlayerInitialized);
 		}
 
 		m_IsVoteInProgress = false;
@@ -712,7 +1021,7 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 			DebugLog("Chat message from {}: {}", *sid, std::quoted(chatLine.GetMessage()));
 			if (auto player = FindPlayer(*sid))
 			{
-				InvokeEventListener(&IWorldEventListener::OnChatMsg, *this, *player, chatLine.GetMessage());
+				InvokeEventListener(WorldEvent::ChatMsg, &IWorldEventListener::OnChatMsg, *this, *player, chatLine.GetMessage());
 			}
 			else
 			{
@@ -760,7 +1069,7 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 		{
 			if (auto player = FindPlayer(*sid))
 			{
-				InvokeEventListener(&IWorldEventListener::OnPlayerDroppedFromServer,
+				InvokeEventListener(WorldEvent::PlayerDroppedFromServer, &IWorldEventListener::OnPlayerDroppedFromServer,
 					*this, *player, dropLine.GetReason());
 			}
 			else
@@ -808,12 +1117,11 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 	{
 		auto& memberLine = static_cast<const LobbyMemberLine&>(parsed);
 		const auto& member = memberLine.GetLobbyMember();
-		auto& vec = member.m_Pending ? m_PendingLobbyMembers : m_CurrentLobbyMembers;
-		if (member.m_Index < vec.size())
-			vec[member.m_Index] = member;
+		SetLobbyMember(member);
 
 		const TFTeam tfTeam = member.m_Team == LobbyMemberTeam::Defenders ? TFTeam::Red : TFTeam::Blue;
-		FindOrCreatePlayer(member.m_SteamID).m_Team = tfTeam;
+		if (std::exchange(FindOrCreatePlayer(member.m_SteamID).m_Team, tfTeam) != tfTeam)
+			OnPlayerDataChanged();
 
 		break;
 	}
@@ -844,8 +1152,8 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 		assert(playerData.GetStatus().m_SteamID == newStatus.m_SteamID);
 		playerData.SetStatus(newStatus, statusLine.GetTimestamp());
 		m_LastStatusUpdateTime = std::max(m_LastStatusUpdateTime, playerData.GetLastStatusUpdateTime());
-		InvokeEventListener(&IWorldEventListener::OnPlayerStatusUpdate, *this, playerData);
 
+		// Listeners hear about this once the whole status block is in, see OnServerStatusBlock()
 		break;
 	}
 	case ConsoleLineType::PlayerStatusShort:
@@ -893,6 +1201,9 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 			killLogStream << "<" << victim.GetSteamID().ID64 << "> " << victim.GetNameSafe();
 		}
 
+		if (attackerSteamID || victimSteamID)
+			OnPlayerDataChanged();
+
 		killLogStream << " // " << killLine.GetWeaponName() << (killLine.WasCrit() ? " (crit)" : "") << std::endl;
 
 		if (m_Settings.m_KillLogsInChat) {
@@ -971,6 +1282,24 @@ Player& WorldState::FindOrCreatePlayer(const SteamID& id)
 	else
 	{
 		data = m_CurrentPlayerData.emplace(id, std::make_shared<Player>(*this, id)).first->second.get();
+		OnLobbyChanged();
+		m_PlayerCacheStats.m_Players = m_CurrentPlayerData.size();
+		m_PlayerCacheStats.m_PeakPlayers = std::max(m_PlayerCacheStats.m_PeakPlayers, m_PlayerCacheStats.m_Players);
+
+		if (m_SpilledPlayers.erase(id))
+		{
+			m_PlayerCacheStats.m_SpilledPlayers = m_SpilledPlayers.size();
+
+			try
+			{
+				if (data->RehydrateFrom(TF2BDApplication::GetApplication().GetTempDB()))
+					m_PlayerCacheStats.m_Rehydrations++;
+			}
+			catch (...)
+			{
+				LogException("Failed to rehydrate {} from the temp DB", id);
+			}
+		}
 
 		if (!GetSettings().m_LazyLoadAPIData)
 		{
@@ -989,6 +1318,70 @@ Player& WorldState::FindOrCreatePlayer(const SteamID& id)
 	return *data;
 }
 
+void WorldState::EvictPlayers()
+{
+	std::vector<PlayerEvictionCandidate> candidates;
+	candidates.reserve(m_CurrentPlayerData.size());
+
+	const SteamID localSteamID = GetSettings().GetLocalSteamID();
+	size_t totalBytes = 0;
+	for (const auto& [id, player] : m_CurrentPlayerData)
+	{
+		auto& candidate = candidates.emplace_back();
+		candidate.m_SteamID = id;
+		candidate.m_LastSeen = player->GetLastStatusUpdateTime();
+		candidate.m_ApproxBytes = player->GetApproxMemoryUsage();
+		candidate.m_Evictable =
+			id != localSteamID &&
+			!m_LobbyMemberTeams.Find(id) &&
+			(m_LastStatusUpdateTime - candidate.m_LastSeen) >= PLAYER_EVICTION_MIN_ABSENCE &&
+			!player->IsFetchPending();
+
+		totalBytes += candidate.m_ApproxBytes;
+	}
+
+	m_PlayerCacheStats.m_ApproxBytes = totalBytes;
+
+	const size_t limitBytes = size_t(std::max(GetSettings().m_PlayerCacheMemoryLimitMB, 1)) * 1024 * 1024;
+	const auto evicted = SelectPlayersToEvict(std::move(candidates), limitBytes);
+	if (evicted.empty())
+		return;
+
+	for (const SteamID& id : evicted)
+	{
+		auto found = m_CurrentPlayerData.find(id);
+		const Player& player = *found->second;
+
+		try
+		{
+			if (player.SpillTo(TF2BDApplication::GetApplication().GetTempDB()))
+			{
+				m_SpilledPlayers.insert(id);
+				m_PlayerCacheStats.m_Spills++;
+			}
+		}
+		catch (...)
+		{
+			LogException("Failed to spill {} to the temp DB", id);
+		}
+
+		m_PlayerNames.Remove(id, player.GetStatus().m_Name);
+		m_PlayerUserIDs.Update(id, player.GetUserID(), std::nullopt);
+		m_PlayerCacheStats.m_ApproxBytes -= player.GetApproxMemoryUsage();
+
+		// Anyone still holding on to them keeps their own reference
+		m_CurrentPlayerData.erase(found);
+	}
+
+	OnLobbyChanged();
+	m_PlayerCacheStats.m_Evictions += evicted.size();
+	m_PlayerCacheStats.m_Players = m_CurrentPlayerData.size();
+	m_PlayerCacheStats.m_SpilledPlayers = m_SpilledPlayers.size();
+
+	DebugLog("Evicted {} players, {} remain (~{} KB)", evicted.size(), m_CurrentPlayerData.size(),
+		m_PlayerCacheStats.m_ApproxBytes / 1024);
+}
+
 auto WorldState::GetTeamShareResult(const SteamID& id0, const SteamID& id1) const -> TeamShareResult
 {
 	return GetTeamShareResult(FindLobbyMemberTeam(id0), FindLobbyMemberTeam(id1));
@@ -1167,6 +1560,10 @@ const mh::expected<SteamAPI::PlayerFriends>& Player::GetFriendsInfo() const
 
 			data.m_Friends = co_await SteamAPI::GetFriendList(settings, pThis->GetSteamID(), *client);
 
+			const auto fetchTime = tfbd_clock_t::now();
+			co_await GetDispatcher().co_dispatch();  // m_FriendsInfo is only touched on the main thread
+			pThis->m_FriendsInfoFetchTime = fetchTime;
+
 			co_return data;
 		});
 }
@@ -1239,8 +1636,12 @@ void Player::SetStatus(PlayerStatus status, time_point_t timestamp)
 	if (m_Status.m_State != PlayerStatusState::Active && status.m_State == PlayerStatusState::Active)
 		m_LastStatusActiveBegin = timestamp;
 
-	m_Status = std::move(status);
+	const PlayerStatusChange changes = ClassifyPlayerStatusChange(m_Status, status);
+	m_UnreportedStatusChanges |= changes;
+
+	const PlayerStatus oldStatus = std::exchange(m_Status, std::move(status));
 	m_LastStatusUpdateTime = m_LastPingUpdateTime = timestamp;
+	m_World->OnPlayerStatusChanged(*this, oldStatus, changes);
 }
 void Player::SetPing(uint16_t ping, time_point_t timestamp)
 {
@@ -1248,31 +1649,113 @@ void Player::SetPing(uint16_t ping, time_point_t timestamp)
 	m_LastPingUpdateTime = timestamp;
 }
 
-const std::any* Player::FindDataStorage(const std::type_index& type) const
+size_t Player::GetApproxMemoryUsage() const
 {
-	if (auto found = m_UserData.find(type); found != m_UserData.end())
-		return &found->second;
+	// Only counts what can grow, and what every player has. Hash table nodes are guessed at
+	// two pointers on top of the value.
+	constexpr size_t NODE_OVERHEAD = 2 * sizeof(void*);
 
-	return nullptr;
+	size_t retVal = sizeof(*this) + m_Status.m_Name.capacity();
+
+	if (m_PlayerSummary)
+	{
+		retVal += m_PlayerSummary->m_RealName.capacity() + m_PlayerSummary->m_Nickname.capacity() +
+			m_PlayerSummary->m_AvatarHash.capacity() + m_PlayerSummary->m_ProfileURL.capacity();
+	}
+
+	if (m_FriendsInfo)
+	{
+		retVal += m_FriendsInfo->m_Friends.size() * (sizeof(SteamID) + NODE_OVERHEAD) +
+			m_FriendsInfo->m_Friends.bucket_count() * sizeof(void*);
+	}
+
+	if (m_PlayerSourceBans)
+		retVal += m_PlayerSourceBans->capacity() * sizeof(SteamHistoryAPI::PlayerSourceBan);
+	if (m_PlayerSourceBanState)
+		retVal += m_PlayerSourceBanState->size() * (sizeof(SteamHistoryAPI::PlayerSourceBanState::value_type) + NODE_OVERHEAD);
+
+	return retVal;
 }
 
-std::any& Player::GetOrCreateDataStorage(const std::type_index& type)
+bool Player::IsFetchPending() const
 {
-	return m_UserData[type];
+	const auto IsPending = [](const auto& var)
+	{
+		return !var && var.error() == std::errc::operation_in_progress;
+	};
+
+	return IsPending(m_PlayerSummary) || IsPending(m_PlayerSteamBans) || IsPending(m_PlayerSourceBanState) ||
+		IsPending(m_TF2Playtime) || IsPending(m_LogsInfo) || IsPending(m_FriendsInfo) || IsPending(m_InventoryInfo);
 }
 
-template<typename T>
-static std::vector<SteamID> Take100(const T& collection)
+bool Player::SpillTo(DB::ITempDB& db) const
 {
-	std::vector<SteamID> retVal;
-	for (SteamID id : collection)
+	// Inventory and logs.tf info are already written to the temp DB as soon as they are fetched
+	bool spilled = false;
+
+	if (m_PlayerSummary)
 	{
-		if (retVal.size() >= 100)
-			break;
+		DB::PlayerSummaryCacheInfo info{};
+		info = *m_PlayerSummary;
+		info.m_LastCacheUpdateTime = m_PlayerSummaryFetchTime;
+		db.Store(info);
+		spilled = true;
+	}
 
-		retVal.push_back(id);
+	if (m_PlayerSteamBans)
+	{
+		DB::PlayerBansCacheInfo info{};
+		info = *m_PlayerSteamBans;
+		info.m_LastCacheUpdateTime = m_PlayerSteamBansFetchTime;
+		db.Store(info);
+		spilled = true;
 	}
-	return retVal;
+
+	if (m_FriendsInfo)
+	{
+		DB::AccountFriendsListInfo info{};
+		info = *m_FriendsInfo;
+		info.GetSteamID() = GetSteamID();
+		info.m_LastCacheUpdateTime = m_FriendsInfoFetchTime;
+		db.Store(info);
+		spilled = true;
+	}
+
+	return spilled;
+}
+
+bool Player::RehydrateFrom(const DB::ITempDB& db)
+{
+	const auto TryGetFresh = [&](auto& info)
+	{
+		info.GetSteamID() = GetSteamID();
+		return db.TryGet(info) && (tfbd_clock_t::now() - info.m_LastCacheUpdateTime) <= info.GetCacheLiveTime();
+	};
+
+	bool rehydrated = false;
+
+	if (DB::PlayerSummaryCacheInfo summary{}; TryGetFresh(summary))
+	{
+		m_PlayerSummary = static_cast<const SteamAPI::PlayerSummary&>(summary);
+		m_PlayerSummaryFetchTime = summary.m_LastCacheUpdateTime;
+		rehydrated = true;
+	}
+
+	if (DB::PlayerBansCacheInfo bans{}; TryGetFresh(bans))
+	{
+		m_PlayerSteamBans = static_cast<const SteamAPI::PlayerBans&>(bans);
+		m_PlayerSteamBansFetchTime = bans.m_LastCacheUpdateTime;
+		rehydrated = true;
+	}
+
+	if (DB::AccountFriendsListInfo friends{}; TryGetFresh(friends))
+	{
+		m_FriendsInfo = SteamAPI::PlayerFriends{ std::move(friends.m_Friends) };
+		m_FriendsInfoFetchTime = friends.m_LastCacheUpdateTime;
+		rehydrated = true;
+	}
+
+	return rehydrated;
 }
 
 auto WorldState::PlayerSummaryUpdateAction::SendRequest(
@@ -1292,7 +1775,7 @@ auto WorldState::PlayerSummaryUpdateAction::SendRequest(
 		return {};
 	}
 
-	std::vector<SteamID> steamIDs = Take100(collection);
+	std::vector<SteamID> steamIDs(collection.begin(), collection.end());
 
 	return SteamAPI::GetPlayerSummariesAsync(
 		state->GetSettings(), std::move(steamIDs), *client);
@@ -1302,10 +1785,12 @@ void WorldState::PlayerSummaryUpdateAction::OnDataReady(WorldState*& state,
 	const response_type& response, queue_collection_type& collection)
 {
 	DebugLog("[SteamAPI] Received {} player summaries", response.size());
+	const auto fetchTime = tfbd_clock_t::now();
 	for (const SteamAPI::PlayerSummary& entry : response)
 	{
 		auto& player = state->FindOrCreatePlayer(entry.m_SteamID);
 		player.m_PlayerSummary = entry;
+		player.m_PlayerSummaryFetchTime = fetchTime;
 
 		collection.erase(entry.m_SteamID);
 
@@ -1314,6 +1799,13 @@ void WorldState::PlayerSummaryUpdateAction::OnDataReady(WorldState*& state,
 	}
 }
 
+void WorldState::PlayerSummaryUpdateAction::OnGaveUp(WorldState*& state, const SteamID& steamID)
+{
+	DebugLog("[SteamAPI] Gave up on getting a player summary for {}", steamID);
+	if (auto found = state->FindPlayer(steamID))
+		static_cast<Player*>(found)->m_PlayerSummary = ErrorCode::GaveUpWaiting;
+}
+
 auto WorldState::PlayerBansUpdateAction::SendRequest(state_type& state,
 	queue_collection_type& collection) -> response_future_type
 {
@@ -1331,7 +1823,7 @@ auto WorldState::PlayerBansUpdateAction::SendRequest(state_type& state,
 		return {};
 	}
 
-	std::vector<SteamID> steamIDs = Take100(collection);
+	std::vector<SteamID> steamIDs(collection.begin(), collection.end());
 	return SteamAPI::GetPlayerBansAsync(
 		state->GetSettings(), std::move(steamIDs), *client);
 }
@@ -1340,13 +1832,23 @@ void WorldState::PlayerBansUpdateAction::OnDataReady(state_type& state,
 	const response_type& response, queue_collection_type& collection)
 {
 	DebugLog("[SteamAPI] Received {} player bans", response.size());
+	const auto fetchTime = tfbd_clock_t::now();
 	for (const SteamAPI::PlayerBans& bans : response)
 	{
-		state->FindOrCreatePlayer(bans.m_SteamID).m_PlayerSteamBans = bans;
+		auto& player = state->FindOrCreatePlayer(bans.m_SteamID);
+		player.m_PlayerSteamBans = bans;
+		player.m_PlayerSteamBansFetchTime = fetchTime;
 		collection.erase(bans.m_SteamID);
 	}
 }
 
+void WorldState::PlayerBansUpdateAction::OnGaveUp(state_type& state, const SteamID& steamID)
+{
+	DebugLog("[SteamAPI] Gave up on getting player bans for {}", steamID);
+	if (auto found = state->FindPlayer(steamID))
+		static_cast<Player*>(found)->m_PlayerSteamBans = ErrorCode::GaveUpWaiting;
+}
+
 auto WorldState::PlayerSourceBansUpdateAction::SendRequest(state_type& state,
 	queue_collection_type& collection) -> response_future_type
 {
@@ -1368,7 +1870,7 @@ auto WorldState::PlayerSourceBansUpdateAction::SendRequest(state_type& state,
 		return {};
 	}
 
-	std::vector<SteamID> steamIDs = Take100(collection);
+	std::vector<SteamID> steamIDs(collection.begin(), collection.end());
 
 	return SteamHistoryAPI::GetPlayerSourceBansAsync(state->GetSettings().GetSteamHistoryAPIKey(), std::move(steamIDs), *client);
 }
@@ -1414,3 +1916,13 @@ void WorldState::PlayerSourceBansUpdateAction::OnDataReady(state_type& state,
 	// FIXME: ask XVF so it returns keys at least for users with no bans
 	collection.clear();
 }
+
+void WorldState::PlayerSourceBansUpdateAction::OnGaveUp(state_type& state, const SteamID& steamID)
+{
+	DebugLog("[SteamHistory] Gave up on getting source bans for {}", steamID);
+	if (auto found = state->FindPlayer(steamID))
+	{
+		static_cast<Player*>(found)->m_PlayerSourceBanState = ErrorCode::GaveUpWaiting;
+		static_cast<Player*>(found)->m_PlayerSourceBans = ErrorCode::GaveUpWaiting;
+	}
+}
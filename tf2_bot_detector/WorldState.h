@@ -1,13 +1,19 @@
 #pragma once
 
+#include "BatchedAction.h"
 #include "Clock.h"
+#include "ConsoleLog/ConsoleLineCoalescer.h"
+#include "ConsoleLog/ConsoleLineListener.h"
 #include "SteamID.h"
 #include "TFConstants.h"
+#include "WorldEventListener.h"
 
 #include <mh/coroutine/task.hpp>
-#include <mh/coroutine/generator.hpp>
 
+#include <cassert>
+#include <iterator>
 #include <optional>
+#include <span>
 
 #undef GetCurrentTime
 
@@ -17,9 +23,7 @@ namespace tf2_bot_detector
 	class ConfigExecLine;
 	class ConsoleLogParser;
 	class IAccountAges;
-	class IConsoleLineListener;
 	class IPlayer;
-	class IWorldEventListener;
 	enum class LobbyMemberTeam : uint8_t;
 	class Settings;
 	enum class TFClassType;
@@ -31,6 +35,107 @@ namespace tf2_bot_detector
 		Neither,
 	};
 
+	struct PlayerCacheStats
+	{
+		size_t m_Players = 0;          // Currently in memory
+		size_t m_PeakPlayers = 0;
+		size_t m_ApproxBytes = 0;      // Estimated memory used by the players currently in memory
+		size_t m_SpilledPlayers = 0;   // Evicted, and may be rehydrated from the temp DB if they come back
+
+		uint64_t m_Evictions = 0;
+		uint64_t m_Spills = 0;         // Evictions that had fetched data worth writing to the temp DB
+		uint64_t m_Rehydrations = 0;
+	};
+
+	// How the rows of `status` dumps compared to what we already had for each player
+	struct StatusUpdateStats
+	{
+		uint64_t m_Snapshots = 0;
+		uint64_t m_UnchangedSnapshots = 0;  // Same players, and nothing but ping changed for any of them
+
+		uint64_t m_Rows = 0;
+		uint64_t m_NameChanges = 0;
+		uint64_t m_StateChanges = 0;
+		uint64_t m_Reconnects = 0;
+		uint64_t m_PingOnlyRows = 0;        // Suppressed, only ping/loss changed
+		uint64_t m_UnchangedRows = 0;       // Suppressed, identical to the previous row
+	};
+
+	// Web API lookups for the players we've seen, see BatchedAction
+	struct ExternalDataStats
+	{
+		BatchedActionStats m_PlayerSummaries;
+		BatchedActionStats m_PlayerBans;
+		BatchedActionStats m_SourceBans;
+	};
+
+	// Players, iterated as references. Views a snapshot owned by the world state, so it is only
+	// valid until the next time players are added or removed or lobby membership changes. Debug
+	// builds assert if it is used after that.
+	template<typename TPlayer>
+	class PlayerRange final
+	{
+	public:
+		class iterator final
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = TPlayer;
+			using difference_type = std::ptrdiff_t;
+			using pointer = TPlayer*;
+			using reference = TPlayer&;
+
+			iterator() = default;
+			iterator(IPlayer* const* it, const uint64_t* snapshotGeneration, uint64_t expectedGeneration) :
+				m_It(it), m_SnapshotGeneration(snapshotGeneration), m_ExpectedGeneration(expectedGeneration)
+			{
+			}
+
+			TPlayer& operator*() const { assert(IsValid()); return **m_It; }
+			TPlayer* operator->() const { assert(IsValid()); return *m_It; }
+			iterator& operator++() { ++m_It; return *this; }
+			iterator operator++(int) { auto copy = *this; ++m_It; return copy; }
+			bool operator==(const iterator& other) const { return m_It == other.m_It; }
+
+		private:
+			bool IsValid() const { return !m_SnapshotGeneration || *m_SnapshotGeneration == m_ExpectedGeneration; }
+
+			IPlayer* const* m_It = nullptr;
+			const uint64_t* m_SnapshotGeneration = nullptr;
+			uint64_t m_ExpectedGeneration = 0;
+		};
+
+		PlayerRange() = default;
+
+		// If snapshotGeneration is given, it has to change whenever players is rebuilt or any
+		// player in it goes away
+		explicit PlayerRange(std::span<IPlayer* const> players, const uint64_t* snapshotGeneration = nullptr) :
+			m_Players(players), m_SnapshotGeneration(snapshotGeneration),
+			m_ExpectedGeneration(snapshotGeneration ? *snapshotGeneration : 0)
+		{
+		}
+		template<typename TOther>
+		explicit PlayerRange(const PlayerRange<TOther>& other) :
+			m_Players(other.m_Players), m_SnapshotGeneration(other.m_SnapshotGeneration),
+			m_ExpectedGeneration(other.m_ExpectedGeneration)
+		{
+		}
+
+		iterator begin() const { return iterator(m_Players.data(), m_SnapshotGeneration, m_ExpectedGeneration); }
+		iterator end() const { return iterator(m_Players.data() + m_Players.size(), m_SnapshotGeneration, m_ExpectedGeneration); }
+		size_t size() const { return m_Players.size(); }
+		bool empty() const { return m_Players.empty(); }
+
+		// False once the snapshot has changed, and nothing in here can be touched anymore
+		bool IsValid() const { return !m_SnapshotGeneration || *m_SnapshotGeneration == m_ExpectedGeneration; }
+
+	private:
+		template<typename> friend class PlayerRange;
+		std::span<IPlayer* const> m_Players;
+		const uint64_t* m_SnapshotGeneration = nullptr;
+		uint64_t m_ExpectedGeneration = 0;
+	};
+
 	class IWorldState;
 
 	class IWorldStateConLog
@@ -58,9 +163,12 @@ namespace tf2_bot_detector
 		virtual time_point_t GetCurrentTime() const = 0;
 		virtual time_point_t GetLastStatusUpdateTime() const = 0;
 
-		virtual void AddWorldEventListener(IWorldEventListener* listener) = 0;
+		// Listeners are called in the order they were added, and only for the events/line types
+		// they said they were interested in here.
+		virtual void AddWorldEventListener(IWorldEventListener* listener, WorldEvent interest = WorldEvent::All) = 0;
 		virtual void RemoveWorldEventListener(IWorldEventListener* listener) = 0;
-		virtual void AddConsoleLineListener(IConsoleLineListener* listener) = 0;
+		virtual void AddConsoleLineListener(IConsoleLineListener* listener,
+			ConsoleLineTypeMask interest = ConsoleLineTypeMask::All()) = 0;
 		virtual void RemoveConsoleLineListener(IConsoleLineListener* listener) = 0;
 
 		virtual void AddConsoleOutputChunk(const std::string_view& chunk) = 0;
@@ -69,6 +177,7 @@ namespace tf2_bot_detector
 		virtual std::optional<SteamID> FindSteamIDForName(const std::string_view& playerName) const = 0;
 		virtual std::optional<LobbyMemberTeam> FindLobbyMemberTeam(const SteamID& id) const = 0;
 		virtual std::optional<UserID_t> FindUserID(const SteamID& id) const = 0;
+		virtual const IPlayer* FindPlayerByUserID(UserID_t userID) const = 0;
 
 		virtual TeamShareResult GetTeamShareResult(const SteamID& id) const = 0;
 		virtual TeamShareResult GetTeamShareResult(const SteamID& id0, const SteamID& id1) const = 0;
@@ -80,26 +189,30 @@ namespace tf2_bot_detector
 		IPlayer* FindPlayer(const SteamID& id) { return const_cast<IPlayer*>(std::as_const(*this).FindPlayer(id)); }
 
 		virtual size_t GetApproxLobbyMemberCount() const = 0;
-		virtual mh::generator<const IPlayer&> GetLobbyMembers() const = 0;
-		mh::generator<IPlayer&> GetLobbyMembers();
-		virtual mh::generator<const IPlayer&> GetPlayers() const = 0;
-		mh::generator<IPlayer&> GetPlayers();
+
+		// The ranges are only good until the world state next changes, so don't keep them across
+		// anything that can add or remove players: console lines being dispatched, Update(), or
+		// calls back into listeners. Get a new one instead.
+		virtual PlayerRange<const IPlayer> GetLobbyMembers() const = 0;
+		PlayerRange<IPlayer> GetLobbyMembers() { return PlayerRange<IPlayer>(std::as_const(*this).GetLobbyMembers()); }
+		virtual PlayerRange<const IPlayer> GetPlayers() const = 0;
+		PlayerRange<IPlayer> GetPlayers() { return PlayerRange<IPlayer>(std::as_const(*this).GetPlayers()); }
+
+		// Changes whenever lobby membership changes, the set of players in a `status` dump
+		// changes, or the name, state, connection, team or scores of any player do. Ping alone
+		// doesn't count. If it hasn't changed, nothing derived from GetLobbyMembers()/GetPlayers() needs to
+		// be redone (apart from anything that depends on the current time).
+		virtual uint64_t GetLobbyGeneration() const = 0;
 
 		// Have we joined a team and picked a class?
 		virtual bool IsLocalPlayerInitialized() const = 0;
 		virtual bool IsVoteInProgress() const = 0;
 
 		virtual const IAccountAges& GetAccountAges() const = 0;
-	};
 
-	inline mh::generator<IPlayer&> IWorldState::GetLobbyMembers()
-	{
-		for (const IPlayer& p : std::as_const(*this).GetLobbyMembers())
-			co_yield const_cast<IPlayer&>(p);
-	}
-	inline mh::generator<IPlayer&> IWorldState::GetPlayers()
-	{
-		for (const IPlayer& p : std::as_const(*this).GetPlayers())
-			co_yield const_cast<IPlayer&>(p);
-	}
+		virtual const PlayerCacheStats& GetPlayerCacheStats() const = 0;
+		virtual const StatusUpdateStats& GetStatusUpdateStats() const = 0;
+		virtual const ConsoleLineCoalescerStats& GetConsoleLineCoalescerStats() const = 0;
+		virtual ExternalDataStats GetExternalDataStats() const = 0;
+	};
 }
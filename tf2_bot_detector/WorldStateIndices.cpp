@@ -0,0 +1,95 @@
+#include "WorldStateIndices.h"
+
+#include <algorithm>
+
+using namespace tf2_bot_detector;
+
+void PlayerNameIndex::Rename(const SteamID& id, const std::string_view& oldName, const std::string_view& newName)
+{
+	if (oldName == newName)
+		return;
+
+	Remove(id, oldName);
+
+	auto found = m_Names.find(newName);
+	if (found == m_Names.end())
+		found = m_Names.emplace(std::string(newName), std::vector<SteamID>{}).first;
+
+	if (std::find(found->second.begin(), found->second.end(), id) == found->second.end())
+		found->second.push_back(id);
+}
+
+void PlayerNameIndex::Remove(const SteamID& id, const std::string_view& name)
+{
+	auto found = m_Names.find(name);
+	if (found == m_Names.end())
+		return;
+
+	std::erase(found->second, id);
+	if (found->second.empty())
+		m_Names.erase(found);
+}
+
+std::span<const SteamID> PlayerNameIndex::Find(const std::string_view& name) const
+{
+	if (auto found = m_Names.find(name); found != m_Names.end())
+		return found->second;
+
+	return {};
+}
+
+void UserIDIndex::Update(const SteamID& id, std::optional<UserID_t> oldUserID, std::optional<UserID_t> newUserID)
+{
+	if (oldUserID == newUserID)
+		return;
+
+	if (oldUserID)
+	{
+		// Only if someone else hasn't claimed it since
+		if (auto found = m_UserIDs.find(*oldUserID); found != m_UserIDs.end() && found->second == id)
+			m_UserIDs.erase(found);
+	}
+
+	if (newUserID)
+		m_UserIDs.insert_or_assign(*newUserID, id);
+}
+
+std::optional<SteamID> UserIDIndex::Find(UserID_t userID) const
+{
+	if (auto found = m_UserIDs.find(userID); found != m_UserIDs.end())
+		return found->second;
+
+	return std::nullopt;
+}
+
+void LobbyMemberTeamIndex::Refresh(const SteamID& id,
+	const std::span<const LobbyMember>& current, const std::span<const LobbyMember>& pending)
+{
+	if (!id.IsValid())
+		return;
+
+	const auto FindIn = [&](const std::span<const LobbyMember>& members) -> const LobbyMember*
+	{
+		auto found = std::find_if(members.begin(), members.end(),
+			[&](const LobbyMember& member) { return member.m_SteamID == id; });
+
+		return found != members.end() ? &*found : nullptr;
+	};
+
+	const LobbyMember* member = FindIn(current);
+	if (!member)
+		member = FindIn(pending);
+
+	if (member)
+		m_Teams.insert_or_assign(id, member->m_Team);
+	else
+		m_Teams.erase(id);
+}
+
+std::optional<LobbyMemberTeam> LobbyMemberTeamIndex::Find(const SteamID& id) const
+{
+	if (auto found = m_Teams.find(id); found != m_Teams.end())
+		return found->second;
+
+	return std::nullopt;
+}
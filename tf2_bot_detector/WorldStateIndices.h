@@ -0,0 +1,67 @@
+#pragma once
+
+#include "LobbyMember.h"
+#include "SteamID.h"
+#include "TFConstants.h"
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	// Lookups that WorldState would otherwise answer by scanning every player or lobby member.
+	// They are updated as players and lobby members change, rather than rebuilt.
+
+	// Player name -> SteamID. Names aren't unique, so a name can map to more than one player.
+	class PlayerNameIndex final
+	{
+	public:
+		void Rename(const SteamID& id, const std::string_view& oldName, const std::string_view& newName);
+		void Remove(const SteamID& id, const std::string_view& name);
+		void clear() { m_Names.clear(); }
+
+		// Everyone going by name, usually just the one
+		std::span<const SteamID> Find(const std::string_view& name) const;
+
+	private:
+		struct Hash : std::hash<std::string_view>
+		{
+			using is_transparent = void;
+		};
+
+		std::unordered_map<std::string, std::vector<SteamID>, Hash, std::equal_to<>> m_Names;
+	};
+
+	// userid -> SteamID. userids are only unique within one server, so if two players claim the
+	// same one, whoever claimed it last wins.
+	class UserIDIndex final
+	{
+	public:
+		void Update(const SteamID& id, std::optional<UserID_t> oldUserID, std::optional<UserID_t> newUserID);
+		void clear() { m_UserIDs.clear(); }
+
+		std::optional<SteamID> Find(UserID_t userID) const;
+
+	private:
+		std::unordered_map<UserID_t, SteamID> m_UserIDs;
+	};
+
+	// SteamID -> lobby team. If someone is listed as both a current and a pending member, the
+	// current listing wins.
+	class LobbyMemberTeamIndex final
+	{
+	public:
+		// Call for every SteamID that was added to, or removed from, either list
+		void Refresh(const SteamID& id, const std::span<const LobbyMember>& current, const std::span<const LobbyMember>& pending);
+		void clear() { m_Teams.clear(); }
+
+		std::optional<LobbyMemberTeam> Find(const SteamID& id) const;
+
+	private:
+		std::unordered_map<SteamID, LobbyMemberTeam> m_Teams;
+	};
+}